@@ -0,0 +1,75 @@
+#include "stimulus.h"
+
+#include <cstddef>
+#include <exception>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+#include "benchmark_utilities.h"
+
+// Emits on a signal with many slots. Run it under `perf stat -e cache-misses` to see the cache
+// behaviour of the slot iteration.
+
+namespace
+{
+    constexpr std::size_t slot_count { 10'000 };
+    constexpr std::size_t emit_count { 1'000 };
+
+    template<class Emitter>
+    class value_emitter: public Emitter
+    {
+    public:
+        typename Emitter::template signal<int> value_changed;
+
+        void set_value(int value)
+        {
+            this->emit(&value_emitter::value_changed, value);
+        }
+    };
+
+    template<class Emitter>
+    void run(const char* name)
+    {
+        std::cout << name << ":\n";
+
+        value_emitter<Emitter> source;
+        std::size_t sum { 0 };
+        std::vector<decltype(source.value_changed.connect([](int) {}))> connections;
+
+        for (std::size_t i { 0 }; i < slot_count; ++i)
+        {
+            auto connection { source.value_changed.connect(
+                [&sum](int value) { sum += static_cast<std::size_t>(value); }) };
+
+            // A few connections have an exception handler, like in real code.
+            if (i % 100 == 0)
+            {
+                connection.add_exception_handler([](std::exception_ptr) {});
+            }
+
+            connections.emplace_back(std::move(connection));
+        }
+
+        measure("  emit to 10k slots", emit_count, [&source] { source.set_value(1); });
+
+        // Suspended slots should cost nothing.
+        for (std::size_t i { 0 }; i < slot_count; ++i)
+        {
+            if (i % 100 != 0)
+            {
+                connections[i].suspend();
+            }
+        }
+
+        measure("  emit to 100 of 10k slots", emit_count, [&source] { source.set_value(1); });
+
+        do_not_optimize(sum);
+    }
+} // namespace
+
+int main()
+{
+    run<basic_emitter>("basic_emitter");
+    run<safe_emitter>("safe_emitter");
+}
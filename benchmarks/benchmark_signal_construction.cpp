@@ -0,0 +1,74 @@
+#include "stimulus.h"
+
+#include <cstddef>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include "benchmark_utilities.h"
+
+namespace
+{
+    constexpr std::size_t entity_count { 1'000'000 };
+
+    // An entity with many signals, most of which are never connected.
+    template<class Emitter>
+    class entity: public Emitter
+    {
+    public:
+        template<class... Args>
+        using signal = typename Emitter::template signal<Args...>;
+
+        signal<> created;
+        signal<> destroyed;
+        signal<int> health_changed;
+        signal<int> mana_changed;
+        signal<int> level_changed;
+        signal<double> speed_changed;
+        signal<double, double> position_changed;
+        signal<double, double> velocity_changed;
+        signal<int, int> cell_changed;
+        signal<bool> visibility_changed;
+        signal<bool> selection_changed;
+        signal<bool> focus_changed;
+        signal<int> owner_changed;
+        signal<int> team_changed;
+        signal<int> target_changed;
+        signal<int, double> damage_taken;
+        signal<int, double> damage_dealt;
+        signal<int> item_added;
+        signal<int> item_removed;
+        signal<> died;
+
+        void set_health(int health)
+        {
+            this->emit(&entity::health_changed, health);
+        }
+    };
+
+    template<class Emitter>
+    void run(const char* name)
+    {
+        std::cout << name << ": sizeof(signal<int>) = "
+                  << sizeof(typename entity<Emitter>::template signal<int>)
+                  << ", sizeof(entity) = " << sizeof(entity<Emitter>) << '\n';
+
+        std::vector<std::unique_ptr<entity<Emitter>>> entities;
+        entities.reserve(entity_count);
+
+        measure("  construct entity", entity_count, [&entities]
+        { entities.emplace_back(std::make_unique<entity<Emitter>>()); });
+
+        measure("  emit on unconnected signal",
+                entity_count,
+                [&entities, index = std::size_t { 0 }] mutable { entities[index++]->set_health(5); });
+
+        measure("  destroy entity", entity_count, [&entities] { entities.pop_back(); });
+    }
+} // namespace
+
+int main()
+{
+    run<basic_emitter>("basic_emitter");
+    run<safe_emitter>("safe_emitter");
+}
@@ -0,0 +1,39 @@
+#ifndef BENCHMARK_UTILITIES_H_
+#define BENCHMARK_UTILITIES_H_
+
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <string_view>
+
+// Prevents the compiler from optimizing away a computed value.
+template<class T>
+void do_not_optimize(T&& value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "g"(&value) : "memory");
+#else
+    static_cast<void>(value);
+#endif
+}
+
+// Runs the callable `iterations` times and prints the average time spent per iteration.
+template<class Callable>
+void measure(std::string_view name, std::size_t iterations, Callable&& callable)
+{
+    const auto start { std::chrono::steady_clock::now() };
+
+    for (std::size_t i { 0 }; i < iterations; ++i)
+    {
+        callable();
+    }
+
+    const auto elapsed { std::chrono::steady_clock::now() - start };
+    const auto nanoseconds {
+        std::chrono::duration_cast<std::chrono::duration<double, std::nano>>(elapsed).count()
+    };
+
+    std::cout << name << ": " << nanoseconds / static_cast<double>(iterations) << " ns/iteration\n";
+}
+
+#endif
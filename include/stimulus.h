@@ -2,23 +2,56 @@
 #define STIMULUS_H_
 
 #include <algorithm>
+#include <array>
 #include <atomic>
+#include <bit>
+#include <chrono>
 #include <concepts>
 #include <cstddef>
+#include <cstdint>
 #include <exception>
 #include <functional>
+#include <limits>
+#include <list>
 #include <memory>
 #include <mutex>
+#include <new>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
 #include <tuple>
 #include <type_traits>
+#include <unordered_map>
 #include <utility>
-#include <variant>
 #include <vector>
 
 namespace details
 {
     // ### Helpers
 
+    // Not std::hardware_destructive_interference_size, whose value may differ between translation
+    // units and which GCC warns about when used in headers.
+    inline constexpr std::size_t cache_line_size { 64 };
+
+    // Whether derived classes put their members in the tail padding of their base class, as the
+    // Itanium ABI does. MSVC doesn't.
+    struct tail_padding_base
+    {
+        virtual ~tail_padding_base() = default;
+
+        std::uint32_t value { 0 };
+    };
+
+    struct tail_padding_derived: public tail_padding_base
+    {
+        std::uint32_t extra { 0 };
+    };
+
+    inline constexpr bool reuses_tail_padding { sizeof(tail_padding_derived) ==
+                                                sizeof(tail_padding_base) };
+
     template<class Instance, template<class...> class Template>
     concept instance_of = requires(const Instance& instance) {
         []<class... Args>(const Template<Args...>&) {}(instance);
@@ -44,112 +77,15 @@ namespace details
         static constexpr bool is_synchronous { true };
     };
 
-    class execution_policy_holder_implementation_interface
-    {
-    public:
-        virtual ~execution_policy_holder_implementation_interface() = default;
-
-        virtual void execute(std::function<void()>&& invocable) = 0;
-        virtual auto is_synchronous() const -> bool = 0;
-    };
-
-    template<execution_policy Policy>
-    class execution_policy_holder_implementation
-        : public execution_policy_holder_implementation_interface
-    {
-    public:
-        explicit execution_policy_holder_implementation(Policy&& policy):
-            m_policy { std::forward<Policy>(policy) }
-        {
-        }
-
-        void execute(std::function<void()>&& invocable) override
-        {
-            m_policy.execute(std::move(invocable));
-        }
-
-        auto is_synchronous() const -> bool override
-        {
-            return std::remove_cvref_t<Policy>::is_synchronous;
-        }
-
-    private:
-        Policy m_policy;
-    };
-
-    class execution_policy_holder
-    {
-        template<std::invocable Callable>
-        struct policy_visitor_executor
-        {
-            explicit policy_visitor_executor(Callable&& callable):
-                m_callable { std::forward<Callable>(callable) }
-            {
-            }
-
-            void operator()(const synchronous_policy& policy)
-            {
-                policy.execute(std::forward<Callable>(m_callable));
-            }
-
-            void operator()(
-                const std::unique_ptr<execution_policy_holder_implementation_interface>& policy)
-            {
-                policy->execute(std::forward<Callable>(m_callable));
-            }
-
-        private:
-            // It might be bad, but this is done on purpose.
-            // NOLINTNEXTLINE(cppcoreguidelines-avoid-const-or-ref-data-members)
-            Callable&& m_callable;
-        };
-
-        struct policy_visitor_synchronicity_checker
-        {
-            static auto constexpr operator()(const synchronous_policy&) -> bool
-            {
-                return synchronous_policy::is_synchronous;
-            }
-
-            static auto operator()(
-                const std::unique_ptr<execution_policy_holder_implementation_interface>& policy)
-                -> bool
-            {
-                return policy->is_synchronous();
-            }
-        };
-
-        static constexpr policy_visitor_synchronicity_checker synchronicity_checker {};
-
-    public:
-        explicit execution_policy_holder(synchronous_policy policy):
-            m_policy { policy }
-        {
-        }
-
-        template<execution_policy Policy>
-        explicit execution_policy_holder(Policy&& policy):
-            m_policy { std::make_unique<execution_policy_holder_implementation<Policy>>(
-                std::forward<Policy>(policy)) }
-        {
-        }
-
-        template<std::invocable Invocable>
-        void execute(Invocable&& invocable)
-        {
-            std::visit(policy_visitor_executor { std::forward<Invocable>(invocable) }, m_policy);
-        }
-
-        auto is_synchronous() const -> bool
-        {
-            return std::visit(synchronicity_checker, m_policy);
-        }
-
-    private:
-        std::variant<synchronous_policy,
-                     std::unique_ptr<execution_policy_holder_implementation_interface>>
-            m_policy;
-    };
+    // Policies given as lvalues are kept by reference, so that a stateful policy can be shared
+    // between connections. The synchronous policy is stateless and always kept by value.
+    template<class Policy>
+    using stored_policy_t = std::conditional_t<
+        std::same_as<std::remove_cvref_t<Policy>, synchronous_policy>,
+        synchronous_policy,
+        std::conditional_t<std::is_lvalue_reference_v<Policy>,
+                           std::reference_wrapper<std::remove_reference_t<Policy>>,
+                           std::remove_cvref_t<Policy>>>;
 
     template<class NotVoid>
     concept not_void = (!std::same_as<NotVoid, void>);
@@ -192,6 +128,22 @@ namespace details
     template<std::size_t... Values>
     concept all_different = all_different_implementation_t<Values...>;
 
+    template<class Key>
+    concept hashable = std::equality_comparable<Key> && requires(const Key& key) {
+        { std::hash<Key> {}(key) } -> std::convertible_to<std::size_t>;
+    };
+
+    // Blocking nests, so that independent scopes may block the same signal. Unbalanced unblocking
+    // is ignored rather than wrapping around.
+    inline void release_block(std::atomic<std::uint32_t>& block_count)
+    {
+        auto count { block_count.load(std::memory_order_relaxed) };
+        while (count != 0 &&
+               !block_count.compare_exchange_weak(count, count - 1, std::memory_order_relaxed))
+        {
+        }
+    }
+
     // ### Partial call
 
     template<class Callable, class... Args>
@@ -278,2107 +230,8067 @@ namespace details
                             std::forward<decltype(args)>(args)...);
     }
 
-    template<class BasicLockable>
-    concept basic_lockable = requires(BasicLockable lockable) {
-        { lockable.lock() };
-        { lockable.unlock() };
+    template<class Callable, class Tuple>
+    struct tuple_invocable_impl: std::false_type
+    {
     };
 
-    class fake_mutex
+    template<class Callable, class... Args>
+        requires std::invocable<Callable, Args&&...>
+    struct tuple_invocable_impl<Callable, std::tuple<Args...>>: std::true_type
     {
-    public:
-        constexpr void lock()
-        {
-        }
-
-        constexpr void unlock()
-        {
-        }
     };
 
-    template<template<class> class PointerLike>
-    concept shared_pointer_like = requires(PointerLike<int> pointer) {
-        { *pointer } -> std::same_as<int&>;
-        { pointer = PointerLike<int> {} } -> std::same_as<PointerLike<int>&>;
-        { pointer == nullptr } -> std::convertible_to<bool>;
-        { pointer == PointerLike<int> {} } -> std::convertible_to<bool>;
-        { static_cast<bool>(pointer) };
-        { PointerLike<int> { pointer } } -> std::same_as<PointerLike<int>>;
-        { PointerLike<int> { std::move(pointer) } } -> std::same_as<PointerLike<int>>;
-        { PointerLike<int> {} } -> std::same_as<PointerLike<int>>;
-        { pointer.~PointerLike<int>() };
-        requires not_void<typename PointerLike<int>::weak_type>;
-        { pointer.get() } -> std::same_as<int*>;
-    };
+    // Builds the arguments of an emission: either the single argument, or a tuple of them.
+    template<class Factory, class Slot>
+    concept payload_factory =
+        std::invocable<Factory> &&
+        (std::invocable<Slot, std::invoke_result_t<Factory>> ||
+         tuple_invocable_impl<Slot, std::remove_cvref_t<std::invoke_result_t<Factory>>>::value);
 
-    struct pointer_holder
-    {
-        void* pointer { nullptr };
-        std::size_t count { 0 };
-        std::size_t weak_count { 0 };
-    };
+    // ### Slot
 
-    template<class T>
-    class unsafe_weak_pointer;
+    template<class Arg>
+    using shared_slot_arg_t = std::conditional_t<std::is_lvalue_reference_v<Arg>, Arg, const Arg&>;
 
+    // How arguments are kept until a deferred call: references stay references.
     template<class T>
-    class unsafe_shared_pointer
+    using ref_or_value = std::conditional_t<std::is_lvalue_reference_v<T>,
+                                            std::reference_wrapper<std::remove_reference_t<T>>,
+                                            T>;
+
+    template<class... Args>
+    class slot_interface
     {
     public:
-        friend class unsafe_weak_pointer<T>;
+        virtual ~slot_interface() = default;
 
-        template<class>
-        friend class unsafe_shared_pointer;
-
-        using weak_type = unsafe_weak_pointer<T>;
+        // Arguments are shared with other slots, they must not be moved from.
+        virtual void invoke(shared_slot_arg_t<Args>... args) = 0;
 
-        unsafe_shared_pointer() = default;
+        // Arguments belong to this slot only, they can be moved from.
+        virtual void invoke_moved(Args&&... args) = 0;
 
-        explicit unsafe_shared_pointer(std::nullptr_t)
+        template<class... EmittedArgs>
+            requires(sizeof...(EmittedArgs) == sizeof...(Args))
+        void operator()(EmittedArgs&&... emitted_args)
         {
+            if constexpr ((std::is_convertible_v<EmittedArgs&&, Args&&> && ...))
+            {
+                invoke_moved(std::forward<EmittedArgs>(emitted_args)...);
+            }
+            else
+            {
+                invoke(std::forward<EmittedArgs>(emitted_args)...);
+            }
         }
+    };
 
-        explicit unsafe_shared_pointer(T* pointer):
-            m_holder {
-                (pointer != nullptr)
-                    ? new pointer_holder { .pointer = static_cast<void*>(pointer), .count = 1 }
-                    : nullptr
-        }
+    // Identifies the arguments of slots, so that a slot can be checked against a connection whose
+    // arguments are only known at runtime.
+    template<class... Args>
+    struct slot_signature
+    {
+        static constexpr char id {};
+    };
+
+    template<class Callable, class... Args>
+    class slot_implementation final: public slot_interface<Args...>
+    {
+    public:
+        template<class SlotCallable>
+        explicit slot_implementation(SlotCallable&& callable):
+            m_callable { std::forward<SlotCallable>(callable) }
         {
         }
 
-        unsafe_shared_pointer(const unsafe_shared_pointer& other):
-            m_holder { other.m_holder }
+        void invoke(shared_slot_arg_t<Args>... args) override
         {
-            increase();
+            if constexpr (partially_callable<Callable&, shared_slot_arg_t<Args>...>)
+            {
+                partial_call(m_callable, args...);
+            }
+            else
+            {
+                // The callable only accepts rvalues, so it gets its own copy.
+                partial_call(m_callable, copy_argument<Args>(args)...);
+            }
         }
 
-        unsafe_shared_pointer(unsafe_shared_pointer&& other) noexcept
+        void invoke_moved(Args&&... args) override
         {
-            std::swap(m_holder, other.m_holder);
+            partial_call(m_callable, std::forward<Args>(args)...);
         }
 
-        auto operator=(const unsafe_shared_pointer& other) -> unsafe_shared_pointer&
+    private:
+        template<class Arg>
+        static auto copy_argument(shared_slot_arg_t<Arg> arg) -> Arg
         {
-            if (&other == this)
-            {
-                return *this;
-            }
+            return arg;
+        }
 
-            release();
+        Callable m_callable;
+    };
 
-            m_holder = other.m_holder;
+    // ### Slot results
 
-            increase();
-            return *this;
-        }
+    template<class Callable, class Result, class... Args>
+    concept partially_callable_returning =
+        partially_callable<Callable, Args...> &&
+        requires(Callable& callable, shared_slot_arg_t<Args>... args) {
+            { partial_call(callable, args...) } -> std::convertible_to<Result>;
+        };
 
-        auto operator=(unsafe_shared_pointer&& other) noexcept -> unsafe_shared_pointer&
-        {
-            if (&other == this)
-            {
-                return *this;
-            }
+    template<class Combiner, class Result>
+    concept combiner = requires(Combiner& combiner_instance, Result result) {
+        combiner_instance.accept(std::move(result));
+        { std::as_const(combiner_instance).done() } -> std::convertible_to<bool>;
+        combiner_instance.result();
+    };
 
-            release();
+    template<class Policy>
+    concept asynchronous_policy =
+        execution_policy<Policy> && !std::remove_cvref_t<Policy>::is_synchronous;
 
-            m_holder = other.m_holder;
-            other.m_holder = nullptr;
+    // Where slot results go during an emission of a signal returning results. Each thread sees
+    // the sink of its innermost emission, and a slot only gives its result to the sink of its
+    // own signal.
+    template<class Result>
+    class result_sink
+    {
+    public:
+        result_sink(const result_sink&) = delete;
+        result_sink(result_sink&&) = delete;
 
-            return *this;
-        }
+        auto operator=(const result_sink&) -> result_sink& = delete;
+        auto operator=(result_sink&&) -> result_sink& = delete;
 
-        ~unsafe_shared_pointer()
-        {
-            release();
-        }
+        virtual void accept(Result result) = 0;
+        virtual auto done() const -> bool = 0;
 
-        auto operator==(T* other) const -> bool
+        static auto current(const void* source) -> result_sink*
         {
-            if (other == nullptr)
-            {
-                return m_holder == nullptr;
-            }
-
-            if (m_holder == nullptr)
-            {
-                return false;
-            }
-
-            return other == m_holder->pointer;
+            return s_current != nullptr && s_current->m_source == source ? s_current : nullptr;
         }
 
-        auto operator==(const unsafe_shared_pointer& other) const -> bool
+    protected:
+        explicit result_sink(const void* source):
+            m_source { source },
+            m_previous { std::exchange(s_current, this) }
         {
-            return other.m_holder == m_holder;
         }
 
-        auto operator==(std::nullptr_t) const -> bool
+        ~result_sink()
         {
-            return m_holder == nullptr || m_holder->pointer == nullptr;
+            s_current = m_previous;
         }
 
-        auto operator*() const -> T&
+    private:
+        const void* m_source;
+        result_sink* m_previous;
+
+        static inline thread_local result_sink* s_current { nullptr };
+    };
+
+    template<class Result>
+    class discarding_sink final: public result_sink<Result>
+    {
+    public:
+        explicit discarding_sink(const void* source):
+            result_sink<Result> { source }
         {
-            return *static_cast<T*>(m_holder->pointer);
         }
 
-        auto get() const -> T*
+        void accept(Result /*result*/) override
         {
-            if (m_holder == nullptr)
-            {
-                return nullptr;
-            }
-
-            return static_cast<T*>(m_holder->pointer);
+            // Nothing on purpose
         }
 
-        auto operator->() const -> T*
+        auto done() const -> bool override
         {
-            return get();
+            return false;
         }
+    };
 
-        explicit operator bool() const
+    template<class Result, class Combiner>
+    class combining_sink final: public result_sink<Result>
+    {
+    public:
+        combining_sink(const void* source, Combiner& combiner):
+            result_sink<Result> { source },
+            m_combiner { combiner }
         {
-            return m_holder != nullptr && m_holder->pointer != nullptr;
         }
 
-        template<class Base>
-            requires std::derived_from<T, Base>
-        explicit operator unsafe_shared_pointer<Base>()
+        void accept(Result result) override
         {
-            return unsafe_shared_pointer<Base> { m_holder };
+            m_combiner.accept(std::move(result));
         }
 
-        template<class Base>
-            requires std::derived_from<T, Base>
-        explicit operator unsafe_weak_pointer<Base>()
+        auto done() const -> bool override
         {
-            return unsafe_weak_pointer<Base> { unsafe_shared_pointer<Base> { m_holder } };
+            return m_combiner.done();
         }
 
     private:
-        void increase()
-        {
-            if (m_holder != nullptr)
-            {
-                ++m_holder->count;
-            }
-        }
+        // It might be bad, but this is done on purpose.
+        // NOLINTNEXTLINE(cppcoreguidelines-avoid-const-or-ref-data-members)
+        Combiner& m_combiner;
+    };
 
-        void release()
-        {
-            if (m_holder == nullptr)
-            {
-                return;
-            }
+    // ### Asynchronous tasks
 
-            --m_holder->count;
-            if (m_holder->count == 0)
-            {
-                delete get();
-                m_holder->pointer = nullptr;
+    // A pending slot call, given to policies able to take it instead of a std::function. It must
+    // be either run or discarded exactly once, and must not be touched afterwards.
+    class task
+    {
+    public:
+        task(const task&) = delete;
+        task(task&&) = delete;
 
-                if (m_holder->weak_count == 0)
-                {
-                    delete m_holder;
-                    m_holder = nullptr;
-                }
-            }
-        }
+        auto operator=(const task&) -> task& = delete;
+        auto operator=(task&&) -> task& = delete;
 
-        explicit unsafe_shared_pointer(pointer_holder* holder):
-            m_holder { holder }
-        {
-            increase();
-        }
+        virtual void run() = 0;
+        virtual void discard() = 0;
 
-        pointer_holder* m_holder { nullptr };
+        // Free for the policy to use, so that pending tasks can be queued without allocating.
+        // It might be bad, but this is done on purpose.
+        // NOLINTNEXTLINE(misc-non-private-member-variables-in-classes)
+        task* next { nullptr };
+
+    protected:
+        task() = default;
+        ~task() = default;
     };
 
-    template<class T>
-    class unsafe_weak_pointer
+    // Opt-in, so that policies whose execute takes anything are still given a std::function.
+    template<class ExecutionPolicy>
+    concept task_execution_policy =
+        requires {
+            { std::remove_cvref_t<ExecutionPolicy>::accepts_tasks } -> std::convertible_to<bool>;
+        } && std::remove_cvref_t<ExecutionPolicy>::accepts_tasks &&
+        requires(ExecutionPolicy policy, task& pending_task) { policy.execute(pending_task); };
+
+    // Recycles the memory of objects of a given type, tasks and connections. Each thread takes the
+    // objects it creates from its own pool, and objects go back to the pool they were taken from,
+    // whichever thread they are released on. A pool outlives its thread until all of its objects
+    // are back.
+    template<class Object>
+    class object_pool
     {
     public:
-        unsafe_weak_pointer() = default;
+        object_pool(const object_pool&) = delete;
+        object_pool(object_pool&&) = delete;
 
-        explicit unsafe_weak_pointer(unsafe_shared_pointer<T> shared_pointer):
-            m_holder { shared_pointer.m_holder }
+        auto operator=(const object_pool&) -> object_pool& = delete;
+        auto operator=(object_pool&&) -> object_pool& = delete;
+
+        // The object is given its pool as first constructor argument, to be able to release
+        // itself.
+        template<class... ObjectArgs>
+        static auto acquire(ObjectArgs&&... object_args) -> Object&
         {
-            increase();
+            static_assert(sizeof(Object) >= sizeof(free_block));
+
+            auto& pool { local_pool() };
+            void* block { pool.take_block() };
+            if (s_pool != &pool)
+            {
+                // Nothing owns the pool of an exiting thread, it goes away with its last object.
+                pool.release_reference();
+            }
+
+            try
+            {
+                return *new (block) Object(pool, std::forward<ObjectArgs>(object_args)...);
+            }
+            catch (...)
+            {
+                pool.give_back(block);
+                throw;
+            }
         }
 
-        unsafe_weak_pointer(const unsafe_weak_pointer& other):
-            m_holder { other.m_holder }
+        void release(Object& released_object)
         {
-            increase();
+            released_object.~Object();
+            give_back(&released_object);
         }
 
-        unsafe_weak_pointer(unsafe_weak_pointer&& other) noexcept
+    private:
+        struct free_block
         {
-            std::swap(m_holder, other.m_holder);
+            free_block* next { nullptr };
+        };
+
+        // Gives the reference of its thread to the pool up when the thread exits. Objects released
+        // afterwards, by other thread local destructors, go back to the remote blocks.
+        struct pool_owner
+        {
+            pool_owner() = default;
+            pool_owner(const pool_owner&) = delete;
+            pool_owner(pool_owner&&) = delete;
+
+            auto operator=(const pool_owner&) -> pool_owner& = delete;
+            auto operator=(pool_owner&&) -> pool_owner& = delete;
+
+            ~pool_owner()
+            {
+                s_exited = true;
+                if (s_pool != nullptr)
+                {
+                    std::exchange(s_pool, nullptr)->release_reference();
+                }
+            }
+        };
+
+        object_pool() = default;
+
+        ~object_pool()
+        {
+            free_blocks(m_local_blocks);
+            free_blocks(m_remote_blocks.load(std::memory_order_acquire));
         }
 
-        auto operator=(const unsafe_weak_pointer& other) -> unsafe_weak_pointer&
+        // Created on the first object a thread takes, so that threads only releasing objects have
+        // none. Once the thread exits, each object takes a pool of its own.
+        static auto local_pool() -> object_pool&
         {
-            if (&other == this)
+            if (s_pool != nullptr)
             {
-                return *this;
+                return *s_pool;
             }
 
-            release();
+            auto* pool { new object_pool() };
+            if (!s_exited)
+            {
+                static thread_local pool_owner owner;
+                s_pool = pool;
+            }
+            return *pool;
+        }
 
-            m_holder = other.m_holder;
+        auto take_block() -> void*
+        {
+            if (m_local_blocks == nullptr)
+            {
+                // Take everything other threads gave back at once, which can't suffer from ABA.
+                m_local_blocks = m_remote_blocks.exchange(nullptr, std::memory_order_acquire);
+            }
 
-            increase();
+            m_references.fetch_add(1, std::memory_order_relaxed);
 
-            return *this;
+            if (m_local_blocks == nullptr)
+            {
+                return ::operator new(sizeof(Object), std::align_val_t { alignof(Object) });
+            }
+
+            return std::exchange(m_local_blocks, m_local_blocks->next);
         }
 
-        auto operator=(unsafe_weak_pointer&& other) noexcept -> unsafe_weak_pointer&
+        void give_back(void* block)
         {
-            std::swap(m_holder, other.m_holder);
+            auto* given_back { new (block) free_block() };
 
-            other.m_holder = nullptr;
+            if (s_pool == this)
+            {
+                given_back->next = m_local_blocks;
+                m_local_blocks = given_back;
+            }
+            else
+            {
+                given_back->next = m_remote_blocks.load(std::memory_order_relaxed);
+                while (!m_remote_blocks.compare_exchange_weak(given_back->next,
+                                                              given_back,
+                                                              std::memory_order_release,
+                                                              std::memory_order_relaxed))
+                {
+                }
+            }
 
-            return *this;
+            release_reference();
         }
 
-        ~unsafe_weak_pointer()
+        void release_reference()
         {
-            release();
+            if (m_references.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            {
+                delete this;
+            }
         }
 
-        auto lock() const -> unsafe_shared_pointer<T>
+        static void free_blocks(free_block* block)
         {
-            if (m_holder == nullptr)
+            while (block != nullptr)
             {
-                return unsafe_shared_pointer<T> {};
+                ::operator delete(std::exchange(block, block->next),
+                                  std::align_val_t { alignof(Object) });
             }
+        }
 
-            if (m_holder->count == 0)
+        // Trivially destructible, to stay usable while the thread exits.
+        static inline thread_local object_pool* s_pool { nullptr };
+        static inline thread_local bool s_exited { false };
+
+        // Only touched by the owning thread.
+        free_block* m_local_blocks { nullptr };
+        // Blocks given back by other threads.
+        std::atomic<free_block*> m_remote_blocks { nullptr };
+        // One for the owning thread, and one per object taken from the pool.
+        std::atomic<std::size_t> m_references { 1 };
+    };
+
+    // Queued emissions keep copies of their arguments, as those they were given may be
+    // temporaries, gone by the time the queue is drained. Slots must see what mutable references
+    // point to, and some arguments can't be copied: such emissions aren't queued.
+    template<class Arg>
+    concept deferrable_arg =
+        (!std::is_reference_v<Arg> || (std::is_const_v<std::remove_reference_t<Arg>> &&
+                                       std::copy_constructible<std::remove_cvref_t<Arg>>));
+
+    // Forwarding emits the receiving signal from a slot of the forwarded one. Done recursively,
+    // the stack would grow with the length of forwarding chains, and cycles would overflow it.
+    // Instead, the outermost forwarding of a thread emits right away, then drains the emissions
+    // forwarded meanwhile, which were queued. Queued emissions therefore run after the remaining
+    // slots of the signal that forwarded them.
+    class forwarding_queue
+    {
+    public:
+        // A forwarded emission waiting for its turn. The target is the signal to emit.
+        class emission: public task
+        {
+        public:
+            explicit emission(const void* target):
+                m_target { target }
             {
-                return unsafe_shared_pointer<T> {};
             }
 
-            return unsafe_shared_pointer<T> { m_holder };
+            auto target() const -> const void*
+            {
+                return m_target;
+            }
+
+        protected:
+            ~emission() = default;
+
+        private:
+            const void* m_target;
+        };
+
+        static auto draining() -> bool
+        {
+            return s_queue.draining;
         }
 
-    private:
-        void increase()
+        template<std::invocable Emission>
+        static void emit_and_drain(Emission&& first_emission)
         {
-            if (m_holder != nullptr)
+            draining_scope scope;
+
+            std::invoke(std::forward<Emission>(first_emission));
+            for (auto* pending { pop() }; pending != nullptr; pending = pop())
             {
-                ++m_holder->weak_count;
+                pending->run();
             }
         }
 
-        void release()
+        static void push(emission& pending)
         {
-            if (m_holder == nullptr)
+            pending.next = nullptr;
+            if (s_queue.tail == nullptr)
             {
-                return;
+                s_queue.head = &pending;
             }
-
-            --m_holder->weak_count;
-            if (m_holder->weak_count == 0 && m_holder->count == 0)
+            else
             {
-                delete m_holder;
-                m_holder = nullptr;
+                s_queue.tail->next = &pending;
             }
+            s_queue.tail = &pending;
         }
 
-        pointer_holder* m_holder { nullptr };
-    };
-
-    template<details::basic_lockable Mutex = details::fake_mutex,
-             template<class> class SharedPointer = details::unsafe_shared_pointer>
-        requires details::shared_pointer_like<SharedPointer>
-    class receiver;
-
-} // namespace details
+        // The target is being destroyed: its pending emissions must not run.
+        static void cancel(const void* target)
+        {
+            emission* kept { nullptr };
+            emission* kept_tail { nullptr };
 
-// ### Forward declaration
+            for (auto* pending { pop() }; pending != nullptr; pending = pop())
+            {
+                if (pending->target() == target)
+                {
+                    pending->discard();
+                    continue;
+                }
 
-template<template<class> class SharedPointer>
-    requires details::shared_pointer_like<SharedPointer>
-class connection;
-template<template<class> class SharedPointer>
-    requires details::shared_pointer_like<SharedPointer>
-class scoped_connection;
+                pending->next = nullptr;
+                if (kept_tail == nullptr)
+                {
+                    kept = pending;
+                }
+                else
+                {
+                    kept_tail->next = pending;
+                }
+                kept_tail = pending;
+            }
 
-template<class Guard>
-concept guard_like = requires(Guard guard_instance) {
-    []<details::basic_lockable Mutex, template<class> class SharedPointer>(
-        const details::receiver<Mutex, SharedPointer>&)
-        requires details::shared_pointer_like<SharedPointer> {}(guard_instance);
-};
+            s_queue.head = kept;
+            s_queue.tail = kept_tail;
+        }
 
-template<class Callable,
-         class Guard = void,
-         details::execution_policy Policy = details::synchronous_policy>
-    requires(std::same_as<void, Guard> || guard_like<Guard>)
-class connect;
-class chainable;
+    private:
+        // Emissions left behind by an exception are discarded.
+        class draining_scope
+        {
+        public:
+            draining_scope()
+            {
+                s_queue.draining = true;
+            }
 
-namespace details
-{
-    template<std::derived_from<chainable> Chainable,
-             class Callable,
-             class Guard,
-             execution_policy Policy>
-        requires(std::same_as<void, Guard> || guard_like<Guard>)
-    class chain;
-    template<template<class> class SharedPointer>
-        requires shared_pointer_like<SharedPointer>
-    class source;
-    template<details::basic_lockable Mutex = details::fake_mutex,
-             template<class> class SharedPointer = details::unsafe_shared_pointer>
-        requires details::shared_pointer_like<SharedPointer>
-    class guard;
+            draining_scope(const draining_scope&) = delete;
+            draining_scope(draining_scope&&) = delete;
 
-    template<class Instance>
-    concept instance_of_source = requires(Instance instance) {
-        []<template<class> class SharedPointer>(const source<SharedPointer>&)
-            requires shared_pointer_like<SharedPointer>
-        {
+            auto operator=(const draining_scope&) -> draining_scope& = delete;
+            auto operator=(draining_scope&&) -> draining_scope& = delete;
 
-        }(instance);
-    };
-} // namespace details
+            ~draining_scope()
+            {
+                for (auto* pending { pop() }; pending != nullptr; pending = pop())
+                {
+                    pending->discard();
+                }
+                s_queue.draining = false;
+            }
+        };
 
-template<class Source>
-concept source_like =
-    requires(const Source& source, typename std::remove_cvref_t<Source>::args tuple) {
-        details::instance_of_source<std::remove_cvref_t<Source>>;
-        details::is_tuple<typename std::remove_cvref_t<Source>::args>;
+        struct queue
         {
-            []<class... Args>(const std::tuple<Args...>&)
-            { source.connect(std::function<void(Args...)> {}); }(tuple)
+            emission* head { nullptr };
+            emission* tail { nullptr };
+            bool draining { false };
         };
+
+        static auto pop() -> emission*
         {
-            []<class... Args>(const std::tuple<Args...>&)
-            { source.connect_once(std::function<void(Args...)> {}); }(tuple)
-        };
-        requires details::not_void<typename std::remove_cvref_t<Source>::connection_type>;
-        requires details::not_void<typename std::remove_cvref_t<Source>::connectable_type>;
+            auto* pending { s_queue.head };
+            if (pending != nullptr)
+            {
+                s_queue.head = static_cast<emission*>(pending->next);
+                if (s_queue.head == nullptr)
+                {
+                    s_queue.tail = nullptr;
+                }
+            }
+            return pending;
+        }
+
+        static thread_local queue s_queue;
     };
 
-namespace details
-{
-    template<class Receiver, class MemberSignal, execution_policy Policy>
-    class forward_result;
+    // Defined once the queue is complete, as its default member initializers are needed.
+    inline thread_local forwarding_queue::queue forwarding_queue::s_queue;
 
-    template<class Receiver, class Signal, execution_policy Policy>
-    class forward_result<Receiver, Signal Receiver::*, Policy>
+    template<class BasicLockable>
+    concept basic_lockable = requires(BasicLockable lockable) {
+        { lockable.lock() };
+        { lockable.unlock() };
+    };
+
+    class fake_mutex
     {
     public:
-        forward_result(const Receiver& receiver,
-                       Signal Receiver::* receiver_signal,
-                       Policy&& policy,
-                       bool connect_once):
-            m_receiver { receiver },
-            m_receiver_signal { receiver_signal },
-            m_policy { std::forward<Policy>(policy) },
-            m_connect_once { connect_once }
+        constexpr void lock()
         {
         }
 
-        template<source_like Source>
-        auto create_connection(Source&& origin) ->
-            typename std::remove_cvref_t<Source>::connection_type;
-
-    private:
-        // It might be bad, but this is done on purpose.
-        // NOLINTNEXTLINE(cppcoreguidelines-avoid-const-or-ref-data-members)
-        const Receiver& m_receiver;
-        Signal Receiver::* m_receiver_signal;
-        Policy m_policy;
-        bool m_connect_once;
+        constexpr void unlock()
+        {
+        }
     };
 
-    template<class... Tuples>
-    struct tuple_cat_result;
-
-    template<class... Tuples>
-    using tuple_cat_result_t = tuple_cat_result<Tuples...>::type;
-
-    template<>
-    struct tuple_cat_result<>
-    {
-        using type = std::tuple<>;
+    template<template<class> class PointerLike>
+    concept shared_pointer_like = requires(PointerLike<int> pointer) {
+        { *pointer } -> std::same_as<int&>;
+        { pointer = PointerLike<int> {} } -> std::same_as<PointerLike<int>&>;
+        { pointer == nullptr } -> std::convertible_to<bool>;
+        { pointer == PointerLike<int> {} } -> std::convertible_to<bool>;
+        { static_cast<bool>(pointer) };
+        { PointerLike<int> { pointer } } -> std::same_as<PointerLike<int>>;
+        { PointerLike<int> { std::move(pointer) } } -> std::same_as<PointerLike<int>>;
+        { PointerLike<int> {} } -> std::same_as<PointerLike<int>>;
+        { pointer.~PointerLike<int>() };
+        requires not_void<typename PointerLike<int>::weak_type>;
+        { pointer.get() } -> std::same_as<int*>;
     };
 
-    template<class... Args>
-    struct tuple_cat_result<std::tuple<Args...>>
+    struct pointer_holder
     {
-        using type = std::tuple<Args...>;
+        void* pointer { nullptr };
+        std::size_t count { 0 };
+        std::size_t weak_count { 0 };
     };
 
-    template<class... LhsArgs, class... RhsArgs>
-    struct tuple_cat_result<std::tuple<LhsArgs...>, std::tuple<RhsArgs...>>
-    {
-        using type = std::tuple<LhsArgs..., RhsArgs...>;
-    };
+    template<class T>
+    class unsafe_weak_pointer;
 
-    template<class Lhs, class Rhs, class... Others>
-    struct tuple_cat_result<Lhs, Rhs, Others...>
+    template<class T>
+    class unsafe_shared_pointer
     {
-        using type = tuple_cat_result_t<tuple_cat_result_t<Lhs, Rhs>, Others...>;
-    };
+    public:
+        friend class unsafe_weak_pointer<T>;
 
-    template<class Self, class Callable, class Guard>
-    concept callable_with_no_guard = requires {
-        std::same_as<void, Guard>;
-        partially_tuple_callable<Callable, typename std::remove_cvref_t<Self>::args>;
-    };
+        template<class>
+        friend class unsafe_shared_pointer;
 
-    template<class Self, class Callable, class Guard>
-    concept callable_with_guard = requires {
-        guard_like<Guard>;
-        partially_tuple_callable<Callable, typename std::remove_cvref_t<Self>::args>;
-    };
+        using weak_type = unsafe_weak_pointer<T>;
 
-    template<class Self, class Callable, class Guard>
-    concept method_with_guard = requires {
-        guard_like<Guard>;
-        std::is_member_function_pointer_v<Callable>;
-        partially_tuple_callable<
-            Callable,
-            tuple_cat_result_t<std::tuple<Guard>, typename std::remove_cvref_t<Self>::args>>;
-    };
+        unsafe_shared_pointer() = default;
 
-    // ### Class emitter declaration
+        explicit unsafe_shared_pointer(std::nullptr_t)
+        {
+        }
 
-    template<basic_lockable Mutex = fake_mutex,
-             template<class> class SharedPointer = unsafe_shared_pointer>
-        requires shared_pointer_like<SharedPointer>
-    class emitter
-    {
-    public:
-        friend class connection<SharedPointer>;
-        friend class scoped_connection<SharedPointer>;
-        friend class guard<Mutex, SharedPointer>;
-        friend class source<SharedPointer>;
-        friend class ::chainable;
-        template<std::derived_from<chainable> Chainable,
-                 class Callable,
-                 class Guard,
-                 execution_policy Policy>
-            requires(std::same_as<void, Guard> || guard_like<Guard>)
-        friend class chain;
-        template<class Receiver, class MemberSignal, execution_policy Policy>
-        friend class forward_result;
+        explicit unsafe_shared_pointer(T* pointer):
+            m_holder {
+                (pointer != nullptr)
+                    ? new pointer_holder { .pointer = static_cast<void*>(pointer), .count = 1 }
+                    : nullptr
+        }
+        {
+        }
 
-        emitter() = default;
+        unsafe_shared_pointer(const unsafe_shared_pointer& other):
+            m_holder { other.m_holder }
+        {
+            increase();
+        }
 
-        emitter(const emitter&) = default;
-        emitter(emitter&&) = default;
+        unsafe_shared_pointer(unsafe_shared_pointer&& other) noexcept
+        {
+            std::swap(m_holder, other.m_holder);
+        }
 
-        auto operator=(const emitter&) -> emitter& = default;
-        auto operator=(emitter&&) -> emitter& = default;
+        auto operator=(const unsafe_shared_pointer& other) -> unsafe_shared_pointer&
+        {
+            if (&other == this)
+            {
+                return *this;
+            }
 
-        virtual ~emitter() = default;
+            release();
 
-    protected:
-        template<signal_arg... Args>
-        class signal;
+            m_holder = other.m_holder;
 
-        template<class Emitter, signal_arg... Args, class... EmittedArgs>
-            requires std::invocable<typename signal<Args...>::slot, EmittedArgs&&...>
-        void emit(this const Emitter& self,
-                  signal<Args...> Emitter::* emitted_signal,
-                  EmittedArgs&&... emitted_args)
-        {
-            (self.*emitted_signal).emit(std::forward<EmittedArgs>(emitted_args)...);
+            increase();
+            return *this;
         }
 
-        template<class Receiver,
-                 signal_arg... ReceiverArgs,
-                 source_like Emitter,
-                 execution_policy Policy = synchronous_policy>
-            requires(partially_tuple_callable<typename signal<ReceiverArgs...>::slot,
-                                              typename std::remove_cvref_t<Emitter>::args>)
-        auto connect(this const Receiver& self,
-                     Emitter&& emitter,
-                     signal<ReceiverArgs...> Receiver::* receiver_signal,
-                     Policy&& policy = {}) ->
-            typename std::remove_cvref_t<Emitter>::connection_type;
-
-        template<class Receiver,
-                 signal_arg... ReceiverArgs,
-                 source_like Emitter,
-                 execution_policy Policy = synchronous_policy>
-            requires(partially_tuple_callable<typename signal<ReceiverArgs...>::slot,
-                                              typename std::remove_cvref_t<Emitter>::args>)
-        auto connect_once(this const Receiver& self,
-                          Emitter&& emitter,
-                          signal<ReceiverArgs...> Receiver::* receiver_signal,
-                          Policy&& policy = {}) ->
-            typename std::remove_cvref_t<Emitter>::connection_type;
-
-        template<class Receiver, class Signal, execution_policy Policy = synchronous_policy>
-        auto forward_to(this const Receiver& self,
-                        Signal Receiver::* receiver_signal,
-                        Policy&& policy = {})
-            -> forward_result<Receiver, Signal Receiver::*, Policy>;
+        auto operator=(unsafe_shared_pointer&& other) noexcept -> unsafe_shared_pointer&
+        {
+            if (&other == this)
+            {
+                return *this;
+            }
 
-        template<class Receiver, class Signal, execution_policy Policy = synchronous_policy>
-        auto forward_once_to(this const Receiver& self,
-                             Signal Receiver::* receiver_signal,
-                             Policy&& policy = {})
-            -> forward_result<Receiver, Signal Receiver::*, Policy>;
+            release();
 
-    private:
-        template<class Receiver, details::signal_arg... ReceiverArgs>
-        auto forwarding_lambda(this const Receiver& self,
-                               signal<ReceiverArgs...> Receiver::* receiver_signal);
-    };
+            m_holder = other.m_holder;
+            other.m_holder = nullptr;
 
-    template<class Appliable, class Source>
-    concept appliable = requires(const Source& source, Appliable appliable) {
-        ::source_like<Source>;
-        { appliable.accept(source) } -> ::source_like;
-    };
+            return *this;
+        }
 
-    template<class EmitterLike>
-    concept emitter_like = requires(EmitterLike emitter_instance) {
-        []<basic_lockable Mutex, template<class> class SharedPointer>(
-            const emitter<Mutex, SharedPointer>&)
-            requires shared_pointer_like<SharedPointer> {}(emitter_instance);
-    };
+        ~unsafe_shared_pointer()
+        {
+            release();
+        }
 
-    template<class SignalLike, class Emitter>
-    concept signal_like = requires(SignalLike signal_instance) {
-        requires emitter_like<Emitter>;
-        []<signal_arg... Args>(const typename Emitter::template signal<Args...>&) {}(
-            signal_instance);
-    };
+        auto operator==(T* other) const -> bool
+        {
+            if (other == nullptr)
+            {
+                return m_holder == nullptr;
+            }
 
-    class connection_holder;
+            if (m_holder == nullptr)
+            {
+                return false;
+            }
 
-    // ### Class source
-    template<template<class> class SharedPointer>
-        requires shared_pointer_like<SharedPointer>
-    class source
-    {
-    public:
-        using connection_type = connection<SharedPointer>;
+            return other == m_holder->pointer;
+        }
 
-        template<::source_like Self, appliable<Self> Appliable>
-        auto apply(this Self&& self, Appliable&& appliable)
+        auto operator==(const unsafe_shared_pointer& other) const -> bool
         {
-            return std::forward<Appliable>(appliable).accept(std::forward<Self>(self));
+            return other.m_holder == m_holder;
         }
 
-        template<::source_like Self, appliable<Self> Appliable>
-        auto operator|(this Self&& self, Appliable&& appliable)
+        auto operator==(std::nullptr_t) const -> bool
         {
-            return std::forward<Self>(self).apply(std::forward<Appliable>(appliable));
+            return m_holder == nullptr || m_holder->pointer == nullptr;
         }
 
-        template<::source_like Self, class Callable, class Guard, execution_policy Policy>
-            requires(callable_with_no_guard<Self, Callable, Guard> ||
-                     callable_with_guard<Self, Callable, Guard> ||
-                     method_with_guard<Self, Callable, Guard>)
-        auto operator|(this Self&& self, connect<Callable, Guard, Policy>& connect)
+        auto operator*() const -> T&
         {
-            return connect.create_connection(std::forward<Self>(self));
+            return *static_cast<T*>(m_holder->pointer);
         }
 
-        template<::source_like Self, class Callable, class Guard, execution_policy Policy>
-            requires(callable_with_no_guard<Self, Callable, Guard> ||
-                     callable_with_guard<Self, Callable, Guard> ||
-                     method_with_guard<Self, Callable, Guard>)
-        auto operator|(this Self&& self, connect<Callable, Guard, Policy>&& connect)
+        auto get() const -> T*
         {
-            return std::move(connect).create_connection(std::forward<Self>(self));
+            if (m_holder == nullptr)
+            {
+                return nullptr;
+            }
+
+            return static_cast<T*>(m_holder->pointer);
         }
 
-        template<::source_like Self,
-                 class Receiver,
-                 signal_like<Receiver> Signal,
-                 execution_policy Policy>
-            requires partially_tuple_callable<typename Signal::slot,
-                                              typename std::remove_cvref_t<Self>::args>
-        auto operator|(
-            this Self&& self,
-            details::template forward_result<Receiver, Signal Receiver::*, Policy>& connect_result)
+        auto operator->() const -> T*
         {
-            return connect_result.create_connection(std::forward<Self>(self));
+            return get();
         }
 
-        template<::source_like Self,
-                 class Receiver,
-                 signal_like<Receiver> Signal,
-                 execution_policy Policy>
-            requires partially_tuple_callable<typename Signal::slot,
-                                              typename std::remove_cvref_t<Self>::args>
-        auto operator|(
-            this Self&& self,
-            details::template forward_result<Receiver, Signal Receiver::*, Policy>&& connect_result)
+        explicit operator bool() const
         {
-            return std::move(connect_result).create_connection(std::forward<Self>(self));
+            return m_holder != nullptr && m_holder->pointer != nullptr;
         }
-    };
 
-    class connection_holder
-    {
-    public:
-        using exception_handler = std::function<void(std::exception_ptr)>;
+        template<class Base>
+            requires std::derived_from<T, Base>
+        explicit operator unsafe_shared_pointer<Base>()
+        {
+            return unsafe_shared_pointer<Base> { m_holder };
+        }
 
-        virtual ~connection_holder() = default;
-        virtual void add_exception_handler(connection_holder::exception_handler handler) = 0;
+        template<class Base>
+            requires std::derived_from<T, Base>
+        explicit operator unsafe_weak_pointer<Base>()
+        {
+            return unsafe_weak_pointer<Base> { unsafe_shared_pointer<Base> { m_holder } };
+        }
 
-        virtual void disconnect() = 0;
-        virtual void suspend() = 0;
-        virtual void resume() = 0;
-    };
+    private:
+        void increase()
+        {
+            if (m_holder != nullptr)
+            {
+                ++m_holder->count;
+            }
+        }
 
-    template<basic_lockable Mutex, template<class> class SharedPointer>
-        requires shared_pointer_like<SharedPointer>
-    template<class Receiver, class Signal, execution_policy Policy>
-    auto emitter<Mutex, SharedPointer>::forward_to(this const Receiver& self,
-                                                   Signal Receiver::* receiver_signal,
-                                                   Policy&& policy)
-        -> forward_result<Receiver, Signal Receiver::*, Policy>
-    {
-        return { self, receiver_signal, std::forward<Policy>(policy), false };
-    }
+        void release()
+        {
+            if (m_holder == nullptr)
+            {
+                return;
+            }
 
-    template<basic_lockable Mutex, template<class> class SharedPointer>
-        requires shared_pointer_like<SharedPointer>
-    template<class Receiver, class Signal, execution_policy Policy>
-    auto emitter<Mutex, SharedPointer>::forward_once_to(this const Receiver& self,
-                                                        Signal Receiver::* receiver_signal,
-                                                        Policy&& policy)
-        -> forward_result<Receiver, Signal Receiver::*, Policy>
-    {
-        return { self, receiver_signal, std::forward<Policy>(policy), true };
-    }
+            --m_holder->count;
+            if (m_holder->count == 0)
+            {
+                delete get();
+                m_holder->pointer = nullptr;
 
-} // namespace details
+                if (m_holder->weak_count == 0)
+                {
+                    delete m_holder;
+                    m_holder = nullptr;
+                }
+            }
+        }
 
-// ### Connection related classes
+        explicit unsafe_shared_pointer(pointer_holder* holder):
+            m_holder { holder }
+        {
+            increase();
+        }
 
-template<template<class> class SharedPointer>
-    requires details::shared_pointer_like<SharedPointer>
-class connection
-{
-public:
-    explicit connection(typename SharedPointer<details::connection_holder>::weak_type weak_holder):
-        m_holder { std::move(weak_holder) }
-    {
-    }
+        pointer_holder* m_holder { nullptr };
+    };
 
-    void disconnect()
+    template<class T>
+    class unsafe_weak_pointer
     {
-        auto locked_holder { m_holder.lock() };
-        if (!locked_holder)
+    public:
+        unsafe_weak_pointer() = default;
+
+        explicit unsafe_weak_pointer(unsafe_shared_pointer<T> shared_pointer):
+            m_holder { shared_pointer.m_holder }
         {
-            return;
+            increase();
         }
 
-        locked_holder->disconnect();
-    }
-
-    void suspend()
-    {
-        auto locked_holder { m_holder.lock() };
-        if (!locked_holder)
+        unsafe_weak_pointer(const unsafe_weak_pointer& other):
+            m_holder { other.m_holder }
         {
-            return;
+            increase();
         }
 
-        locked_holder->suspend();
-    }
+        unsafe_weak_pointer(unsafe_weak_pointer&& other) noexcept
+        {
+            std::swap(m_holder, other.m_holder);
+        }
 
-    void resume()
-    {
-        auto locked_holder { m_holder.lock() };
-        if (!locked_holder)
+        auto operator=(const unsafe_weak_pointer& other) -> unsafe_weak_pointer&
         {
-            return;
+            if (&other == this)
+            {
+                return *this;
+            }
+
+            release();
+
+            m_holder = other.m_holder;
+
+            increase();
+
+            return *this;
         }
 
-        locked_holder->resume();
-    }
+        auto operator=(unsafe_weak_pointer&& other) noexcept -> unsafe_weak_pointer&
+        {
+            std::swap(m_holder, other.m_holder);
 
-    void add_exception_handler(details::connection_holder::exception_handler handler)
-    {
-        auto locked_holder { m_holder.lock() };
-        if (!locked_holder)
+            other.m_holder = nullptr;
+
+            return *this;
+        }
+
+        ~unsafe_weak_pointer()
         {
-            return;
+            release();
         }
 
-        locked_holder->add_exception_handler(std::move(handler));
-    }
+        auto lock() const -> unsafe_shared_pointer<T>
+        {
+            if (m_holder == nullptr)
+            {
+                return unsafe_shared_pointer<T> {};
+            }
 
-    auto operator==(details::connection_holder* holder) -> bool
-    {
-        return m_holder.lock().get() == holder;
-    }
+            if (m_holder->count == 0)
+            {
+                return unsafe_shared_pointer<T> {};
+            }
 
-private:
-    typename SharedPointer<details::connection_holder>::weak_type m_holder;
-};
+            return unsafe_shared_pointer<T> { m_holder };
+        }
 
-template<template<class> class SharedPointer>
-    requires details::shared_pointer_like<SharedPointer>
-class scoped_connection
-{
-public:
-    // Not explicit on purpose to allow scoped_connection = object.signal.connect(slot);
-    // NOLINTNEXTLINE(google-explicit-constructor)
-    scoped_connection(connection<SharedPointer> conn):
-        m_connection { std::move(conn) }
-    {
-    }
+    private:
+        void increase()
+        {
+            if (m_holder != nullptr)
+            {
+                ++m_holder->weak_count;
+            }
+        }
 
-    scoped_connection(const scoped_connection&) = delete;
+        void release()
+        {
+            if (m_holder == nullptr)
+            {
+                return;
+            }
 
-    scoped_connection(scoped_connection&& other) noexcept:
-        m_connection { std::move(other.m_connection) }
-    {
-    }
+            --m_holder->weak_count;
+            if (m_holder->weak_count == 0 && m_holder->count == 0)
+            {
+                delete m_holder;
+                m_holder = nullptr;
+            }
+        }
 
-    auto operator=(const scoped_connection&) -> scoped_connection& = delete;
+        pointer_holder* m_holder { nullptr };
+    };
 
-    auto operator=(scoped_connection&& other) noexcept -> scoped_connection&
-    {
-        m_connection = std::move(other.m_connection);
-        return *this;
-    }
+    template<details::basic_lockable Mutex = details::fake_mutex,
+             template<class> class SharedPointer = details::unsafe_shared_pointer>
+        requires details::shared_pointer_like<SharedPointer>
+    class receiver;
 
-    ~scoped_connection()
-    {
-        disconnect();
-    }
+    template<basic_lockable Mutex, template<class> class SharedPointer>
+        requires shared_pointer_like<SharedPointer>
+    class connection_group;
 
-    void disconnect()
-    {
-        m_connection.disconnect();
-    }
+    template<class Source, class Notifier, class Connectable>
+    class take_until_source;
 
-    auto operator==(details::connection_holder* holder) -> bool
-    {
-        return m_connection == holder;
-    }
+} // namespace details
 
-private:
-    connection<SharedPointer> m_connection;
-};
+// ### Forward declaration
 
 template<template<class> class SharedPointer>
     requires details::shared_pointer_like<SharedPointer>
-class inhibitor
-{
-public:
-    explicit inhibitor(connection<SharedPointer> conn):
-        m_connection { std::move(conn) }
-    {
-        m_connection.suspend();
-    }
-
-    inhibitor(const inhibitor&) = default;
-    inhibitor(inhibitor&&) = default;
+class connection;
+template<template<class> class SharedPointer>
+    requires details::shared_pointer_like<SharedPointer>
+class scoped_connection;
 
-    auto operator=(const inhibitor&) -> inhibitor& = default;
-    auto operator=(inhibitor&&) -> inhibitor& = default;
+template<class Guard>
+concept guard_like = requires(Guard guard_instance) {
+    []<details::basic_lockable Mutex, template<class> class SharedPointer>(
+        const details::receiver<Mutex, SharedPointer>&)
+        requires details::shared_pointer_like<SharedPointer> {}(guard_instance);
+};
 
-    ~inhibitor()
-    {
-        m_connection.resume();
-    }
+template<class Callable,
+         class Guard = void,
+         details::execution_policy Policy = details::synchronous_policy>
+    requires(std::same_as<void, Guard> || guard_like<Guard>)
+class connect;
+class chainable;
 
-private:
-    connection<SharedPointer> m_connection;
-};
+namespace details
+{
+    template<std::derived_from<chainable> Chainable,
+             class Callable,
+             class Guard,
+             execution_policy Policy>
+        requires(std::same_as<void, Guard> || guard_like<Guard>)
+    class chain;
+    template<template<class> class SharedPointer>
+        requires shared_pointer_like<SharedPointer>
+    class source;
+    template<details::basic_lockable Mutex = details::fake_mutex,
+             template<class> class SharedPointer = details::unsafe_shared_pointer>
+        requires details::shared_pointer_like<SharedPointer>
+    class guard;
+    template<class Stage,
+             class Source,
+             class StageArgs = typename std::remove_cvref_t<Source>::args,
+             class Connectable = typename std::remove_cvref_t<Source>::connectable_type>
+    class shared_stage;
+    template<class Stage, class StageArgs, class Connectable, class... Sources>
+    class fan_in_stage;
+    template<basic_lockable Mutex, template<class> class SharedPointer, signal_arg... Args>
+        requires shared_pointer_like<SharedPointer>
+    class topic_broker;
 
-// ### Class receiver
+    template<class Instance>
+    concept instance_of_source = requires(Instance instance) {
+        []<template<class> class SharedPointer>(const source<SharedPointer>&)
+            requires shared_pointer_like<SharedPointer>
+        {
+
+        }(instance);
+    };
+} // namespace details
+
+template<class Source>
+concept source_like =
+    requires(const Source& source, typename std::remove_cvref_t<Source>::args tuple) {
+        details::instance_of_source<std::remove_cvref_t<Source>>;
+        details::is_tuple<typename std::remove_cvref_t<Source>::args>;
+        {
+            []<class... Args>(const std::tuple<Args...>&)
+            { source.connect(std::function<void(Args...)> {}); }(tuple)
+        };
+        {
+            []<class... Args>(const std::tuple<Args...>&)
+            { source.connect_once(std::function<void(Args...)> {}); }(tuple)
+        };
+        requires details::not_void<typename std::remove_cvref_t<Source>::connection_type>;
+        requires details::not_void<typename std::remove_cvref_t<Source>::connectable_type>;
+    };
 
 namespace details
 {
-    template<details::basic_lockable Mutex, template<class> class SharedPointer>
-        requires details::shared_pointer_like<SharedPointer>
-    class guard
+    template<class Receiver, class MemberSignal, execution_policy Policy>
+    class forward_result;
+
+    template<class Receiver, class Signal, execution_policy Policy>
+    class forward_result<Receiver, Signal Receiver::*, Policy>
     {
     public:
-        template<details::signal_arg... Args>
-        friend class emitter<Mutex, SharedPointer>::signal;
+        forward_result(const Receiver& receiver,
+                       Signal Receiver::* receiver_signal,
+                       Policy&& policy,
+                       bool connect_once):
+            m_receiver { receiver },
+            m_receiver_signal { receiver_signal },
+            m_policy { std::forward<Policy>(policy) },
+            m_connect_once { connect_once }
+        {
+        }
 
-        guard() = default;
-        ~guard() = default;
+        template<source_like Source>
+        auto create_connection(Source&& origin) ->
+            typename std::remove_cvref_t<Source>::connection_type;
 
-        guard(const guard&)
+    private:
+        // It might be bad, but this is done on purpose.
+        // NOLINTNEXTLINE(cppcoreguidelines-avoid-const-or-ref-data-members)
+        const Receiver& m_receiver;
+        Signal Receiver::* m_receiver_signal;
+        Policy m_policy;
+        bool m_connect_once;
+    };
+
+    template<class... Tuples>
+    struct tuple_cat_result;
+
+    template<class... Tuples>
+    using tuple_cat_result_t = tuple_cat_result<Tuples...>::type;
+
+    template<>
+    struct tuple_cat_result<>
+    {
+        using type = std::tuple<>;
+    };
+
+    template<class... Args>
+    struct tuple_cat_result<std::tuple<Args...>>
+    {
+        using type = std::tuple<Args...>;
+    };
+
+    template<class... LhsArgs, class... RhsArgs>
+    struct tuple_cat_result<std::tuple<LhsArgs...>, std::tuple<RhsArgs...>>
+    {
+        using type = std::tuple<LhsArgs..., RhsArgs...>;
+    };
+
+    template<class Lhs, class Rhs, class... Others>
+    struct tuple_cat_result<Lhs, Rhs, Others...>
+    {
+        using type = tuple_cat_result_t<tuple_cat_result_t<Lhs, Rhs>, Others...>;
+    };
+
+    template<class Self, class Callable, class Guard>
+    concept callable_with_no_guard = requires {
+        std::same_as<void, Guard>;
+        partially_tuple_callable<Callable, typename std::remove_cvref_t<Self>::args>;
+    };
+
+    template<class Self, class Callable, class Guard>
+    concept callable_with_guard = requires {
+        guard_like<Guard>;
+        partially_tuple_callable<Callable, typename std::remove_cvref_t<Self>::args>;
+    };
+
+    template<class Self, class Callable, class Guard>
+    concept method_with_guard = requires {
+        guard_like<Guard>;
+        std::is_member_function_pointer_v<Callable>;
+        partially_tuple_callable<
+            Callable,
+            tuple_cat_result_t<std::tuple<Guard>, typename std::remove_cvref_t<Self>::args>>;
+    };
+
+    // ### Class emitter declaration
+
+    template<basic_lockable Mutex = fake_mutex,
+             template<class> class SharedPointer = unsafe_shared_pointer>
+        requires shared_pointer_like<SharedPointer>
+    class emitter
+    {
+    public:
+        friend class connection<SharedPointer>;
+        friend class scoped_connection<SharedPointer>;
+        friend class guard<Mutex, SharedPointer>;
+        friend class source<SharedPointer>;
+        friend class ::chainable;
+        template<std::derived_from<chainable> Chainable,
+                 class Callable,
+                 class Guard,
+                 execution_policy Policy>
+            requires(std::same_as<void, Guard> || guard_like<Guard>)
+        friend class chain;
+        template<class Receiver, class MemberSignal, execution_policy Policy>
+        friend class forward_result;
+
+        emitter() = default;
+
+        // A copy is a new emitter: it is neither blocked nor has suppressed anything.
+        emitter(const emitter&)
         {
-            // Empty on purpose
+            // Nothing on purpose
         }
 
-        guard(guard&&) noexcept
+        emitter(emitter&&) noexcept
         {
             // Nothing on purpose
         }
 
-        auto operator=(const guard&) -> guard&
+        auto operator=(const emitter&) -> emitter&
         {
             // Nothing on purpose
             return *this;
         }
 
-        auto operator=(guard&&) noexcept -> guard&
+        auto operator=(emitter&&) noexcept -> emitter&
         {
             // Nothing on purpose
             return *this;
         }
 
-    protected:
-        void clean(details::connection_holder* holder) const
+        virtual ~emitter() = default;
+
+        // While blocked, emitting any signal of the emitter is a no-op, forwarded emissions
+        // included. Each call to block_signals must be matched by a call to unblock_signals.
+        void block_signals()
         {
-            std::lock_guard lock { m_mutex };
-            std::erase(m_emitting_sources, holder);
+            m_blocked.fetch_add(1, std::memory_order_relaxed);
         }
 
-        void add_emitting_source(connection<SharedPointer> source) const
+        void unblock_signals()
         {
-            std::lock_guard lock { m_mutex };
-            m_emitting_sources.emplace_back(std::move(source));
+            release_block(m_blocked);
         }
 
-    private:
-        mutable std::vector<scoped_connection<SharedPointer>> m_emitting_sources;
-        mutable Mutex m_mutex;
-    };
+        auto signals_blocked() const -> bool
+        {
+            return m_blocked.load(std::memory_order_relaxed) != 0;
+        }
 
-    template<basic_lockable Mutex, template<class> class SharedPointer>
-        requires shared_pointer_like<SharedPointer>
-    class receiver: public guard<Mutex, SharedPointer>
-    {
-    public:
+        // Emissions dropped because the emitter was blocked.
+        auto suppressed_emissions() const -> std::size_t
+        {
+            return m_suppressed_emissions.load(std::memory_order_relaxed);
+        }
+
+        // Freezes each signal of the emitter on its next emission, properties included. A
+        // signal unfrozen by a change of its connections stays so until freeze_all is called
+        // again.
+        void freeze_all()
+        {
+            m_freezes.fetch_add(1, std::memory_order_relaxed);
+        }
+
+    protected:
         template<signal_arg... Args>
-        friend class emitter<Mutex, SharedPointer>::signal;
-    };
+        class signal;
 
-} // namespace details
+        // Signals whose slots return results, combined when emitting.
+        template<class Result, signal_arg... Args>
+        class signal<Result(Args...)>;
 
-// ### connectable
+        // Holds a value, and emits it when it changes. Connections are given the current value
+        // as soon as they are made.
+        template<class T, class Equal = std::equal_to<>>
+        class property;
 
-template<template<class> class SharedPointer>
-    requires details::shared_pointer_like<SharedPointer>
-class connectable: public details::source<SharedPointer>
-{
-public:
-    using connectable_type = connectable<SharedPointer>;
+        template<class Emitter, signal_arg... Args, class... EmittedArgs>
+            requires std::invocable<typename signal<Args...>::slot, EmittedArgs&&...>
+        void emit(this const Emitter& self,
+                  signal<Args...> Emitter::* emitted_signal,
+                  EmittedArgs&&... emitted_args)
+        {
+            const auto& emitting { static_cast<const emitter&>(self) };
+            if (emitting.suppress_emission())
+            {
+                return;
+            }
 
-    template<class Self,
-             class Callable,
-             details::execution_policy Policy = details::synchronous_policy>
-    auto connect(this Self&& self, Callable&& callable, Policy&& policy = {})
-        -> connection<SharedPointer>
-    {
-        return std::forward<Self>(self).m_source.connect(
-            std::forward<Self>(self).forwarding_lambda(std::forward<Callable>(callable)),
-            std::forward<Policy>(policy));
-    }
+            (self.*emitted_signal).follow_freezes(emitting.freezes());
+            (self.*emitted_signal).emit(std::forward<EmittedArgs>(emitted_args)...);
+        }
 
-    template<class Self,
-             class Callable,
-             details::execution_policy Policy = details::synchronous_policy>
-    auto connect_once(this Self&& self, Callable&& callable, Policy&& policy = {})
-        -> connection<SharedPointer>
-    {
-        return std::forward<Self>(self).m_source.connect_once(
-            std::forward<Self>(self).forwarding_lambda(std::forward<Callable>(callable)),
-            std::forward<Policy>(policy));
-    }
+        // Combines the results of the slots of a signal returning results. The combiner is given
+        // each result in turn, and slots aren't called anymore once it is done.
+        template<class Emitter,
+                 class Result,
+                 signal_arg... Args,
+                 class Combiner,
+                 class... EmittedArgs>
+            requires(combiner<std::remove_cvref_t<Combiner>, Result> &&
+                     std::invocable<std::function<void(Args...)>, EmittedArgs && ...>)
+        auto emit(this const Emitter& self,
+                  signal<Result(Args...)> Emitter::* emitted_signal,
+                  Combiner&& combiner,
+                  EmittedArgs&&... emitted_args)
+        {
+            const auto& emitting { static_cast<const emitter&>(self) };
+            if (!emitting.suppress_emission())
+            {
+                (self.*emitted_signal).follow_freezes(emitting.freezes());
+                (self.*emitted_signal)
+                    .emit_combined(combiner, std::forward<EmittedArgs>(emitted_args)...);
+            }
 
-    template<class Self,
-             class Callable,
-             guard_like Receiver,
-             details::execution_policy Policy = details::synchronous_policy>
-    auto connect(this Self&& self, Callable&& callable, const Receiver& guard, Policy&& policy = {})
-        -> connection<SharedPointer>
-    {
-        return std::forward<Self>(self).m_source.connect(
-            std::forward<Self>(self).forwarding_lambda(std::forward<Callable>(callable)),
-            guard,
-            std::forward<Policy>(policy));
-    }
+            return combiner.result();
+        }
 
-    template<class Self,
-             class Callable,
-             guard_like Receiver,
-             details::execution_policy Policy = details::synchronous_policy>
-    auto connect_once(this Self&& self,
-                      Callable&& callable,
-                      const Receiver& guard,
-                      Policy&& policy = {}) -> connection<SharedPointer>
-    {
-        return std::forward<Self>(self).m_source.connect_once(
-            std::forward<Self>(self).forwarding_lambda(std::forward<Callable>(callable)),
-            guard,
-            std::forward<Policy>(policy));
-    }
-
-    template<class Self,
-             guard_like Receiver,
-             class Result,
-             details::execution_policy Policy = details::synchronous_policy,
-             class... MemberFunctionArgs>
-    auto connect(this Self&& self,
-                 Result (Receiver::*callable)(MemberFunctionArgs...),
-                 Receiver& guard,
-                 Policy&& policy = {}) -> connection<SharedPointer>
-    {
-        return std::forward<Self>(self).m_source.connect(
-            std::forward<Self>(self).forwarding_lambda(
-                [&guard, callable]<class... Args>(Args&&... args) mutable
-        { partial_call(callable, guard, std::forward<Args>(args)...); }),
-            guard,
-            std::forward<Policy>(policy));
-    }
-
-    template<class Self,
-             guard_like Receiver,
-             class Result,
-             details::execution_policy Policy = details::synchronous_policy,
-             class... MemberFunctionArgs>
-    auto connect_once(this Self&& self,
-                      Result (Receiver::*callable)(MemberFunctionArgs...),
-                      Receiver& guard,
-                      Policy&& policy = {}) -> connection<SharedPointer>
-    {
-        return std::forward<Self>(self).m_source.connect_once(
-            std::forward<Self>(self).forwarding_lambda(
-                [&guard, callable]<class... Args>(Args&&... args) mutable
-        { partial_call(callable, guard, std::forward<Args>(args)...); }),
-            guard,
-            std::forward<Policy>(policy));
-    }
-
-    template<class Self,
-             guard_like Receiver,
-             class Result,
-             details::execution_policy Policy = details::synchronous_policy,
-             class... MemberFunctionArgs>
-    auto connect(this Self&& self,
-                 Result (Receiver::*callable)(MemberFunctionArgs...) const,
-                 const Receiver& guard,
-                 Policy&& policy = {}) -> connection<SharedPointer>
-    {
-        return std::forward<Self>(self).m_source.connect(
-            std::forward<Self>(self).forwarding_lambda(
-                [&guard, callable]<class... Args>(Args&&... args) mutable
-        { partial_call(callable, guard, std::forward<Args>(args)...); }),
-            guard,
-            std::forward<Policy>(policy));
-    }
-
-    template<class Self,
-             guard_like Receiver,
-             class Result,
-             details::execution_policy Policy = details::synchronous_policy,
-             class... MemberFunctionArgs>
-    auto connect_once(this Self&& self,
-                      Result (Receiver::*callable)(MemberFunctionArgs...) const,
-                      const Receiver& guard,
-                      Policy&& policy = {}) -> connection<SharedPointer>
-    {
-        return std::forward<Self>(self).m_source.connect_once(
-            std::forward<Self>(self).forwarding_lambda(
-                [&guard, callable]<class... Args>(Args&&... args) mutable
-        { partial_call(callable, guard, std::forward<Args>(args)...); }),
-            guard,
-            std::forward<Policy>(policy));
-    }
-};
-
-// ### class chainable
-
-class chainable;
-
-namespace details
-{
-    // ### Signal definition
-
-    template<basic_lockable Mutex, template<class> class SharedPointer>
-        requires shared_pointer_like<SharedPointer>
-    template<signal_arg... Args>
-    class emitter<Mutex, SharedPointer>::signal final: public source<SharedPointer>,
-                                                       public guard<Mutex, SharedPointer>
-    {
-    public:
-        using connection_type = connection<SharedPointer>;
-        using connectable_type = connectable<SharedPointer>;
-
-        signal() = default;
-
-        signal(const signal&):
-            signal()
+        // The factory is only called if a connection may be called: nobody pays for arguments
+        // nobody listens to. Connections in suspended groups count as listening.
+        template<class Emitter, signal_arg... Args, class Factory>
+            requires payload_factory<Factory, typename signal<Args...>::slot>
+        void emit_lazy(this const Emitter& self,
+                       signal<Args...> Emitter::* emitted_signal,
+                       Factory&& factory)
         {
-            // Nothing on purpose
-        }
-
-        signal(signal&&) noexcept
-        {
-            // Nothing on purpose
-        }
+            const auto& emitting { static_cast<const emitter&>(self) };
+            if (emitting.suppress_emission())
+            {
+                return;
+            }
 
-        auto operator=(const signal&) -> signal&
-        {
-            // Nothing on purpose
-            return *this;
+            (self.*emitted_signal).follow_freezes(emitting.freezes());
+            (self.*emitted_signal).emit_lazy(std::forward<Factory>(factory));
         }
 
-        auto operator=(signal&&) noexcept -> signal&
+        // Emits the value only if it differs from the current one. Returns whether it did, even
+        // if the emission was blocked.
+        template<class Emitter, class T, class Equal>
+        auto set(this Emitter& self,
+                 property<T, Equal> Emitter::* changed_property,
+                 std::type_identity_t<T> value) -> bool
         {
-            // Nothing on purpose
-            return *this;
+            return (self.*changed_property)
+                .set(static_cast<const emitter&>(self), std::move(value));
         }
 
-        ~signal() = default;
-
-        using args = std::tuple<Args...>;
-
-        friend emitter;
-        using slot = std::function<void(Args...)>;
-
-        template<partially_callable<Args...> Callable, execution_policy Policy = synchronous_policy>
-        auto connect(Callable&& callable, Policy&& policy = {}) const -> connection<SharedPointer>;
-
-        template<partially_callable<Args...> Callable, execution_policy Policy = synchronous_policy>
-        auto connect_once(Callable&& callable, Policy&& policy = {}) const
-            -> connection<SharedPointer>;
-
-        template<partially_callable<Args...> Callable,
-                 guard_like Receiver,
+        template<class Receiver,
+                 signal_arg... ReceiverArgs,
+                 source_like Emitter,
                  execution_policy Policy = synchronous_policy>
-        auto connect(Callable&& callable, const Receiver& guard, Policy&& policy = {}) const
-            -> connection<SharedPointer>;
+            requires(partially_tuple_callable<typename signal<ReceiverArgs...>::slot,
+                                              typename std::remove_cvref_t<Emitter>::args>)
+        auto connect(this const Receiver& self,
+                     Emitter&& emitter,
+                     signal<ReceiverArgs...> Receiver::* receiver_signal,
+                     Policy&& policy = {}) ->
+            typename std::remove_cvref_t<Emitter>::connection_type;
 
-        template<partially_callable<Args...> Callable,
-                 guard_like Receiver,
+        template<class Receiver,
+                 signal_arg... ReceiverArgs,
+                 source_like Emitter,
                  execution_policy Policy = synchronous_policy>
-        auto connect_once(Callable&& callable, const Receiver& guard, Policy&& policy = {}) const
-            -> connection<SharedPointer>;
-
-        template<guard_like Receiver,
-                 class Result,
-                 execution_policy Policy = synchronous_policy,
-                 class... MemberFunctionArgs>
-            requires partially_callable<Result (Receiver::*)(MemberFunctionArgs...),
-                                        Receiver,
-                                        Args...>
-        auto connect(Result (Receiver::*callable)(MemberFunctionArgs...),
-                     Receiver& guard,
-                     Policy&& policy = {}) const -> connection<SharedPointer>;
-
-        template<guard_like Receiver,
-                 class Result,
-                 execution_policy Policy = synchronous_policy,
-                 class... MemberFunctionArgs>
-            requires partially_callable<Result (Receiver::*)(MemberFunctionArgs...),
-                                        Receiver,
-                                        Args...>
-        auto connect_once(Result (Receiver::*callable)(MemberFunctionArgs...),
-                          Receiver& guard,
-                          Policy&& policy = {}) const -> connection<SharedPointer>;
+            requires(partially_tuple_callable<typename signal<ReceiverArgs...>::slot,
+                                              typename std::remove_cvref_t<Emitter>::args>)
+        auto connect_once(this const Receiver& self,
+                          Emitter&& emitter,
+                          signal<ReceiverArgs...> Receiver::* receiver_signal,
+                          Policy&& policy = {}) ->
+            typename std::remove_cvref_t<Emitter>::connection_type;
 
-        template<guard_like Receiver,
-                 class Result,
-                 execution_policy Policy = synchronous_policy,
-                 class... MemberFunctionArgs>
-            requires partially_callable<Result (Receiver::*)(MemberFunctionArgs...) const,
-                                        const Receiver,
-                                        Args...>
-        auto connect(Result (Receiver::*callable)(MemberFunctionArgs...) const,
-                     const Receiver& guard,
-                     Policy&& policy = {}) const -> connection<SharedPointer>;
+        template<class Receiver, class Signal, execution_policy Policy = synchronous_policy>
+        auto forward_to(this const Receiver& self,
+                        Signal Receiver::* receiver_signal,
+                        Policy&& policy = {})
+            -> forward_result<Receiver, Signal Receiver::*, Policy>;
 
-        template<guard_like Receiver,
-                 class Result,
-                 execution_policy Policy = synchronous_policy,
-                 class... MemberFunctionArgs>
-            requires partially_callable<Result (Receiver::*)(MemberFunctionArgs...) const,
-                                        const Receiver,
-                                        Args...>
-        auto connect_once(Result (Receiver::*callable)(MemberFunctionArgs...) const,
-                          const Receiver& guard,
-                          Policy&& policy = {}) const -> connection<SharedPointer>;
+        template<class Receiver, class Signal, execution_policy Policy = synchronous_policy>
+        auto forward_once_to(this const Receiver& self,
+                             Signal Receiver::* receiver_signal,
+                             Policy&& policy = {})
+            -> forward_result<Receiver, Signal Receiver::*, Policy>;
 
     private:
-        template<partially_callable<Args...> Callable, execution_policy Policy>
-        auto connect_impl(Callable&& callable, Policy&& policy, bool connect_once) const
-            -> connection<SharedPointer>;
-
-        template<partially_callable<Args...> Callable, guard_like Receiver, execution_policy Policy>
-        auto connect_with_guard(Callable&& callable,
-                                const Receiver& guard,
-                                Policy&& policy,
-                                bool connect_once) const -> connection<SharedPointer>;
+        template<class Receiver, details::signal_arg... ReceiverArgs>
+        auto forwarding_lambda(this const Receiver& self,
+                               signal<ReceiverArgs...> Receiver::* receiver_signal);
 
-        template<guard_like Receiver, class MemberFunction>
-            requires partially_callable<MemberFunction, Receiver, Args...>
-        static auto member_function_lambda(MemberFunction member_function, Receiver& guard)
+        // Queued by forwarding_lambda, when forwarding from a forwarded emission.
+        template<class Receiver, signal_arg... ReceiverArgs>
+            requires(deferrable_arg<ReceiverArgs> && ...)
+        class forwarded_emission final: public forwarding_queue::emission
         {
-            return [&guard, member_function]<class... CallArgs>(CallArgs&&... args) mutable
-            { partial_call(member_function, guard, std::forward<CallArgs>(args)...); };
-        }
+        public:
+            template<class... CallArgs>
+            forwarded_emission(object_pool<forwarded_emission>& pool,
+                               const Receiver& receiver,
+                               signal<ReceiverArgs...> Receiver::* receiver_signal,
+                               CallArgs&&... call_args):
+                forwarding_queue::emission { &(receiver.*receiver_signal) },
+                m_pool { pool },
+                m_receiver { receiver },
+                m_receiver_signal { receiver_signal },
+                m_args { std::forward<CallArgs>(call_args)... }
+            {
+            }
 
-        template<class... EmittedArgs>
-            requires std::invocable<slot, EmittedArgs&&...>
-        void emit(EmittedArgs&&... emitted_args) const
-        {
-            auto slots { copy_slots() };
+            void run() override
+            {
+                try
+                {
+                    std::apply(
+                        [this]<class... StoredArgs>(StoredArgs&&... stored_args)
+                    {
+                        m_receiver.emit(m_receiver_signal,
+                                        std::forward<StoredArgs>(stored_args)...);
+                    },
+                        std::move(m_args));
+                }
+                catch (...)
+                {
+                    m_pool.release(*this);
+                    throw;
+                }
 
-            if (slots->empty())
+                m_pool.release(*this);
+            }
+
+            void discard() override
             {
-                return;
+                m_pool.release(*this);
             }
 
-            auto begin { slots->begin() };
-            auto previous_to_end { std::prev(slots->end()) };
+        private:
+            // It might be bad, but this is done on purpose.
+            // NOLINTNEXTLINE(cppcoreguidelines-avoid-const-or-ref-data-members)
+            object_pool<forwarded_emission>& m_pool;
+            // It might be bad, but this is done on purpose.
+            // NOLINTNEXTLINE(cppcoreguidelines-avoid-const-or-ref-data-members)
+            const Receiver& m_receiver;
+            signal<ReceiverArgs...> Receiver::* m_receiver_signal;
+            std::tuple<std::decay_t<ReceiverArgs>...> m_args;
+        };
 
-            for (auto it { begin }; it != previous_to_end; ++it)
+        // Counts the emission if it must be dropped.
+        auto suppress_emission() const -> bool
+        {
+            if (m_blocked.load(std::memory_order_relaxed) == 0)
             {
-                (**it)(emitted_args...);
+                return false;
             }
 
-            (*slots->back())(std::forward<EmittedArgs>(emitted_args)...);
+            m_suppressed_emissions.fetch_add(1, std::memory_order_relaxed);
+            return true;
         }
 
-        class connection_holder_implementation;
-
-        using slot_list = std::vector<SharedPointer<connection_holder_implementation>>;
-
-        auto copy_slots() const -> SharedPointer<slot_list>
+        auto freezes() const -> std::uint32_t
         {
-            std::lock_guard lock { m_mutex };
-            return m_slots;
+            return m_freezes.load(std::memory_order_relaxed);
         }
 
-        void disconnect(connection_holder_implementation* holder) const
-        {
-            std::lock_guard lock { m_mutex };
-            SharedPointer<slot_list> slots { new slot_list() };
-
-            slots->reserve(m_slots->size());
-            std::ranges::copy_if(*m_slots, std::back_inserter(*slots), [holder](const auto& slot) {
-                return slot.get() != holder;
-            });
+        std::atomic<std::uint32_t> m_blocked { 0 };
+        mutable std::atomic<std::size_t> m_suppressed_emissions { 0 };
+        // Counts the calls to freeze_all, which signals compare with the last one they followed.
+        std::atomic<std::uint32_t> m_freezes { 0 };
+    };
 
-            std::swap(slots, m_slots);
-        }
+    template<class Appliable, class Source>
+    concept appliable = requires(const Source& source, Appliable appliable) {
+        ::source_like<Source>;
+        { appliable.accept(source) } -> ::source_like;
+    };
 
-        mutable SharedPointer<slot_list> m_slots { SharedPointer<slot_list>(new slot_list()) };
-        mutable Mutex m_mutex;
+    template<class EmitterLike>
+    concept emitter_like = requires(EmitterLike emitter_instance) {
+        []<basic_lockable Mutex, template<class> class SharedPointer>(
+            const emitter<Mutex, SharedPointer>&)
+            requires shared_pointer_like<SharedPointer> {}(emitter_instance);
     };
 
-    template<std::derived_from<chainable> Chainable,
-             class Callable,
-             class Guard,
-             execution_policy Policy>
-        requires(std::same_as<void, Guard> || guard_like<Guard>)
-    class chain
+    template<class SignalLike, class Emitter>
+    concept signal_like = requires(SignalLike signal_instance) {
+        requires emitter_like<Emitter>;
+        []<signal_arg... Args>(const typename Emitter::template signal<Args...>&) {}(
+            signal_instance);
+    };
+
+    class connection_holder;
+
+    // ### Class source
+    template<template<class> class SharedPointer>
+        requires shared_pointer_like<SharedPointer>
+    class source
     {
     public:
-        chain(Chainable&& chainable, const connect<Callable, Guard, Policy>& connect):
-            m_chainable { std::forward<Chainable>(chainable) },
-            m_connect { std::move(connect) }
+        using connection_type = connection<SharedPointer>;
+
+        template<::source_like Self, appliable<Self> Appliable>
+        auto apply(this Self&& self, Appliable&& appliable)
         {
+            return std::forward<Appliable>(appliable).accept(std::forward<Self>(self));
         }
 
-        template<source_like Source>
-        friend auto operator|(Source&& source, chain& chain)
+        template<::source_like Self, appliable<Self> Appliable>
+        auto operator|(this Self&& self, Appliable&& appliable)
         {
-            return std::forward<Source>(source) | chain.m_chainable | chain.m_connect;
+            return std::forward<Self>(self).apply(std::forward<Appliable>(appliable));
         }
 
-    private:
-        std::remove_cvref_t<Chainable> m_chainable;
-        connect<Callable, Guard, Policy> m_connect;
-    };
+        template<::source_like Self, class Callable, class Guard, execution_policy Policy>
+            requires(callable_with_no_guard<Self, Callable, Guard> ||
+                     callable_with_guard<Self, Callable, Guard> ||
+                     method_with_guard<Self, Callable, Guard>)
+        auto operator|(this Self&& self, connect<Callable, Guard, Policy>& connect)
+        {
+            return connect.create_connection(std::forward<Self>(self));
+        }
 
-    template<std::derived_from<chainable> Chainable,
-             class Receiver,
-             signal_like<Receiver> Signal,
-             details::execution_policy Policy>
-    class chain<Chainable, Signal Receiver::*, void, Policy>
-    {
-    public:
-        chain(Chainable&& chainable,
-              const forward_result<Receiver, Signal Receiver::*, Policy>& connect_result):
-            m_chainable { std::forward<Chainable>(chainable) },
-            m_connect_result { std::move(connect_result) }
+        template<::source_like Self, class Callable, class Guard, execution_policy Policy>
+            requires(callable_with_no_guard<Self, Callable, Guard> ||
+                     callable_with_guard<Self, Callable, Guard> ||
+                     method_with_guard<Self, Callable, Guard>)
+        auto operator|(this Self&& self, connect<Callable, Guard, Policy>&& connect)
         {
+            return std::move(connect).create_connection(std::forward<Self>(self));
         }
 
-        template<source_like Source>
-        friend auto operator|(Source&& source, chain& chain)
+        template<::source_like Self,
+                 class Receiver,
+                 signal_like<Receiver> Signal,
+                 execution_policy Policy>
+            requires partially_tuple_callable<typename Signal::slot,
+                                              typename std::remove_cvref_t<Self>::args>
+        auto operator|(
+            this Self&& self,
+            details::template forward_result<Receiver, Signal Receiver::*, Policy>& connect_result)
         {
-            return std::forward<Source>(source) | chain.m_chainable | chain.m_connect_result;
+            return connect_result.create_connection(std::forward<Self>(self));
         }
 
-    private:
-        std::remove_cvref_t<Chainable> m_chainable;
-        forward_result<Receiver, Signal Receiver::*, Policy> m_connect_result;
+        template<::source_like Self,
+                 class Receiver,
+                 signal_like<Receiver> Signal,
+                 execution_policy Policy>
+            requires partially_tuple_callable<typename Signal::slot,
+                                              typename std::remove_cvref_t<Self>::args>
+        auto operator|(
+            this Self&& self,
+            details::template forward_result<Receiver, Signal Receiver::*, Policy>&& connect_result)
+        {
+            return std::move(connect_result).create_connection(std::forward<Self>(self));
+        }
     };
 
-} // namespace details
+    // A slot on its way to the connection it replaces the slot of.
+    class slot_binding
+    {
+    public:
+        slot_binding(const slot_binding&) = delete;
+        slot_binding(slot_binding&&) = delete;
 
-class chainable
-{
-public:
-    template<class Self, std::derived_from<chainable> OtherChainable>
-    auto operator|(this Self&& self, OtherChainable&& other);
+        auto operator=(const slot_binding&) -> slot_binding& = delete;
+        auto operator=(slot_binding&&) -> slot_binding& = delete;
 
-    template<class Self, class Callable, class Guard, details::execution_policy Policy>
-        requires(std::same_as<void, Guard> || guard_like<Guard>)
-    auto operator|(this Self&& self, const connect<Callable, Guard, Policy>& connect)
-        -> details::chain<Self, Callable, Guard, Policy>
-    {
-        return { std::forward<Self>(self), connect };
-    }
+        virtual auto signature() const -> const void* = 0;
 
-    template<class Self,
-             class Receiver,
-             details::signal_like<Receiver> Signal,
-             details::execution_policy Policy>
-    auto operator|(
-        this Self&& self,
-        const details::forward_result<Receiver, Signal Receiver::*, Policy>& connect_result)
-        -> details::chain<Self, Signal Receiver::*, void, Policy>
-    {
-        return { std::forward<Self>(self), connect_result };
-    }
-};
+    protected:
+        slot_binding() = default;
+        ~slot_binding() = default;
+    };
 
-namespace details
-{
-    template<std::derived_from<chainable> Lhs, std::derived_from<chainable> Rhs>
-    class composed_chainable: public chainable
+    template<template<class> class SharedPointer, class... Args>
+    class typed_slot_binding final: public slot_binding
     {
     public:
-        composed_chainable(Lhs&& lhs, Rhs&& rhs):
-            m_lhs { std::forward<Lhs>(lhs) },
-            m_rhs { std::forward<Rhs>(rhs) }
+        template<partially_callable<Args...> Callable>
+        explicit typed_slot_binding(Callable&& callable):
+            m_slot { new slot_implementation<std::decay_t<Callable>, Args...>(
+                std::forward<Callable>(callable)) }
         {
         }
 
-        template<source_like Source>
-        friend auto operator|(Source&& source, composed_chainable& composed_chainable)
+        auto signature() const -> const void* override
         {
-            return (std::forward<Source>(source) | composed_chainable.m_lhs) |
-                   composed_chainable.m_rhs;
+            return &slot_signature<Args...>::id;
+        }
+
+        auto take_slot() -> SharedPointer<slot_interface<Args...>>
+        {
+            return std::move(m_slot);
         }
 
     private:
-        Lhs m_lhs;
-        Rhs m_rhs;
+        SharedPointer<slot_interface<Args...>> m_slot;
     };
-} // namespace details
-
-template<class Self, std::derived_from<chainable> OtherChainable>
-auto chainable::operator|(this Self&& self, OtherChainable&& other)
-{
-    return details::composed_chainable { std::forward<Self>(self),
-                                         std::forward<OtherChainable>(other) };
-}
-
-// ### class map
 
-namespace details
-{
-    template<class Source, std::size_t... Indexes>
-    concept valid_map = requires {
-        ::source_like<Source>;
-        (in_tuple_range<Indexes, typename std::remove_cvref_t<Source>::args> && ...);
-        all_different<Indexes...>;
+    // Shared by a connection group and the connections that joined it.
+    struct group_state
+    {
+        std::atomic<bool> suspended { false };
     };
 
-    template<::source_like Source, std::size_t... Indexes>
-        requires(valid_map<Source, Indexes...>)
-    class mapped_source: public std::remove_cvref_t<Source>::connectable_type
+    // A group on its way to a connection joining it. Connections only join groups of the same
+    // shared pointer, so the binding is always a typed_group_binding of theirs.
+    class group_binding
     {
     public:
-        friend std::remove_cvref_t<Source>::connectable_type;
+        group_binding(const group_binding&) = delete;
+        group_binding(group_binding&&) = delete;
 
-        using args = std::tuple<
-            std::tuple_element_t<Indexes, typename std::remove_cvref_t<Source>::args>...>;
+        auto operator=(const group_binding&) -> group_binding& = delete;
+        auto operator=(group_binding&&) -> group_binding& = delete;
 
-        explicit mapped_source(Source&& origin):
-            m_source { std::forward<Source>(origin) }
+    protected:
+        group_binding() = default;
+        ~group_binding() = default;
+    };
+
+    template<template<class> class SharedPointer>
+    class typed_group_binding final: public group_binding
+    {
+    public:
+        explicit typed_group_binding(SharedPointer<group_state> state):
+            m_state { std::move(state) }
         {
         }
 
-    private:
-        template<partially_callable<
-            std::tuple_element_t<Indexes, typename std::remove_cvref_t<Source>::args>...> Callable>
-        auto forwarding_lambda(Callable&& callable) const
+        auto state() const -> const SharedPointer<group_state>&
         {
-            return
-                // Clang-tidy doesn't seem to understand template parameter pack indexing.
-                // NOLINTNEXTLINE(cppcoreguidelines-missing-std-forward)
-                [callable = std::forward<Callable>(callable)]<class... Args>(Args&&... args) mutable
-            {
-                partial_call(callable,
-                             std::forward<decltype(args...[Indexes])>(args...[Indexes])...);
-            };
+            return m_state;
         }
 
-        Source m_source;
+    private:
+        SharedPointer<group_state> m_state;
     };
-} // namespace details
 
-template<std::size_t... Indexes>
-    requires details::all_different<Indexes...>
-class map: public chainable
-{
-public:
-    template<source_like Source>
-    auto accept(Source&& origin) -> details::mapped_source<Source, Indexes...>
+    class connection_holder
     {
-        return details::mapped_source<Source, Indexes...> { std::forward<Source>(origin) };
-    }
-};
+    public:
+        using exception_handler = std::function<void(std::exception_ptr)>;
 
-// ### class transform
+        virtual ~connection_holder() = default;
+        virtual void add_exception_handler(connection_holder::exception_handler handler) = 0;
 
-namespace details
-{
-    template<class Source, class... Transformations>
-    concept valid_transformations = requires(Transformations... transformations,
-                                             typename std::remove_cvref_t<Source>::args args) {
-        ::source_like<Source>;
-        [transformations,
-         args]<std::size_t... Indexes>(const std::index_sequence<Indexes...>&) constexpr
-            requires(
-                (std::invocable<
-                     Transformations...[Indexes],
-                     std::tuple_element_t<Indexes, typename std::remove_cvref_t<Source>::args>> &&
-                 ...) &&
-                (not_void<std::invoke_result_t<
-                     Transformations...[Indexes],
-                     std::tuple_element_t<Indexes, typename std::remove_cvref_t<Source>::args>>> &&
-                 ...)) {}(std::make_index_sequence<sizeof...(Transformations)> {});
+        virtual void disconnect() = 0;
+        virtual void suspend() = 0;
+        virtual void resume() = 0;
+        // Ends the connection like a fired single shot connection.
+        virtual void expire() = 0;
+        // Returns false if the connection was disconnected.
+        virtual auto rebind(slot_binding& binding) -> bool = 0;
+        virtual void join(group_binding& binding) = 0;
+        // Disconnects, but leaves the removal to the signal, which does it in batches like for
+        // fired connections.
+        virtual void retire() = 0;
     };
 
-    template<class Tuple, class... Transformations>
-    struct transformed_source_args;
-
-    template<class Tuple, class... Transformations>
-    using transformed_source_args_t = transformed_source_args<Tuple, Transformations...>::type;
-
-    template<class... Args, class... Transformations>
-    struct transformed_source_args<std::tuple<Args...>, Transformations...>
+    // Identifies a connection in the registry of its shared pointer. The generation tells
+    // whether the entry still holds the connection the handle was made for.
+    struct connection_handle
     {
-        using type = std::tuple<std::invoke_result_t<Transformations, Args>...>;
+        std::uint32_t index;
+        std::uint32_t generation;
     };
 
-    template<::source_like Source, class... Transformations>
-        requires(valid_transformations<Source, Transformations...>)
-    class transformed_source: public std::remove_cvref_t<Source>::connectable_type
+    // Connections, by index, whichever their signal: handles stay meaningful after their signal
+    // is gone. Using a connection through its handle pins its entry, in the same word as the
+    // generation. Once the last owner drops the connection, the generation moves on, and the
+    // connection is disposed of by whoever unpins it last, or right away if nobody pinned it.
+    // Entries are then reused with the new generation, until it saturates, and are never freed.
+    template<template<class> class SharedPointer>
+    class connection_registry
     {
     public:
-        friend std::remove_cvref_t<Source>::connectable_type;
+        // Destroys the connection, and gives its memory back to where it came from.
+        using dispose_function = void (*)(connection_holder& holder, void* context);
 
-        using args = transformed_source_args_t<typename std::remove_cvref_t<Source>::args,
-                                               Transformations...>;
-
-        transformed_source(Source&& origin, std::tuple<Transformations...> transformations):
-            m_source { std::forward<Source>(origin) },
-            m_transformations { std::move(transformations) }
+        static auto add(connection_holder& holder, void* context, dispose_function dispose)
+            -> connection_handle
         {
+            const auto index { take_index() };
+            auto& added { at(index) };
+            added.context = context;
+            added.dispose = dispose;
+            added.holder.store(&holder, std::memory_order_release);
+            return { index, generation_of(added.word.load(std::memory_order_relaxed)) };
         }
 
-    private:
-        template<partially_tuple_callable<args> Callable>
-        auto forwarding_lambda(Callable&& callable) const
+        // Returns nullptr if the connection is gone. Otherwise, it is not disposed of until
+        // unpinned.
+        static auto pin(connection_handle handle) -> connection_holder*
         {
-            return [callable = std::forward<Callable>(callable),
-                    transformations = m_transformations]<class... Args>(Args&&... args) mutable
+            auto& pinned { at(handle.index) };
+            auto word { pinned.word.load(std::memory_order_relaxed) };
+            do
             {
-                auto& [... transformationsCallable] { transformations };
-                return partial_call(callable, transformationsCallable(std::forward<Args>(args))...);
-            };
+                if (generation_of(word) != handle.generation)
+                {
+                    return nullptr;
+                }
+            } while (!pinned.word.compare_exchange_weak(word,
+                                                        word + 1,
+                                                        std::memory_order_acquire,
+                                                        std::memory_order_relaxed));
+
+            return pinned.holder.load(std::memory_order_acquire);
         }
 
-        Source m_source;
-        std::tuple<Transformations...> m_transformations;
-    };
+        static void unpin(connection_handle handle)
+        {
+            auto& unpinned { at(handle.index) };
+            const auto word { unpinned.word.fetch_sub(1, std::memory_order_acq_rel) };
+            if (generation_of(word) != handle.generation && (word & pin_mask) == 1)
+            {
+                dispose_of(unpinned, generation_of(word));
+            }
+        }
 
-    template<class Source, class... Transformations>
-    transformed_source(Source&&, std::tuple<Transformations...>)
-        -> transformed_source<Source, Transformations...>;
-} // namespace details
-
-template<class... Transformations>
-class transform: public chainable
-{
-private:
-    template<std::size_t>
-    using identity = std::identity;
-
-public:
-    explicit transform(Transformations... transformations):
-        m_transformations { std::forward<Transformations>(transformations)... }
-    {
-    }
+        // Compares without pinning, as the connection isn't used.
+        static auto holds(connection_handle handle, const connection_holder* holder) -> bool
+        {
+            auto& found { at(handle.index) };
+            return found.holder.load(std::memory_order_acquire) == holder &&
+                   generation_of(found.word.load(std::memory_order_acquire)) == handle.generation;
+        }
 
-    template<source_like Source>
-    auto accept(Source&& origin)
-    {
-        static constexpr std::make_index_sequence<
-            std::tuple_size_v<typename std::remove_cvref_t<Source>::args> -
-            sizeof...(Transformations)>
-            index_sequence {};
+        // Pins the connection of a handle for its lifetime, if the connection is still there.
+        class pinned
+        {
+        public:
+            explicit pinned(connection_handle handle):
+                m_handle { handle },
+                m_holder { pin(handle) }
+            {
+            }
 
-        auto [... identities] { create_identities(index_sequence) };
-        auto& [... transformations] { m_transformations };
+            pinned(const pinned&) = delete;
+            pinned(pinned&&) = delete;
 
-        return details::transformed_source { std::forward<Source>(origin),
-                                             std::make_tuple(transformations..., identities...) };
-    }
+            auto operator=(const pinned&) -> pinned& = delete;
+            auto operator=(pinned&&) -> pinned& = delete;
 
-private:
-    template<std::size_t... Indexes>
-    static constexpr auto create_identities(const std::index_sequence<Indexes...>&)
-    {
-        return std::make_tuple(identity<Indexes> {}...);
-    }
+            ~pinned()
+            {
+                if (m_holder != nullptr)
+                {
+                    unpin(m_handle);
+                }
+            }
 
-    std::tuple<Transformations...> m_transformations;
-};
+            auto get() const -> connection_holder*
+            {
+                return m_holder;
+            }
 
-// ### class filter
+        private:
+            connection_handle m_handle;
+            connection_holder* m_holder;
+        };
 
-namespace details
-{
-    template<class Source, class Filter>
-    concept valid_filter = requires {
-        ::source_like<Source>;
-        partially_tuple_callable<Filter, typename std::remove_cvref_t<Source>::args>;
-        std::convertible_to<decltype(partial_tuple_call(
-                                std::declval<Filter>(),
-                                std::declval<typename std::remove_cvref_t<Source>::args>())),
-                            bool>;
-    };
+        // Called once the last owner dropped the connection.
+        static void remove(connection_handle handle)
+        {
+            auto& removed { at(handle.index) };
+            const auto word { removed.word.fetch_add(generation_one, std::memory_order_acq_rel) };
+            if ((word & pin_mask) == 0)
+            {
+                dispose_of(removed, handle.generation + 1);
+            }
+        }
 
-    template<::source_like Source,
-             partially_tuple_callable<typename std::remove_cvref_t<Source>::args> Filter>
-        requires valid_filter<Source, Filter>
-    class filtered_source: public std::remove_cvref_t<Source>::connectable_type
-    {
-    public:
-        friend std::remove_cvref_t<Source>::connectable_type;
+    private:
+        struct entry
+        {
+            // It might be bad, but this is done on purpose.
+            // NOLINTBEGIN(misc-non-private-member-variables-in-classes)
+            // The generation in the upper half, the count of pins in the lower one.
+            std::atomic<std::uint64_t> word { 0 };
+            std::atomic<connection_holder*> holder { nullptr };
+            void* context { nullptr };
+            dispose_function dispose { nullptr };
+            std::uint32_t index { 0 };
+            // Index of the next free entry, plus one.
+            std::atomic<std::uint32_t> next_free { 0 };
+            // NOLINTEND(misc-non-private-member-variables-in-classes)
+        };
 
-        using args = typename std::remove_cvref_t<Source>::args;
+        static constexpr std::uint64_t generation_one { std::uint64_t { 1 } << 32U };
+        static constexpr std::uint64_t pin_mask { generation_one - 1 };
+        // Entries reaching it are no longer reused, so that no handle ever gets it, and stale
+        // handles never designate another connection.
+        static constexpr std::uint32_t saturated_generation {
+            std::numeric_limits<std::uint32_t>::max()
+        };
 
-        filtered_source(Source&& origin, Filter filter):
-            m_source { std::forward<Source>(origin) },
-            m_filter { std::move(filter) }
+        static constexpr auto generation_of(std::uint64_t word) -> std::uint32_t
         {
+            return static_cast<std::uint32_t>(word >> 32U);
         }
 
-    private:
-        template<partially_tuple_callable<args> Callable>
-        auto forwarding_lambda(Callable&& callable) const
+        static void dispose_of(entry& disposed, std::uint32_t generation)
         {
-            return [callable = std::forward<Callable>(callable),
-                    filter = m_filter]<class... Args>(Args&&... args) mutable
+            auto* holder { disposed.holder.exchange(nullptr, std::memory_order_acq_rel) };
+            disposed.dispose(*holder, disposed.context);
+            if (generation != saturated_generation)
             {
-                if (static_cast<bool>(partial_call(filter, args...)))
-                {
-                    partial_call(callable, std::forward<Args>(args)...);
-                }
-            };
+                give_back_index(disposed.index);
+            }
         }
 
-        Source m_source;
-        Filter m_filter;
-    };
-} // namespace details
-
-template<class Filter>
-class filter: public chainable
-{
-public:
-    explicit filter(Filter filter):
-        m_filter { std::move(filter) }
-    {
-    }
-
-    template<source_like Source>
-    auto accept(Source&& origin) -> details::filtered_source<Source, Filter>
-    {
-        return { std::forward<Source>(origin), m_filter };
-    }
-
-private:
-    Filter m_filter;
-};
-
-// ### connection_holder_implementation class
-
-namespace details
-{
-
-    template<basic_lockable Mutex, template<class> class SharedPointer>
-        requires shared_pointer_like<SharedPointer>
-    template<signal_arg... Args>
-    class emitter<Mutex, SharedPointer>::signal<Args...>::connection_holder_implementation final
-        : public connection_holder
-    {
-        template<class T>
-        using ref_or_value = std::conditional_t<std::is_lvalue_reference_v<T>,
-                                                std::reference_wrapper<std::remove_reference_t<T>>,
-                                                T>;
+        // Chunks double in size, so that entries never move and indices stay on 32 bits.
+        static constexpr std::size_t first_chunk_size { 64 };
+        static constexpr std::size_t chunk_count { 26 };
 
-    public:
-        template<partially_callable<Args...> Callable, execution_policy Policy>
-        connection_holder_implementation(const signal& connected_signal,
-                                         Callable&& callable,
-                                         Policy&& policy,
-                                         bool single_shot = false):
-            m_slot { generate_slot(std::forward<Callable>(callable)) },
-            m_signal { connected_signal },
-            m_policy(std::forward<Policy>(policy)),
-            m_single_shot { single_shot }
+        static auto chunk_of(std::uint32_t index) -> std::size_t
         {
+            return static_cast<std::size_t>(std::bit_width((index / first_chunk_size) + 1)) - 1;
         }
 
-        template<partially_callable<Args...> Callable, execution_policy Policy>
-        connection_holder_implementation(const signal& connected_signal,
-                                         Callable&& callable,
-                                         Policy&& policy,
-                                         guard<Mutex, SharedPointer>& guard,
-                                         bool single_shot = false):
-            connection_holder_implementation(connected_signal,
-                                             std::forward<Callable>(callable),
-                                             std::forward<Policy>(policy),
-                                             single_shot),
-            m_guard { &guard }
+        static auto at(std::uint32_t index) -> entry&
         {
+            const auto chunk { chunk_of(index) };
+            const auto offset { index - (first_chunk_size * ((std::size_t { 1 } << chunk) - 1)) };
+            return s_chunks[chunk].load(std::memory_order_acquire)[offset];
         }
 
-        template<class... EmittedArgs>
-            requires std::invocable<signal::slot, EmittedArgs...>
-        void operator()(EmittedArgs&&... args)
+        // The free list head packs the index of the first free entry, plus one, with a tag that
+        // changes on each pop, so that popping can't suffer from ABA.
+        static auto take_index() -> std::uint32_t
         {
-            if (m_suspended.load(std::memory_order_relaxed))
-            {
-                return;
-            }
-            if (m_single_shot)
+            auto head { s_free.load(std::memory_order_acquire) };
+            while (static_cast<std::uint32_t>(head) != 0)
             {
-                disconnect();
+                const auto index { static_cast<std::uint32_t>(head) - 1 };
+                const auto next { at(index).next_free.load(std::memory_order_relaxed) };
+                const auto tag { (head >> 32U) + 1 };
+                if (s_free.compare_exchange_weak(head,
+                                                 (tag << 32U) | next,
+                                                 std::memory_order_acquire,
+                                                 std::memory_order_acquire))
+                {
+                    return index;
+                }
             }
 
-            auto exception_handlers { copy_exception_handlers() };
-            if (m_policy.is_synchronous())
-            {
-                m_policy.execute([&]
-                { safe_execute(m_slot, exception_handlers, std::forward<EmittedArgs>(args)...); });
-            }
-            else
-            {
-                m_policy.execute(
-                    [exception_handlers = std::move(exception_handlers),
-                     slot = m_slot,
-                     ... args = ref_or_value<Args>(std::forward<EmittedArgs>(args))] mutable
-                { safe_execute(slot, exception_handlers, std::forward<decltype(args)>(args)...); });
-            }
+            const auto index { s_size.fetch_add(1, std::memory_order_relaxed) };
+            allocate_chunk_of(index);
+            at(index).index = index;
+            return index;
         }
 
-        template<class... ExecuteArgs>
-        static void safe_execute(signal<Args...>::slot& slot,
-                                 std::vector<exception_handler>& exception_handlers,
-                                 ExecuteArgs&&... execute_args)
+        static void give_back_index(std::uint32_t index)
         {
-            try
-            {
-                slot(std::forward<ExecuteArgs>(execute_args)...);
-            }
-            catch (...)
+            auto head { s_free.load(std::memory_order_relaxed) };
+            do
             {
-                if (exception_handlers.empty())
-                {
-                    throw;
-                }
-                auto current_exception { std::current_exception() };
-                for (auto& handler: exception_handlers)
-                {
-                    // Exception handlers shouldn't throw. If they do, that's not on us.
-                    handler(current_exception);
-                }
-            }
+                at(index).next_free.store(static_cast<std::uint32_t>(head),
+                                          std::memory_order_relaxed);
+            } while (!s_free.compare_exchange_weak(head,
+                                                   (head & ~0xFFFF'FFFFULL) | (index + 1),
+                                                   std::memory_order_release,
+                                                   std::memory_order_relaxed));
         }
 
-        void disconnect() override
+        static void allocate_chunk_of(std::uint32_t index)
         {
-            m_signal.disconnect(this);
-            if (m_guard != nullptr)
+            const auto chunk { chunk_of(index) };
+            if (s_chunks[chunk].load(std::memory_order_acquire) != nullptr)
             {
-                guard<Mutex, SharedPointer>* guard { nullptr };
-                std::swap(guard, m_guard);
-                guard->clean(this);
+                return;
+            }
+
+            auto* allocated { new entry[first_chunk_size << chunk] };
+            entry* expected { nullptr };
+            if (!s_chunks[chunk].compare_exchange_strong(expected,
+                                                         allocated,
+                                                         std::memory_order_acq_rel,
+                                                         std::memory_order_acquire))
+            {
+                // Another thread allocated it first.
+                delete[] allocated;
             }
         }
 
-        void suspend() override
+        static inline std::array<std::atomic<entry*>, chunk_count> s_chunks {};
+        static inline std::atomic<std::uint64_t> s_free { 0 };
+        static inline std::atomic<std::uint32_t> s_size { 0 };
+    };
+
+    // Marks the connection whose slot runs on this thread, nested calls included, so that the
+    // slots of lifetime limited sources can end it.
+    class running_connection
+    {
+    public:
+        explicit running_connection(connection_holder& holder):
+            m_previous { std::exchange(s_current, &holder) }
         {
-            m_suspended.store(true, std::memory_order_relaxed);
         }
 
-        void resume() override
+        running_connection(const running_connection&) = delete;
+        running_connection(running_connection&&) = delete;
+
+        auto operator=(const running_connection&) -> running_connection& = delete;
+        auto operator=(running_connection&&) -> running_connection& = delete;
+
+        ~running_connection()
         {
-            m_suspended.store(false, std::memory_order_relaxed);
+            s_current = m_previous;
         }
 
-        void add_exception_handler(connection_holder::exception_handler handler) override
+        // The signal removes the expired connection in batches, away from emission.
+        static void expire()
         {
-            std::lock_guard lock { m_mutex };
-            m_exception_handlers.emplace_back(std::move(handler));
+            if (s_current != nullptr)
+            {
+                s_current->expire();
+            }
         }
 
     private:
-        auto copy_exception_handlers() const -> std::vector<exception_handler>
-        {
-            std::lock_guard lock { m_mutex };
+        connection_holder* m_previous;
 
-            return m_exception_handlers;
-        }
+        static inline thread_local connection_holder* s_current { nullptr };
+    };
 
-        template<partially_callable<Args...> Callable>
-        static auto generate_slot(Callable&& callable)
-        {
-            return [callable = std::forward<Callable>(callable)](Args&&... args) mutable
-            { partial_call(callable, std::forward<Args>(args)...); };
-        }
+    // Told whenever an observed signal gets its first connection, or loses its last one. The
+    // count may have changed again by the time it is told, so it must read it again.
+    class connection_observer
+    {
+    public:
+        connection_observer(const connection_observer&) = delete;
+        connection_observer(connection_observer&&) = delete;
 
-        signal::slot m_slot;
-        std::vector<exception_handler> m_exception_handlers;
-        mutable Mutex m_mutex;
-        // It might be bad, but this is done on purpose.
-        // NOLINTNEXTLINE(cppcoreguidelines-avoid-const-or-ref-data-members)
-        const signal& m_signal;
-        guard<Mutex, SharedPointer>* m_guard { nullptr };
-        execution_policy_holder m_policy;
-        std::atomic<bool> m_suspended { false };
-        bool m_single_shot;
+        auto operator=(const connection_observer&) -> connection_observer& = delete;
+        auto operator=(connection_observer&&) -> connection_observer& = delete;
+
+        virtual void connections_changed() = 0;
+
+    protected:
+        connection_observer() = default;
+        ~connection_observer() = default;
     };
 
-    // ### emitter implementation
+    // Owns a signal for whatever erases it once unused, such as the index of a key. Connections
+    // to the signal keep its owner, so that it outlives whatever they are doing to it. Always
+    // shared as a pointer to this class, which destroys it.
+    class signal_owner
+    {
+    public:
+        signal_owner(const signal_owner&) = delete;
+        signal_owner(signal_owner&&) = delete;
+
+        auto operator=(const signal_owner&) -> signal_owner& = delete;
+        auto operator=(signal_owner&&) -> signal_owner& = delete;
+
+        virtual ~signal_owner() = default;
+
+    protected:
+        signal_owner() = default;
+    };
 
     template<basic_lockable Mutex, template<class> class SharedPointer>
         requires shared_pointer_like<SharedPointer>
-    template<class Receiver,
-             signal_arg... ReceiverArgs,
-             source_like Emitter,
-             execution_policy Policy>
-        requires(partially_tuple_callable<
-                 typename emitter<Mutex, SharedPointer>::template signal<ReceiverArgs...>::slot,
-                 typename std::remove_cvref_t<Emitter>::args>)
-    auto emitter<Mutex, SharedPointer>::connect(
-        this const Receiver& self,
-        Emitter&& emitter,
-        ::details::emitter<Mutex, SharedPointer>::template signal<ReceiverArgs...> Receiver::*
-            receiver_signal,
-        Policy&& policy) -> typename std::remove_cvref_t<Emitter>::connection_type
+    template<class Receiver, class Signal, execution_policy Policy>
+    auto emitter<Mutex, SharedPointer>::forward_to(this const Receiver& self,
+                                                   Signal Receiver::* receiver_signal,
+                                                   Policy&& policy)
+        -> forward_result<Receiver, Signal Receiver::*, Policy>
     {
-        auto connection { std::forward<Emitter>(emitter).connect(
-            self.forwarding_lambda(receiver_signal),
-            std::forward<Policy>(policy)) };
-        (self.*receiver_signal).add_emitting_source(connection);
-        return connection;
+        return { self, receiver_signal, std::forward<Policy>(policy), false };
     }
 
     template<basic_lockable Mutex, template<class> class SharedPointer>
         requires shared_pointer_like<SharedPointer>
-    template<class Receiver,
-             signal_arg... ReceiverArgs,
-             source_like Emitter,
-             execution_policy Policy>
-        requires(partially_tuple_callable<
-                 typename emitter<Mutex, SharedPointer>::template signal<ReceiverArgs...>::slot,
-                 typename std::remove_cvref_t<Emitter>::args>)
-    auto emitter<Mutex, SharedPointer>::connect_once(
-        this const Receiver& self,
-        Emitter&& emitter,
-        signal<ReceiverArgs...> Receiver::* receiver_signal,
-        Policy&& policy) -> typename std::remove_cvref_t<Emitter>::connection_type
+    template<class Receiver, class Signal, execution_policy Policy>
+    auto emitter<Mutex, SharedPointer>::forward_once_to(this const Receiver& self,
+                                                        Signal Receiver::* receiver_signal,
+                                                        Policy&& policy)
+        -> forward_result<Receiver, Signal Receiver::*, Policy>
     {
-        auto connection { std::forward<Emitter>(emitter).connect_once(
-            self.forwarding_lambda(receiver_signal),
-            std::forward<Policy>(policy)) };
-        (self.*receiver_signal).add_emitting_source(connection);
-        return connection;
+        return { self, receiver_signal, std::forward<Policy>(policy), true };
     }
 
-    template<class Receiver, class Signal, execution_policy Policy>
-    template<source_like Source>
-    auto forward_result<Receiver, Signal Receiver::*, Policy>::create_connection(Source&& origin) ->
-        typename std::remove_cvref_t<Source>::connection_type
+} // namespace details
+
+// ### Connection related classes
+
+template<template<class> class SharedPointer>
+    requires details::shared_pointer_like<SharedPointer>
+class connection
+{
+public:
+    template<details::basic_lockable Mutex, template<class> class OtherSharedPointer>
+        requires details::shared_pointer_like<OtherSharedPointer>
+    friend class details::connection_group;
+    template<class Source, class Notifier, class Connectable>
+    friend class details::take_until_source;
+
+    explicit connection(details::connection_handle handle):
+        m_handle { handle }
     {
-        if (m_connect_once)
+    }
+
+    void disconnect()
+    {
+        with_holder([](details::connection_holder& holder) { holder.disconnect(); });
+    }
+
+    void suspend()
+    {
+        with_holder([](details::connection_holder& holder) { holder.suspend(); });
+    }
+
+    void resume()
+    {
+        with_holder([](details::connection_holder& holder) { holder.resume(); });
+    }
+
+    void add_exception_handler(details::connection_holder::exception_handler handler)
+    {
+        with_holder([&handler](details::connection_holder& holder)
+        { holder.add_exception_handler(std::move(handler)); });
+    }
+
+    // Replaces the slot the signal calls, transformations the connection was made through
+    // included. The connection keeps its position, guard and exception handlers, and calls
+    // that already started finish with the previous slot. Args are the arguments of the signal:
+    // std::invalid_argument is thrown if they differ. Returns false if the connection is gone.
+    template<class... Args, details::partially_callable<Args...> Callable>
+    auto rebind(Callable&& callable) -> bool
+    {
+        const pinned_holder holder { m_handle };
+        if (holder.get() == nullptr)
         {
-            return m_receiver.connect_once(std::forward<Source>(origin),
-                                           m_receiver_signal,
-                                           m_policy);
+            return false;
         }
-        return m_receiver.connect(std::forward<Source>(origin), m_receiver_signal, m_policy);
+
+        details::typed_slot_binding<SharedPointer, Args...> binding { std::forward<Callable>(
+            callable) };
+        return holder.get()->rebind(binding);
     }
 
-    template<basic_lockable Mutex, template<class> class SharedPointer>
-        requires shared_pointer_like<SharedPointer>
-    template<class Receiver, signal_arg... ReceiverArgs>
-    auto emitter<Mutex, SharedPointer>::forwarding_lambda(
-        this const Receiver& self,
-        signal<ReceiverArgs...> Receiver::* receiver_signal)
+    auto operator==(details::connection_holder* holder) -> bool
     {
-        return [&emitted_signal = self.*receiver_signal]<signal_arg... Args>(Args&&... args) mutable
-            requires partially_callable<std::function<void(ReceiverArgs...)>, Args...>
-        {
-            auto lambda { [&]<class... CallArgs>(CallArgs&&... call_args) mutable
-                              requires(sizeof...(CallArgs) == sizeof...(ReceiverArgs))
-            { emitted_signal.emit(std::forward<CallArgs>(call_args)...); } };
-            details::partial_call(lambda, std::forward<Args>(args)...);
-        };
+        return details::connection_registry<SharedPointer>::holds(m_handle, holder);
     }
 
-    // ### signal implementation
+private:
+    using pinned_holder = typename details::connection_registry<SharedPointer>::pinned;
 
-    template<basic_lockable Mutex, template<class> class SharedPointer>
-        requires shared_pointer_like<SharedPointer>
-    template<signal_arg... Args>
-    template<partially_callable<Args...> Callable, execution_policy Policy>
-    auto emitter<Mutex, SharedPointer>::signal<Args...>::connect_impl(Callable&& callable,
-                                                                      Policy&& policy,
-                                                                      bool connect_once) const
-        -> connection<SharedPointer>
+    // The connection is pinned while used, as it may be disposed of otherwise. Returns false if
+    // it is gone.
+    template<class Operation>
+    auto with_holder(Operation&& operation) const -> bool
     {
-        std::lock_guard lock { m_mutex };
-        SharedPointer<slot_list> slots { new slot_list() };
-
-        slots->reserve(m_slots->size() + 1);
-        std::ranges::copy(*m_slots, std::back_inserter(*slots));
+        const pinned_holder holder { m_handle };
+        if (holder.get() == nullptr)
+        {
+            return false;
+        }
 
-        slots->emplace_back(new connection_holder_implementation(*this,
-                                                                 std::forward<Callable>(callable),
-                                                                 std::forward<Policy>(policy),
-                                                                 connect_once));
+        std::invoke(std::forward<Operation>(operation), *holder.get());
+        return true;
+    }
 
-        std::swap(slots, m_slots);
+    details::connection_handle m_handle;
+};
 
-        return connection<SharedPointer> {
-            typename SharedPointer<details::connection_holder>::weak_type(m_slots->back())
-        };
+template<template<class> class SharedPointer>
+    requires details::shared_pointer_like<SharedPointer>
+class scoped_connection
+{
+public:
+    // Not explicit on purpose to allow scoped_connection = object.signal.connect(slot);
+    // NOLINTNEXTLINE(google-explicit-constructor)
+    scoped_connection(connection<SharedPointer> conn):
+        m_connection { std::move(conn) }
+    {
     }
 
-    template<basic_lockable Mutex, template<class> class SharedPointer>
-        requires shared_pointer_like<SharedPointer>
-    template<signal_arg... Args>
-    template<partially_callable<Args...> Callable, execution_policy Policy>
-    auto emitter<Mutex, SharedPointer>::signal<Args...>::connect(Callable&& callable,
-                                                                 Policy&& policy) const
-        -> connection<SharedPointer>
+    scoped_connection(const scoped_connection&) = delete;
+
+    scoped_connection(scoped_connection&& other) noexcept:
+        m_connection { std::move(other.m_connection) }
     {
-        return connect_impl(std::forward<Callable>(callable), std::forward<Policy>(policy), false);
     }
 
-    template<basic_lockable Mutex, template<class> class SharedPointer>
-        requires shared_pointer_like<SharedPointer>
-    template<signal_arg... Args>
-    template<partially_callable<Args...> Callable, execution_policy Policy>
-    auto emitter<Mutex, SharedPointer>::signal<Args...>::connect_once(Callable&& callable,
-                                                                      Policy&& policy) const
-        -> connection<SharedPointer>
+    auto operator=(const scoped_connection&) -> scoped_connection& = delete;
+
+    auto operator=(scoped_connection&& other) noexcept -> scoped_connection&
     {
-        return connect_impl(std::forward<Callable>(callable), std::forward<Policy>(policy), true);
+        m_connection = std::move(other.m_connection);
+        return *this;
     }
 
-    template<basic_lockable Mutex, template<class> class SharedPointer>
-        requires shared_pointer_like<SharedPointer>
-    template<signal_arg... Args>
-    template<partially_callable<Args...> Callable, guard_like Receiver, execution_policy Policy>
-    auto emitter<Mutex, SharedPointer>::signal<Args...>::connect_with_guard(Callable&& callable,
-                                                                            const Receiver& guard,
-                                                                            Policy&& policy,
-                                                                            bool connect_once) const
-        -> connection<SharedPointer>
+    ~scoped_connection()
     {
-        auto connection { connect_impl(std::forward<Callable>(callable),
-                                       std::forward<Policy>(policy),
-                                       connect_once) };
-        guard.add_emitting_source(connection);
+        disconnect();
+    }
 
-        return connection;
+    void disconnect()
+    {
+        m_connection.disconnect();
     }
 
-    template<basic_lockable Mutex, template<class> class SharedPointer>
-        requires shared_pointer_like<SharedPointer>
-    template<signal_arg... Args>
-    template<partially_callable<Args...> Callable, guard_like Receiver, execution_policy Policy>
-    auto emitter<Mutex, SharedPointer>::signal<Args...>::connect(Callable&& callable,
-                                                                 const Receiver& guard,
-                                                                 Policy&& policy) const
-        -> connection<SharedPointer>
+    auto operator==(details::connection_holder* holder) -> bool
     {
-        return connect_with_guard(std::forward<Callable>(callable),
-                                  guard,
-                                  std::forward<Policy>(policy),
-                                  false);
+        return m_connection == holder;
     }
 
-    template<basic_lockable Mutex, template<class> class SharedPointer>
-        requires shared_pointer_like<SharedPointer>
-    template<signal_arg... Args>
-    template<partially_callable<Args...> Callable, guard_like Receiver, execution_policy Policy>
-    auto emitter<Mutex, SharedPointer>::signal<Args...>::connect_once(Callable&& callable,
-                                                                      const Receiver& guard,
-                                                                      Policy&& policy) const
-        -> connection<SharedPointer>
+private:
+    connection<SharedPointer> m_connection;
+};
+
+template<template<class> class SharedPointer>
+    requires details::shared_pointer_like<SharedPointer>
+class inhibitor
+{
+public:
+    explicit inhibitor(connection<SharedPointer> conn):
+        m_connection { std::move(conn) }
     {
-        return connect_with_guard(std::forward<Callable>(callable),
-                                  guard,
-                                  std::forward<Policy>(policy),
-                                  true);
+        m_connection.suspend();
     }
 
-    template<basic_lockable Mutex, template<class> class SharedPointer>
-        requires shared_pointer_like<SharedPointer>
-    template<signal_arg... Args>
-    template<guard_like Receiver,
-             class Result,
-             execution_policy Policy,
-             class... MemberFunctionArgs>
-        requires partially_callable<Result (Receiver::*)(MemberFunctionArgs...), Receiver, Args...>
-    auto emitter<Mutex, SharedPointer>::signal<Args...>::connect(
-        Result (Receiver::*callable)(MemberFunctionArgs...),
-        Receiver& guard,
-        Policy&& policy) const -> connection<SharedPointer>
+    inhibitor(const inhibitor&) = default;
+    inhibitor(inhibitor&&) = default;
+
+    auto operator=(const inhibitor&) -> inhibitor& = default;
+    auto operator=(inhibitor&&) -> inhibitor& = default;
+
+    ~inhibitor()
     {
-        return connect_with_guard(member_function_lambda(callable, guard),
-                                  guard,
-                                  std::forward<Policy>(policy),
-                                  false);
+        m_connection.resume();
     }
 
-    template<basic_lockable Mutex, template<class> class SharedPointer>
-        requires shared_pointer_like<SharedPointer>
-    template<signal_arg... Args>
-    template<guard_like Receiver,
-             class Result,
-             execution_policy Policy,
-             class... MemberFunctionArgs>
-        requires partially_callable<Result (Receiver::*)(MemberFunctionArgs...), Receiver, Args...>
-    auto emitter<Mutex, SharedPointer>::signal<Args...>::connect_once(
-        Result (Receiver::*callable)(MemberFunctionArgs...),
-        Receiver& guard,
-        Policy&& policy) const -> connection<SharedPointer>
+private:
+    connection<SharedPointer> m_connection;
+};
+
+// Blocks an emitter, or a single signal, for the lifetime of the blocker.
+template<class Blockable>
+    requires(requires(Blockable& blockable) {
+        blockable.block_signals();
+        blockable.unblock_signals();
+    } || requires(Blockable& blockable) {
+        blockable.block();
+        blockable.unblock();
+    })
+class scoped_blocker
+{
+public:
+    explicit scoped_blocker(Blockable& blockable):
+        m_blockable { blockable }
     {
-        return connect_with_guard(member_function_lambda(callable, guard),
-                                  guard,
-                                  std::forward<Policy>(policy),
-                                  true);
+        if constexpr (requires { blockable.block_signals(); })
+        {
+            m_blockable.block_signals();
+        }
+        else
+        {
+            m_blockable.block();
+        }
     }
 
-    template<basic_lockable Mutex, template<class> class SharedPointer>
-        requires shared_pointer_like<SharedPointer>
-    template<signal_arg... Args>
-    template<guard_like Receiver,
-             class Result,
-             execution_policy Policy,
-             class... MemberFunctionArgs>
-        requires partially_callable<Result (Receiver::*)(MemberFunctionArgs...) const,
-                                    const Receiver,
-                                    Args...>
-    auto emitter<Mutex, SharedPointer>::signal<Args...>::connect(
-        Result (Receiver::*callable)(MemberFunctionArgs...) const,
-        const Receiver& guard,
-        Policy&& policy) const -> connection<SharedPointer>
+    scoped_blocker(const scoped_blocker&) = delete;
+    scoped_blocker(scoped_blocker&&) = delete;
+
+    auto operator=(const scoped_blocker&) -> scoped_blocker& = delete;
+    auto operator=(scoped_blocker&&) -> scoped_blocker& = delete;
+
+    ~scoped_blocker()
     {
-        return connect_with_guard(member_function_lambda(callable, guard),
-                                  guard,
-                                  std::forward<Policy>(policy),
-                                  false);
+        if constexpr (requires { m_blockable.unblock_signals(); })
+        {
+            m_blockable.unblock_signals();
+        }
+        else
+        {
+            m_blockable.unblock();
+        }
     }
 
-    template<basic_lockable Mutex, template<class> class SharedPointer>
-        requires shared_pointer_like<SharedPointer>
-    template<signal_arg... Args>
-    template<guard_like Receiver,
-             class Result,
-             execution_policy Policy,
-             class... MemberFunctionArgs>
-        requires partially_callable<Result (Receiver::*)(MemberFunctionArgs...) const,
-                                    const Receiver,
-                                    Args...>
-    auto emitter<Mutex, SharedPointer>::signal<Args...>::connect_once(
-        Result (Receiver::*callable)(MemberFunctionArgs...) const,
-        const Receiver& guard,
-        Policy&& policy) const -> connection<SharedPointer>
-    {
-        return connect_with_guard(member_function_lambda(callable, guard),
-                                  guard,
-                                  std::forward<Policy>(policy),
-                                  true);
-    }
+private:
+    // It might be bad, but this is done on purpose.
+    // NOLINTNEXTLINE(cppcoreguidelines-avoid-const-or-ref-data-members)
+    Blockable& m_blockable;
+};
+
+// ### Class receiver
+
+namespace details
+{
+    template<details::basic_lockable Mutex, template<class> class SharedPointer>
+        requires details::shared_pointer_like<SharedPointer>
+    class guard
+    {
+    public:
+        template<details::signal_arg... Args>
+        friend class emitter<Mutex, SharedPointer>::signal;
+
+        guard() = default;
+        ~guard() = default;
+
+        guard(const guard&)
+        {
+            // Empty on purpose
+        }
+
+        guard(guard&&) noexcept
+        {
+            // Nothing on purpose
+        }
+
+        auto operator=(const guard&) -> guard&
+        {
+            // Nothing on purpose
+            return *this;
+        }
+
+        auto operator=(guard&&) noexcept -> guard&
+        {
+            // Nothing on purpose
+            return *this;
+        }
+
+    protected:
+        void clean(details::connection_holder* holder) const
+        {
+            std::lock_guard lock { m_mutex };
+            std::erase(m_emitting_sources, holder);
+        }
+
+        void add_emitting_source(connection<SharedPointer> source) const
+        {
+            std::lock_guard lock { m_mutex };
+            m_emitting_sources.emplace_back(std::move(source));
+        }
+
+    private:
+        mutable std::vector<scoped_connection<SharedPointer>> m_emitting_sources;
+        mutable Mutex m_mutex;
+    };
+
+    template<basic_lockable Mutex, template<class> class SharedPointer>
+        requires shared_pointer_like<SharedPointer>
+    class receiver: public guard<Mutex, SharedPointer>
+    {
+    public:
+        template<signal_arg... Args>
+        friend class emitter<Mutex, SharedPointer>::signal;
+    };
+
+} // namespace details
+
+// ### Class connection_group
+
+namespace details
+{
+    // Connections managed together, whichever their signals. Suspending or resuming the group
+    // is a single store, whatever its size: only the connections that joined it check it when
+    // emitted. The connections are neither counted as suspended by their signals, nor are their
+    // pending asynchronous calls dropped. Destroying the group leaves its connections as they are.
+    template<basic_lockable Mutex, template<class> class SharedPointer>
+        requires shared_pointer_like<SharedPointer>
+    class connection_group
+    {
+    public:
+        connection_group():
+            m_state { new group_state() }
+        {
+        }
+
+        connection_group(const connection_group&) = delete;
+        connection_group(connection_group&&) = delete;
+
+        auto operator=(const connection_group&) -> connection_group& = delete;
+        auto operator=(connection_group&&) -> connection_group& = delete;
+
+        ~connection_group() = default;
+
+        // Usually given a connection right after it is made. A connection joins one group at
+        // most: std::invalid_argument is thrown otherwise.
+        auto add(connection<SharedPointer> member) -> connection<SharedPointer>
+        {
+            typed_group_binding<SharedPointer> binding { m_state };
+            const bool joined { member.with_holder([&binding](connection_holder& holder)
+                                                   { holder.join(binding); }) };
+            if (!joined)
+            {
+                return member;
+            }
+
+            std::lock_guard lock { m_mutex };
+            if (m_members.size() == m_members.capacity())
+            {
+                // Forgets connections that are gone before growing.
+                std::erase_if(m_members,
+                              [](const auto& existing)
+                              { return !existing.with_holder([](const connection_holder&) {}); });
+            }
+            m_members.emplace_back(member);
+
+            return member;
+        }
+
+        void suspend()
+        {
+            m_state->suspended.store(true, std::memory_order_relaxed);
+        }
+
+        void resume()
+        {
+            m_state->suspended.store(false, std::memory_order_relaxed);
+        }
+
+        auto suspended() const -> bool
+        {
+            return m_state->suspended.load(std::memory_order_relaxed);
+        }
+
+        // Each connection is marked as disconnected, and each signal removes all of them with a
+        // single update on its next emission, instead of one update per connection.
+        void disconnect()
+        {
+            std::vector<connection<SharedPointer>> members;
+            {
+                std::lock_guard lock { m_mutex };
+                std::swap(members, m_members);
+            }
+
+            for (const auto& member: members)
+            {
+                member.with_holder([](connection_holder& holder) { holder.retire(); });
+            }
+        }
+
+    private:
+        SharedPointer<group_state> m_state;
+        std::vector<connection<SharedPointer>> m_members;
+        Mutex m_mutex;
+    };
+
+} // namespace details
+
+// ### connectable
+
+template<template<class> class SharedPointer>
+    requires details::shared_pointer_like<SharedPointer>
+class connectable: public details::source<SharedPointer>
+{
+public:
+    using connectable_type = connectable<SharedPointer>;
+
+    template<class Self,
+             class Callable,
+             details::execution_policy Policy = details::synchronous_policy>
+    auto connect(this Self&& self, Callable&& callable, Policy&& policy = {})
+        -> connection<SharedPointer>
+    {
+        auto target { make_bind_target(self) };
+        auto made { std::forward<Self>(self).m_source.connect(
+            forwarded(std::forward<Self>(self), std::forward<Callable>(callable), target),
+            std::forward<Policy>(policy)) };
+        return bound(target, std::move(made));
+    }
+
+    template<class Self,
+             class Callable,
+             details::execution_policy Policy = details::synchronous_policy>
+    auto connect_once(this Self&& self, Callable&& callable, Policy&& policy = {})
+        -> connection<SharedPointer>
+    {
+        auto target { make_bind_target(self) };
+        auto made { std::forward<Self>(self).m_source.connect_once(
+            forwarded(std::forward<Self>(self), std::forward<Callable>(callable), target),
+            std::forward<Policy>(policy)) };
+        return bound(target, std::move(made));
+    }
+
+    template<class Self,
+             class Callable,
+             guard_like Receiver,
+             details::execution_policy Policy = details::synchronous_policy>
+    auto connect(this Self&& self, Callable&& callable, const Receiver& guard, Policy&& policy = {})
+        -> connection<SharedPointer>
+    {
+        auto target { make_bind_target(self) };
+        auto made { std::forward<Self>(self).m_source.connect(
+            forwarded(std::forward<Self>(self), std::forward<Callable>(callable), target),
+            guard,
+            std::forward<Policy>(policy)) };
+        return bound(target, std::move(made));
+    }
+
+    template<class Self,
+             class Callable,
+             guard_like Receiver,
+             details::execution_policy Policy = details::synchronous_policy>
+    auto connect_once(this Self&& self,
+                      Callable&& callable,
+                      const Receiver& guard,
+                      Policy&& policy = {}) -> connection<SharedPointer>
+    {
+        auto target { make_bind_target(self) };
+        auto made { std::forward<Self>(self).m_source.connect_once(
+            forwarded(std::forward<Self>(self), std::forward<Callable>(callable), target),
+            guard,
+            std::forward<Policy>(policy)) };
+        return bound(target, std::move(made));
+    }
+
+    template<class Self,
+             guard_like Receiver,
+             class Result,
+             details::execution_policy Policy = details::synchronous_policy,
+             class... MemberFunctionArgs>
+    auto connect(this Self&& self,
+                 Result (Receiver::*callable)(MemberFunctionArgs...),
+                 Receiver& guard,
+                 Policy&& policy = {}) -> connection<SharedPointer>
+    {
+        auto target { make_bind_target(self) };
+        auto made { std::forward<Self>(self).m_source.connect(
+            forwarded(
+                std::forward<Self>(self),
+                [&guard, callable]<class... Args>(Args&&... args) mutable
+            requires details::partially_callable<decltype(callable), Receiver&, Args...>
+        { partial_call(callable, guard, std::forward<Args>(args)...); },
+                target),
+            guard,
+            std::forward<Policy>(policy)) };
+        return bound(target, std::move(made));
+    }
+
+    template<class Self,
+             guard_like Receiver,
+             class Result,
+             details::execution_policy Policy = details::synchronous_policy,
+             class... MemberFunctionArgs>
+    auto connect_once(this Self&& self,
+                      Result (Receiver::*callable)(MemberFunctionArgs...),
+                      Receiver& guard,
+                      Policy&& policy = {}) -> connection<SharedPointer>
+    {
+        auto target { make_bind_target(self) };
+        auto made { std::forward<Self>(self).m_source.connect_once(
+            forwarded(
+                std::forward<Self>(self),
+                [&guard, callable]<class... Args>(Args&&... args) mutable
+            requires details::partially_callable<decltype(callable), Receiver&, Args...>
+        { partial_call(callable, guard, std::forward<Args>(args)...); },
+                target),
+            guard,
+            std::forward<Policy>(policy)) };
+        return bound(target, std::move(made));
+    }
+
+    template<class Self,
+             guard_like Receiver,
+             class Result,
+             details::execution_policy Policy = details::synchronous_policy,
+             class... MemberFunctionArgs>
+    auto connect(this Self&& self,
+                 Result (Receiver::*callable)(MemberFunctionArgs...) const,
+                 const Receiver& guard,
+                 Policy&& policy = {}) -> connection<SharedPointer>
+    {
+        auto target { make_bind_target(self) };
+        auto made { std::forward<Self>(self).m_source.connect(
+            forwarded(
+                std::forward<Self>(self),
+                [&guard, callable]<class... Args>(Args&&... args) mutable
+            requires details::partially_callable<decltype(callable), const Receiver&, Args...>
+        { partial_call(callable, guard, std::forward<Args>(args)...); },
+                target),
+            guard,
+            std::forward<Policy>(policy)) };
+        return bound(target, std::move(made));
+    }
+
+    template<class Self,
+             guard_like Receiver,
+             class Result,
+             details::execution_policy Policy = details::synchronous_policy,
+             class... MemberFunctionArgs>
+    auto connect_once(this Self&& self,
+                      Result (Receiver::*callable)(MemberFunctionArgs...) const,
+                      const Receiver& guard,
+                      Policy&& policy = {}) -> connection<SharedPointer>
+    {
+        auto target { make_bind_target(self) };
+        auto made { std::forward<Self>(self).m_source.connect_once(
+            forwarded(
+                std::forward<Self>(self),
+                [&guard, callable]<class... Args>(Args&&... args) mutable
+            requires details::partially_callable<decltype(callable), const Receiver&, Args...>
+        { partial_call(callable, guard, std::forward<Args>(args)...); },
+                target),
+            guard,
+            std::forward<Policy>(policy)) };
+        return bound(target, std::move(made));
+    }
+
+private:
+    // Sources whose forwarding lambda shares something with the connection made with it declare
+    // a bind_target: connect gives it to the forwarding lambda, then binds it to the connection.
+    struct no_bind_target
+    {
+    };
+
+    template<class Self>
+    static auto make_bind_target(const Self& /*self*/)
+    {
+        if constexpr (requires { typename Self::bind_target; })
+        {
+            return typename Self::bind_target {};
+        }
+        else
+        {
+            return no_bind_target {};
+        }
+    }
+
+    template<class Self, class Callable, class Target>
+    static auto forwarded(Self&& self, Callable&& callable, Target& target)
+    {
+        if constexpr (std::same_as<Target, no_bind_target>)
+        {
+            return std::forward<Self>(self).forwarding_lambda(std::forward<Callable>(callable));
+        }
+        else
+        {
+            return std::forward<Self>(self).forwarding_lambda(std::forward<Callable>(callable),
+                                                              target);
+        }
+    }
+
+    template<class Target>
+    static auto bound(Target& target, connection<SharedPointer> made) -> connection<SharedPointer>
+    {
+        if constexpr (!std::same_as<Target, no_bind_target>)
+        {
+            target.bind(made);
+        }
+        return made;
+    }
+};
+
+// ### class chainable
+
+class chainable;
+
+namespace details
+{
+    // ### Signal definition
+
+    template<basic_lockable Mutex, template<class> class SharedPointer>
+        requires shared_pointer_like<SharedPointer>
+    template<signal_arg... Args>
+    class emitter<Mutex, SharedPointer>::signal final: public source<SharedPointer>
+    {
+    public:
+        using connection_type = connection<SharedPointer>;
+        using connectable_type = connectable<SharedPointer>;
+
+        signal() = default;
+
+        signal(const signal&):
+            signal()
+        {
+            // Nothing on purpose
+        }
+
+        signal(signal&&) noexcept
+        {
+            // Nothing on purpose
+        }
+
+        auto operator=(const signal&) -> signal&
+        {
+            // Nothing on purpose
+            return *this;
+        }
+
+        auto operator=(signal&&) noexcept -> signal&
+        {
+            // Nothing on purpose
+            return *this;
+        }
+
+        ~signal()
+        {
+            auto* current_state { m_state.load(std::memory_order_acquire) };
+            if (current_state == nullptr)
+            {
+                return;
+            }
+
+            // Forwarded emissions of this signal may still be queued.
+            forwarding_queue::cancel(this);
+
+            // Pending asynchronous calls may keep connections alive after the signal.
+            for (const auto& holder: *current_state->slots)
+            {
+                holder->detach();
+            }
+            // The frozen lists may hold connections removed since.
+            auto* frozen { current_state->frozen.load(std::memory_order_acquire) };
+            if (frozen != nullptr)
+            {
+                frozen->next = current_state->replaced_frozen.load(std::memory_order_acquire);
+            }
+            else
+            {
+                frozen = current_state->replaced_frozen.load(std::memory_order_acquire);
+            }
+            while (frozen != nullptr)
+            {
+                for (const auto& holder: *frozen->slots)
+                {
+                    holder->detach();
+                }
+                delete std::exchange(frozen, frozen->next);
+            }
+
+            auto* index { current_state->key_indices.load(std::memory_order_acquire) };
+            while (index != nullptr)
+            {
+                delete std::exchange(index, index->next);
+            }
+
+            delete current_state;
+        }
+
+        using args = std::tuple<Args...>;
+
+        template<signal_arg... OtherArgs>
+        friend class signal;
+        template<class Stage, class Source, class StageArgs, class Connectable>
+        friend class shared_stage;
+        template<class Stage, class StageArgs, class Connectable, class... Sources>
+        friend class fan_in_stage;
+        template<class T, class Equal>
+        friend class emitter::property;
+        template<basic_lockable BrokerMutex,
+                 template<class> class BrokerSharedPointer,
+                 signal_arg... BrokerArgs>
+            requires shared_pointer_like<BrokerSharedPointer>
+        friend class topic_broker;
+
+        template<std::size_t Index>
+        using key_type = std::remove_cvref_t<std::tuple_element_t<Index, args>>;
+
+        friend emitter;
+        using slot = std::function<void(Args...)>;
+
+        template<partially_callable<Args...> Callable, execution_policy Policy = synchronous_policy>
+        auto connect(Callable&& callable, Policy&& policy = {}) const -> connection<SharedPointer>;
+
+        template<partially_callable<Args...> Callable, execution_policy Policy = synchronous_policy>
+        auto connect_once(Callable&& callable, Policy&& policy = {}) const
+            -> connection<SharedPointer>;
+
+        template<partially_callable<Args...> Callable,
+                 guard_like Receiver,
+                 execution_policy Policy = synchronous_policy>
+        auto connect(Callable&& callable, const Receiver& guard, Policy&& policy = {}) const
+            -> connection<SharedPointer>;
+
+        template<partially_callable<Args...> Callable,
+                 guard_like Receiver,
+                 execution_policy Policy = synchronous_policy>
+        auto connect_once(Callable&& callable, const Receiver& guard, Policy&& policy = {}) const
+            -> connection<SharedPointer>;
+
+        template<guard_like Receiver,
+                 class Result,
+                 execution_policy Policy = synchronous_policy,
+                 class... MemberFunctionArgs>
+            requires partially_callable<Result (Receiver::*)(MemberFunctionArgs...),
+                                        Receiver,
+                                        Args...>
+        auto connect(Result (Receiver::*callable)(MemberFunctionArgs...),
+                     Receiver& guard,
+                     Policy&& policy = {}) const -> connection<SharedPointer>;
+
+        template<guard_like Receiver,
+                 class Result,
+                 execution_policy Policy = synchronous_policy,
+                 class... MemberFunctionArgs>
+            requires partially_callable<Result (Receiver::*)(MemberFunctionArgs...),
+                                        Receiver,
+                                        Args...>
+        auto connect_once(Result (Receiver::*callable)(MemberFunctionArgs...),
+                          Receiver& guard,
+                          Policy&& policy = {}) const -> connection<SharedPointer>;
+
+        template<guard_like Receiver,
+                 class Result,
+                 execution_policy Policy = synchronous_policy,
+                 class... MemberFunctionArgs>
+            requires partially_callable<Result (Receiver::*)(MemberFunctionArgs...) const,
+                                        const Receiver,
+                                        Args...>
+        auto connect(Result (Receiver::*callable)(MemberFunctionArgs...) const,
+                     const Receiver& guard,
+                     Policy&& policy = {}) const -> connection<SharedPointer>;
+
+        template<guard_like Receiver,
+                 class Result,
+                 execution_policy Policy = synchronous_policy,
+                 class... MemberFunctionArgs>
+            requires partially_callable<Result (Receiver::*)(MemberFunctionArgs...) const,
+                                        const Receiver,
+                                        Args...>
+        auto connect_once(Result (Receiver::*callable)(MemberFunctionArgs...) const,
+                          const Receiver& guard,
+                          Policy&& policy = {}) const -> connection<SharedPointer>;
+
+        // Connects to the emissions whose Index-th argument equals the key. Emitting only looks
+        // up the connections of the emitted key, however many keys are connected. Takes whatever
+        // connect takes after the key.
+        template<std::size_t Index, class... ConnectArgs>
+            requires(in_args_range<Index, Args...> && hashable<key_type<Index>> &&
+                     requires(const signal& key_signal, ConnectArgs&&... connect_args) {
+                         key_signal.connect(std::forward<ConnectArgs>(connect_args)...);
+                     })
+        auto connect_key(const key_type<Index>& key, ConnectArgs&&... connect_args) const
+            -> connection<SharedPointer>
+        {
+            return connect_key_impl<Index>(key, std::forward<ConnectArgs>(connect_args)...);
+        }
+
+        // While blocked, emitting the signal is a no-op. Each call to block must be matched by a
+        // call to unblock.
+        void block() const
+        {
+            get_state().blocked.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        void unblock() const
+        {
+            auto* current_state { m_state.load(std::memory_order_acquire) };
+            if (current_state != nullptr)
+            {
+                release_block(current_state->blocked);
+            }
+        }
+
+        auto blocked() const -> bool
+        {
+            auto* current_state { m_state.load(std::memory_order_acquire) };
+            return current_state != nullptr &&
+                   current_state->blocked.load(std::memory_order_relaxed) != 0;
+        }
+
+        // Emissions dropped because the signal was blocked.
+        auto suppressed_emissions() const -> std::size_t
+        {
+            auto* current_state { m_state.load(std::memory_order_acquire) };
+            return current_state == nullptr
+                       ? 0
+                       : current_state->suppressed_emissions.load(std::memory_order_relaxed);
+        }
+
+        // Whether emitting may call anything: some connection is neither suspended nor fired.
+        // Suspended groups are not counted, so this is true if all such connections are in
+        // suspended groups. Neither this nor slot_count lock anything, so both may be outdated as
+        // soon as they return when connections change on other threads.
+        auto has_active_slots() const -> bool
+        {
+            auto* current_state { m_state.load(std::memory_order_acquire) };
+            return current_state != nullptr &&
+                   current_state->active_count.load(std::memory_order_relaxed) != 0;
+        }
+
+        // Connections that may still be called, suspended ones included.
+        auto slot_count() const -> std::size_t
+        {
+            auto* current_state { m_state.load(std::memory_order_acquire) };
+            return current_state == nullptr
+                       ? 0
+                       : current_state->connected_count.load(std::memory_order_relaxed);
+        }
+
+        // Until its connections change, emitting neither locks nor copies anything: any
+        // connection, disconnection, suspension or resumption unfreezes the signal. Emissions may
+        // still read the frozen list once unfrozen: the signal counts the emissions reading a
+        // frozen list, and frees the lists it replaced whenever that count drops to zero.
+        void freeze() const
+        {
+            auto* current_state { m_state.load(std::memory_order_acquire) };
+            if (current_state != nullptr)
+            {
+                freeze_slots(*current_state);
+            }
+        }
+
+        auto frozen() const -> bool
+        {
+            auto* current_state { m_state.load(std::memory_order_acquire) };
+            return current_state != nullptr &&
+                   current_state->frozen.load(std::memory_order_relaxed) != nullptr;
+        }
+
+    private:
+        template<partially_callable<Args...> Callable, execution_policy Policy>
+        auto connect_impl(Callable&& callable, Policy&& policy, bool connect_once) const
+            -> connection<SharedPointer>;
+
+        template<partially_callable<Args...> Callable, guard_like Receiver, execution_policy Policy>
+        auto connect_with_guard(Callable&& callable,
+                                const Receiver& guard,
+                                Policy&& policy,
+                                bool connect_once) const -> connection<SharedPointer>;
+
+        template<guard_like Receiver, class MemberFunction>
+            requires partially_callable<MemberFunction, Receiver, Args...>
+        static auto member_function_lambda(MemberFunction member_function, Receiver& guard)
+        {
+            return [&guard, member_function]<class... CallArgs>(CallArgs&&... args) mutable
+                requires partially_callable<MemberFunction, Receiver&, CallArgs...>
+            { partial_call(member_function, guard, std::forward<CallArgs>(args)...); };
+        }
+
+        template<class... EmittedArgs>
+            requires std::invocable<slot, EmittedArgs&&...>
+        void emit(EmittedArgs&&... emitted_args) const
+        {
+            emit_until([] { return false; }, std::forward<EmittedArgs>(emitted_args)...);
+        }
+
+        // Stops calling connections once done returns true. It is checked between connections.
+        template<std::predicate Done, class... EmittedArgs>
+            requires std::invocable<slot, EmittedArgs&&...>
+        void emit_until(const Done& done, EmittedArgs&&... emitted_args) const
+        {
+            auto* current_state { m_state.load(std::memory_order_acquire) };
+            if (current_state == nullptr)
+            {
+                return;
+            }
+
+            if (suppress_emission(*current_state))
+            {
+                return;
+            }
+
+            // Signals that were never frozen don't count anything.
+            if (current_state->frozen.load(std::memory_order_relaxed) != nullptr)
+            {
+                const frozen_emission counted { *current_state };
+                const auto* frozen { current_state->frozen.load(std::memory_order_seq_cst) };
+                if (frozen != nullptr)
+                {
+                    emit_to(*current_state,
+                            *frozen->slots,
+                            done,
+                            std::forward<EmittedArgs>(emitted_args)...);
+                    return;
+                }
+            }
+
+            const auto slots { copy_active_slots(*current_state) };
+            emit_to(*current_state, *slots, done, std::forward<EmittedArgs>(emitted_args)...);
+        }
+
+        template<class Done, class... EmittedArgs>
+        static void emit_to(const state& current_state,
+                            const slot_list& slots,
+                            const Done& done,
+                            EmittedArgs&&... emitted_args)
+        {
+            auto* key_indices { current_state.key_indices.load(std::memory_order_acquire) };
+            if (key_indices != nullptr)
+            {
+                // Keyed connections are called last, so no other connection may take the
+                // arguments.
+                for (const auto& holder: slots)
+                {
+                    if (done())
+                    {
+                        return;
+                    }
+                    (*holder)(holder, emitted_args...);
+                }
+                for (const auto* index { key_indices }; index != nullptr; index = index->next)
+                {
+                    if (done())
+                    {
+                        return;
+                    }
+                    index->emit(emitted_args...);
+                }
+                return;
+            }
+
+            if (slots.empty())
+            {
+                return;
+            }
+
+            auto begin { slots.begin() };
+            auto previous_to_end { std::prev(slots.end()) };
+
+            for (auto it { begin }; it != previous_to_end; ++it)
+            {
+                if (done())
+                {
+                    return;
+                }
+                (**it)(*it, emitted_args...);
+            }
+
+            if (!done())
+            {
+                (*slots.back())(slots.back(), std::forward<EmittedArgs>(emitted_args)...);
+            }
+        }
+
+        template<class Factory>
+        void emit_lazy(Factory&& factory) const
+        {
+            auto* current_state { m_state.load(std::memory_order_acquire) };
+            if (current_state == nullptr || suppress_emission(*current_state) ||
+                current_state->active_count.load(std::memory_order_relaxed) == 0)
+            {
+                return;
+            }
+
+            if constexpr (std::invocable<slot, std::invoke_result_t<Factory>>)
+            {
+                emit(std::invoke(std::forward<Factory>(factory)));
+            }
+            else
+            {
+                std::apply([this]<class... PayloadArgs>(PayloadArgs&&... payload_args)
+                           { emit(std::forward<PayloadArgs>(payload_args)...); },
+                           std::invoke(std::forward<Factory>(factory)));
+            }
+        }
+
+        class connection_holder_implementation;
+        template<class StoredPolicy>
+        class connection_holder_policy_implementation;
+
+        using slot_list = std::vector<SharedPointer<connection_holder_implementation>>;
+
+        // Only meaningful while nothing else may connect to the signal.
+        auto last_connection() const -> SharedPointer<connection_holder_implementation>
+        {
+            auto& current_state { get_state() };
+
+            std::lock_guard lock { current_state.mutex };
+            return current_state.slots->back();
+        }
+
+        class key_index_base;
+        struct key_entry;
+
+        // What freeze publishes for emissions to read without locking, until it is replaced.
+        struct frozen_list
+        {
+            SharedPointer<slot_list> slots;
+            // The next list replaced while emissions were reading.
+            frozen_list* next { nullptr };
+        };
+
+        // Everything a connected signal needs. It is only allocated on first connection, so that
+        // a signal nobody listens to costs a single pointer.
+        struct state
+        {
+            // Every connection, in connection order.
+            SharedPointer<slot_list> slots { SharedPointer<slot_list>(new slot_list()) };
+            // What emission iterates over: suspended and fired connections are left out, so
+            // that emitting costs nothing for them.
+            SharedPointer<slot_list> active_slots { SharedPointer<slot_list>(new slot_list()) };
+            Mutex mutex;
+            // Connections forwarding other signals to this one.
+            std::vector<scoped_connection<SharedPointer>> emitting_sources;
+            // Whether active_slots must be rebuilt before the next emission.
+            std::atomic<bool> outdated { false };
+            // Set by freeze to active_slots, which emission then reads without locking, and
+            // cleared whenever active_slots gets outdated.
+            std::atomic<frozen_list*> frozen { nullptr };
+            // Emissions reading a frozen list, and the lists replaced since they started, which
+            // are freed once no emission reads any.
+            std::atomic<std::size_t> frozen_emissions { 0 };
+            std::atomic<frozen_list*> replaced_frozen { nullptr };
+            // The last call to freeze_all of the emitter this signal followed.
+            std::atomic<std::uint32_t> followed_freezes { 0 };
+            std::atomic<std::uint32_t> blocked { 0 };
+            std::atomic<std::size_t> suppressed_emissions { 0 };
+            // Kept up to date by the connections themselves, so that they can be read without
+            // locking.
+            std::atomic<std::size_t> connected_count { 0 };
+            std::atomic<std::size_t> active_count { 0 };
+            // Connections of connect_key, one index per argument used as a key.
+            std::atomic<key_index_base*> key_indices { nullptr };
+            // The state of the signal this signal is a key of, which counts its connections too.
+            state* parent { nullptr };
+            // Kept by every connection made afterwards. Weak, as the owner holds the signal.
+            typename SharedPointer<signal_owner>::weak_type owner;
+            // Set before the first connection, and never changed afterwards.
+            connection_observer* observer { nullptr };
+        };
+
+        // Connections of connect_key, by value of one of the arguments. Each key gets its own
+        // signal, so that keyed connections behave like any other connection.
+        class key_index_base
+        {
+        public:
+            key_index_base(const key_index_base&) = delete;
+            key_index_base(key_index_base&&) = delete;
+
+            auto operator=(const key_index_base&) -> key_index_base& = delete;
+            auto operator=(key_index_base&&) -> key_index_base& = delete;
+
+            virtual ~key_index_base() = default;
+
+            virtual void emit(shared_slot_arg_t<Args>... emitted_args) const = 0;
+
+            // Called once the count of the key dropped to zero. Erases the key, unless it was
+            // connected again meanwhile.
+            virtual void erase_if_unused(key_entry& unused) = 0;
+
+            auto position() const -> std::size_t
+            {
+                return m_position;
+            }
+
+            // Indices are never removed, so the list can be read without locking.
+            // It might be bad, but this is done on purpose.
+            // NOLINTNEXTLINE(misc-non-private-member-variables-in-classes)
+            key_index_base* next { nullptr };
+
+        protected:
+            explicit key_index_base(std::size_t position):
+                m_position { position }
+            {
+            }
+
+        private:
+            std::size_t m_position;
+        };
+
+        // Keys live in an open addressing table, copied on write as slot lists are: a new key or
+        // an erased one publishes a new table, made with the parent state mutex locked. Emission
+        // copies the pointer to the table under a mutex of its own, and looks the key up in it
+        // without locking. Tables are never more than half full.
+        template<std::size_t Index>
+        class key_index final: public key_index_base
+        {
+        public:
+            explicit key_index(state& parent_state):
+                key_index_base { Index },
+                m_parent_state { parent_state },
+                m_table { new table(0) }
+            {
+            }
+
+            key_index(const key_index&) = delete;
+            key_index(key_index&&) = delete;
+
+            auto operator=(const key_index&) -> key_index& = delete;
+            auto operator=(key_index&&) -> key_index& = delete;
+
+            // The parent signal is gone: the connections of the keys may outlive it, and must
+            // let go of their entries.
+            ~key_index() override
+            {
+                for (const auto& slot: m_table->slots)
+                {
+                    if (slot.has_value())
+                    {
+                        slot->entry().key_signal.release_connections();
+                    }
+                }
+            }
+
+            // Must be called with the parent state mutex locked, until the signal of the key is
+            // connected, so that it isn't erased meanwhile.
+            auto bucket(const key_type<Index>& key) -> const signal&
+            {
+                const auto* found { m_table->find(key) };
+                if (found != nullptr)
+                {
+                    return found->entry().key_signal;
+                }
+
+                auto* added_entry { new key_entry(*this) };
+                SharedPointer<signal_owner> added { added_entry };
+                const auto& key_signal { added_entry->key_signal };
+                key_signal.get_state().parent = &m_parent_state;
+                key_signal.observe_connections(*added_entry);
+                key_signal.set_owner(added);
+
+                // The replaced table only holds keys the new one holds too: it can go under the
+                // lock.
+                auto copied { copy_table(m_live_keys + 1, nullptr) };
+                copied->insert(node { .key = key, .owner = std::move(added) });
+                replace_table(std::move(copied));
+                ++m_live_keys;
+                return key_signal;
+            }
+
+            // Keeps the table until the slots return, as the entry found in it holds the signal
+            // of the key.
+            void emit(shared_slot_arg_t<Args>... emitted_args) const override
+            {
+                SharedPointer<table> current_table;
+                {
+                    std::lock_guard lock { m_table_mutex };
+                    current_table = m_table;
+                }
+
+                const auto& emitted_key { std::get<Index>(std::tie(emitted_args...)) };
+                const auto* found { current_table->find(emitted_key) };
+                if (found == nullptr)
+                {
+                    return;
+                }
+
+                const auto slots { copy_active_slots(found->entry().key_signal.get_state()) };
+                for (const auto& holder: *slots)
+                {
+                    (*holder)(holder, emitted_args...);
+                }
+            }
+
+            // Connections are let go of before the table without the key is published, so that
+            // none of the lists of the signal holds the entry once the index no longer does.
+            void erase_if_unused(key_entry& unused) override
+            {
+                // Released once the lock is, as they may hold the last references to connections.
+                connection_lists released;
+                SharedPointer<table> replaced;
+
+                std::lock_guard lock { m_parent_state.mutex };
+                if (unused.erased || unused.key_signal.slot_count() != 0)
+                {
+                    return;
+                }
+
+                unused.erased = true;
+                released = unused.key_signal.release_connections();
+                replaced = replace_table(copy_table(m_live_keys - 1, &unused));
+                --m_live_keys;
+            }
+
+        private:
+            struct node
+            {
+                auto entry() const -> key_entry&
+                {
+                    return *static_cast<key_entry*>(owner.get());
+                }
+
+                key_type<Index> key;
+                SharedPointer<signal_owner> owner;
+            };
+
+            // Never changed once published.
+            struct table
+            {
+                explicit table(std::size_t live_keys):
+                    slots(std::bit_ceil(std::max(live_keys * 2, minimum_capacity)))
+                {
+                }
+
+                // Probing stops at the first empty slot: tables are never full.
+                auto find(const key_type<Index>& key) const -> const node*
+                {
+                    const auto mask { slots.size() - 1 };
+                    for (auto position { std::hash<key_type<Index>> {}(key) & mask };;
+                         position = (position + 1) & mask)
+                    {
+                        if (!slots[position].has_value())
+                        {
+                            return nullptr;
+                        }
+                        if (slots[position]->key == key)
+                        {
+                            return &*slots[position];
+                        }
+                    }
+                }
+
+                void insert(node added)
+                {
+                    const auto mask { slots.size() - 1 };
+                    auto position { std::hash<key_type<Index>> {}(added.key) & mask };
+                    while (slots[position].has_value())
+                    {
+                        position = (position + 1) & mask;
+                    }
+                    slots[position].emplace(std::move(added));
+                }
+
+                // It might be bad, but this is done on purpose.
+                // NOLINTNEXTLINE(misc-non-private-member-variables-in-classes)
+                std::vector<std::optional<node>> slots;
+            };
+
+            static constexpr std::size_t minimum_capacity { 8 };
+
+            // Must be called with the parent state mutex locked. Every key but the erased one.
+            auto copy_table(std::size_t live_keys, const key_entry* erased) const
+                -> SharedPointer<table>
+            {
+                SharedPointer<table> copied { new table(live_keys) };
+                for (const auto& slot: m_table->slots)
+                {
+                    if (slot.has_value() && &slot->entry() != erased)
+                    {
+                        copied->insert(*slot);
+                    }
+                }
+
+                return copied;
+            }
+
+            // Must be called with the parent state mutex locked. Returns the replaced table, for
+            // the caller to release.
+            auto replace_table(SharedPointer<table> replacement) -> SharedPointer<table>
+            {
+                std::lock_guard lock { m_table_mutex };
+                std::swap(replacement, m_table);
+                return replacement;
+            }
+
+            // It might be bad, but this is done on purpose.
+            // NOLINTNEXTLINE(cppcoreguidelines-avoid-const-or-ref-data-members)
+            state& m_parent_state;
+            SharedPointer<table> m_table;
+            // Only held to copy or replace the table pointer.
+            mutable Mutex m_table_mutex;
+            // Only touched with the parent state mutex locked.
+            std::size_t m_live_keys { 0 };
+        };
+
+        // Locks the parent state mutex until the signal of the key is connected.
+        template<std::size_t Index, class... ConnectArgs>
+        auto connect_key_impl(const key_type<Index>& key, ConnectArgs&&... connect_args) const
+            -> connection<SharedPointer>
+        {
+            auto& current_state { get_state() };
+
+            std::lock_guard lock { current_state.mutex };
+            auto* head { current_state.key_indices.load(std::memory_order_relaxed) };
+            for (auto* index { head }; index != nullptr; index = index->next)
+            {
+                if (index->position() == Index)
+                {
+                    return static_cast<key_index<Index>*>(index)->bucket(key).connect(
+                        std::forward<ConnectArgs>(connect_args)...);
+                }
+            }
+
+            auto* index { new key_index<Index>(current_state) };
+            index->next = head;
+            current_state.key_indices.store(index, std::memory_order_release);
+            return index->bucket(key).connect(std::forward<ConnectArgs>(connect_args)...);
+        }
+
+        auto get_state() const -> state&
+        {
+            auto* current_state { m_state.load(std::memory_order_acquire) };
+            if (current_state != nullptr)
+            {
+                return *current_state;
+            }
+
+            auto* new_state { new state() };
+            if (m_state.compare_exchange_strong(current_state,
+                                                new_state,
+                                                std::memory_order_acq_rel,
+                                                std::memory_order_acquire))
+            {
+                return *new_state;
+            }
+
+            // Another thread connected first.
+            delete new_state;
+            return *current_state;
+        }
+
+        // Changes since the last emission, whichever their number, are applied here at once rather
+        // than by each of them.
+        static auto copy_active_slots(state& current_state) -> SharedPointer<slot_list>
+        {
+            std::lock_guard lock { current_state.mutex };
+
+            if (current_state.outdated.exchange(false, std::memory_order_acq_rel))
+            {
+                update_active_slots(current_state);
+            }
+
+            return current_state.active_slots;
+        }
+
+        // Must be called with the state mutex locked. Fired single shot connections are removed
+        // from both lists.
+        static void update_active_slots(state& current_state)
+        {
+            SharedPointer<slot_list> slots { new slot_list() };
+            SharedPointer<slot_list> active_slots { new slot_list() };
+            slots->reserve(current_state.slots->size());
+            active_slots->reserve(current_state.slots->size());
+
+            for (const auto& holder: *current_state.slots)
+            {
+                if (holder->expired())
+                {
+                    holder->detach();
+                    continue;
+                }
+
+                slots->emplace_back(holder);
+                if (!holder->suspended())
+                {
+                    active_slots->emplace_back(holder);
+                }
+            }
+
+            std::swap(slots, current_state.slots);
+            std::swap(active_slots, current_state.active_slots);
+        }
+
+        // The lists a state let go of, released once its mutex is.
+        struct connection_lists
+        {
+            SharedPointer<slot_list> slots;
+            SharedPointer<slot_list> active_slots;
+        };
+
+        // For a signal whose owner erased it, or is destroyed. Its connections hold the owner,
+        // and may outlive it: they are detached, and the lists holding them are emptied, so that
+        // nothing holds the owner but connections still in use.
+        auto release_connections() const -> connection_lists
+        {
+            auto& released_state { get_state() };
+            connection_lists released { .slots = SharedPointer<slot_list>(new slot_list()),
+                                        .active_slots = SharedPointer<slot_list>(new slot_list()) };
+            {
+                std::lock_guard lock { released_state.mutex };
+                for (const auto& holder: *released_state.slots)
+                {
+                    holder->detach();
+                }
+
+                std::swap(released.slots, released_state.slots);
+                std::swap(released.active_slots, released_state.active_slots);
+                mark_outdated(released_state);
+            }
+
+            free_replaced_frozen(released_state);
+            return released;
+        }
+
+        // Connections changed. Set in this order, which freeze_slots relies on. The replaced
+        // list is only freed by free_replaced_frozen, which callers holding the state mutex call
+        // once it is released.
+        static void mark_outdated(state& current_state)
+        {
+            current_state.outdated.store(true, std::memory_order_seq_cst);
+            replace_frozen(current_state, nullptr);
+        }
+
+        // Whoever takes a list out keeps it until no emission reads any.
+        static void replace_frozen(state& current_state, frozen_list* replacement)
+        {
+            auto* replaced {
+                current_state.frozen.exchange(replacement, std::memory_order_seq_cst)
+            };
+            if (replaced != nullptr)
+            {
+                keep_replaced_frozen(current_state, replaced, replaced);
+            }
+        }
+
+        static void keep_replaced_frozen(state& current_state,
+                                         frozen_list* first,
+                                         frozen_list* last)
+        {
+            auto* next { current_state.replaced_frozen.load(std::memory_order_relaxed) };
+            do
+            {
+                last->next = next;
+            } while (!current_state.replaced_frozen.compare_exchange_weak(
+                next, first, std::memory_order_seq_cst, std::memory_order_relaxed));
+        }
+
+        // Emissions count themselves before reading the frozen list, so none of them may read a
+        // list replaced before the count was seen at zero. A list given back while an emission
+        // finished is looked at again.
+        static void free_replaced_frozen(state& current_state)
+        {
+            while (current_state.frozen_emissions.load(std::memory_order_seq_cst) == 0)
+            {
+                auto* replaced {
+                    current_state.replaced_frozen.exchange(nullptr, std::memory_order_seq_cst)
+                };
+                if (replaced == nullptr)
+                {
+                    return;
+                }
+
+                if (current_state.frozen_emissions.load(std::memory_order_seq_cst) == 0)
+                {
+                    while (replaced != nullptr)
+                    {
+                        delete std::exchange(replaced, replaced->next);
+                    }
+                    continue;
+                }
+
+                auto* last { replaced };
+                while (last->next != nullptr)
+                {
+                    last = last->next;
+                }
+                keep_replaced_frozen(current_state, replaced, last);
+            }
+        }
+
+        // An emission reading the frozen list.
+        class frozen_emission
+        {
+        public:
+            explicit frozen_emission(state& current_state):
+                m_state { current_state }
+            {
+                m_state.frozen_emissions.fetch_add(1, std::memory_order_seq_cst);
+            }
+
+            frozen_emission(const frozen_emission&) = delete;
+            frozen_emission(frozen_emission&&) = delete;
+
+            auto operator=(const frozen_emission&) -> frozen_emission& = delete;
+            auto operator=(frozen_emission&&) -> frozen_emission& = delete;
+
+            ~frozen_emission()
+            {
+                if (m_state.frozen_emissions.fetch_sub(1, std::memory_order_seq_cst) == 1)
+                {
+                    free_replaced_frozen(m_state);
+                }
+            }
+
+        private:
+            // NOLINTNEXTLINE(cppcoreguidelines-avoid-const-or-ref-data-members)
+            state& m_state;
+        };
+
+        static void freeze_slots(state& current_state)
+        {
+            {
+                std::lock_guard lock { current_state.mutex };
+
+                if (current_state.outdated.exchange(false, std::memory_order_acq_rel))
+                {
+                    update_active_slots(current_state);
+                }
+
+                const auto* frozen { current_state.frozen.load(std::memory_order_seq_cst) };
+                if (frozen == nullptr || frozen->slots != current_state.active_slots)
+                {
+                    replace_frozen(current_state, new frozen_list { current_state.active_slots });
+                }
+
+                // Connections may have changed since the update, without locking.
+                if (current_state.outdated.load(std::memory_order_seq_cst))
+                {
+                    replace_frozen(current_state, nullptr);
+                }
+            }
+
+            free_replaced_frozen(current_state);
+        }
+
+        // Freezes the signal if its emitter was frozen since it last followed it. Emitters that
+        // were never frozen don't even look at the state.
+        void follow_freezes(std::uint32_t freezes) const
+        {
+            if (freezes == 0)
+            {
+                return;
+            }
+
+            auto* current_state { m_state.load(std::memory_order_acquire) };
+            if (current_state != nullptr &&
+                current_state->followed_freezes.load(std::memory_order_relaxed) != freezes &&
+                current_state->followed_freezes.exchange(freezes, std::memory_order_relaxed) !=
+                    freezes)
+            {
+                freeze_slots(*current_state);
+            }
+        }
+
+        void disconnect(connection_holder_implementation* holder) const
+        {
+            auto& current_state { get_state() };
+
+            {
+                std::lock_guard lock { current_state.mutex };
+                SharedPointer<slot_list> slots { new slot_list() };
+
+                slots->reserve(current_state.slots->size());
+                std::ranges::copy_if(*current_state.slots,
+                                     std::back_inserter(*slots),
+                                     [holder](const auto& slot) { return slot.get() != holder; });
+
+                std::swap(slots, current_state.slots);
+                mark_outdated(current_state);
+            }
+
+            free_replaced_frozen(current_state);
+        }
+
+        // Counts the emission if it must be dropped.
+        static auto suppress_emission(state& current_state) -> bool
+        {
+            if (current_state.blocked.load(std::memory_order_relaxed) == 0)
+            {
+                return false;
+            }
+
+            current_state.suppressed_emissions.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+
+        // A connection was suspended, resumed, fired or disconnected. Counts may go down, which
+        // relies on unsigned wrap around. Counting comes last, as it may erase the signal of a
+        // key, which then lets go of its connections.
+        void connection_changed(std::ptrdiff_t connected_change,
+                                std::ptrdiff_t active_change) const
+        {
+            auto& current_state { get_state() };
+            mark_outdated(current_state);
+            free_replaced_frozen(current_state);
+            count_connections(current_state, connected_change, active_change);
+        }
+
+        // Signals of keys also count in the signal they are a key of.
+        static void count_connections(state& current_state,
+                                      std::ptrdiff_t connected_change,
+                                      std::ptrdiff_t active_change)
+        {
+            const auto change { static_cast<std::size_t>(connected_change) };
+            for (auto* counted { &current_state }; counted != nullptr; counted = counted->parent)
+            {
+                const auto previous_count { counted->connected_count.fetch_add(
+                    change, std::memory_order_acq_rel) };
+                counted->active_count.fetch_add(static_cast<std::size_t>(active_change),
+                                                std::memory_order_relaxed);
+
+                const bool changed_emptiness { change != 0 && (previous_count == 0 ||
+                                                               previous_count + change == 0) };
+                if (counted->observer != nullptr && changed_emptiness)
+                {
+                    counted->observer->connections_changed();
+                }
+            }
+        }
+
+        void observe_connections(connection_observer& observer) const
+        {
+            get_state().observer = &observer;
+        }
+
+        // Set before the first connection, and never changed afterwards.
+        void set_owner(const SharedPointer<signal_owner>& owner) const
+        {
+            get_state().owner = typename SharedPointer<signal_owner>::weak_type { owner };
+        }
+
+        void add_emitting_source(connection<SharedPointer> source) const
+        {
+            auto& current_state { get_state() };
+
+            std::lock_guard lock { current_state.mutex };
+            current_state.emitting_sources.emplace_back(std::move(source));
+        }
+
+        mutable std::atomic<state*> m_state { nullptr };
+    };
+
+    // ### Signal with results definition
+
+    // Made of a plain signal, whose connections give the results of their callable to the sink
+    // of the current emission.
+    template<basic_lockable Mutex, template<class> class SharedPointer>
+        requires shared_pointer_like<SharedPointer>
+    template<class Result, signal_arg... Args>
+    class emitter<Mutex, SharedPointer>::signal<Result(Args...)> final
+    {
+    public:
+        using connection_type = connection<SharedPointer>;
+        using args = std::tuple<Args...>;
+        using result_type = Result;
+        using slot = std::function<Result(Args...)>;
+
+        friend emitter;
+
+        template<class Callable, class... ConnectArgs>
+            requires(!std::is_member_function_pointer_v<std::remove_cvref_t<Callable>> &&
+                     partially_callable_returning<Callable, Result, Args...>)
+        auto connect(Callable&& callable, ConnectArgs&&... connect_args) const
+            -> connection<SharedPointer>
+        {
+            return m_signal.connect(
+                result_lambda<ConnectArgs...>(std::forward<Callable>(callable)),
+                std::forward<ConnectArgs>(connect_args)...);
+        }
+
+        template<class Callable, class... ConnectArgs>
+            requires(!std::is_member_function_pointer_v<std::remove_cvref_t<Callable>> &&
+                     partially_callable_returning<Callable, Result, Args...>)
+        auto connect_once(Callable&& callable, ConnectArgs&&... connect_args) const
+            -> connection<SharedPointer>
+        {
+            return m_signal.connect_once(
+                result_lambda<ConnectArgs...>(std::forward<Callable>(callable)),
+                std::forward<ConnectArgs>(connect_args)...);
+        }
+
+        template<class Receiver, class MemberFunction, class... ConnectArgs>
+            requires(guard_like<std::remove_const_t<Receiver>> &&
+                     std::is_member_function_pointer_v<MemberFunction> &&
+                     partially_callable_returning<MemberFunction, Result, Receiver&, Args...>)
+        auto connect(MemberFunction member_function,
+                     Receiver& guard,
+                     ConnectArgs&&... connect_args) const -> connection<SharedPointer>
+        {
+            return m_signal.connect(
+                result_lambda<ConnectArgs...>(member_function_lambda(member_function, guard)),
+                guard,
+                std::forward<ConnectArgs>(connect_args)...);
+        }
+
+        template<class Receiver, class MemberFunction, class... ConnectArgs>
+            requires(guard_like<std::remove_const_t<Receiver>> &&
+                     std::is_member_function_pointer_v<MemberFunction> &&
+                     partially_callable_returning<MemberFunction, Result, Receiver&, Args...>)
+        auto connect_once(MemberFunction member_function,
+                          Receiver& guard,
+                          ConnectArgs&&... connect_args) const -> connection<SharedPointer>
+        {
+            return m_signal.connect_once(
+                result_lambda<ConnectArgs...>(member_function_lambda(member_function, guard)),
+                guard,
+                std::forward<ConnectArgs>(connect_args)...);
+        }
+
+        void block() const
+        {
+            m_signal.block();
+        }
+
+        void unblock() const
+        {
+            m_signal.unblock();
+        }
+
+        auto blocked() const -> bool
+        {
+            return m_signal.blocked();
+        }
+
+        auto suppressed_emissions() const -> std::size_t
+        {
+            return m_signal.suppressed_emissions();
+        }
+
+        auto has_active_slots() const -> bool
+        {
+            return m_signal.has_active_slots();
+        }
+
+        auto slot_count() const -> std::size_t
+        {
+            return m_signal.slot_count();
+        }
+
+        void freeze() const
+        {
+            m_signal.freeze();
+        }
+
+        auto frozen() const -> bool
+        {
+            return m_signal.frozen();
+        }
+
+    private:
+        void follow_freezes(std::uint32_t freezes) const
+        {
+            m_signal.follow_freezes(freezes);
+        }
+
+        // Results are dropped, even if a combining emission of this signal is running further up
+        // the stack.
+        template<class... EmittedArgs>
+            requires std::invocable<slot, EmittedArgs&&...>
+        void emit(EmittedArgs&&... emitted_args) const
+        {
+            discarding_sink<Result> sink { this };
+            m_signal.emit(std::forward<EmittedArgs>(emitted_args)...);
+        }
+
+        template<class Combiner, class... EmittedArgs>
+        void emit_combined(Combiner& combiner, EmittedArgs&&... emitted_args) const
+        {
+            combining_sink<Result, Combiner> sink { this, combiner };
+            // Short-circuiting combiners stop the emission once they are satisfied.
+            m_signal.emit_until([&combiner] { return std::as_const(combiner).done(); },
+                                std::forward<EmittedArgs>(emitted_args)...);
+        }
+
+        template<class Receiver, class MemberFunction>
+        static auto member_function_lambda(MemberFunction member_function, Receiver& guard)
+        {
+            return [&guard, member_function]<class... CallArgs>(CallArgs&&... call_args)
+                requires partially_callable<MemberFunction, Receiver&, CallArgs...>
+            { return partial_call(member_function, guard, std::forward<CallArgs>(call_args)...); };
+        }
+
+        // Asynchronous slots don't run during the emission that called them, so their results
+        // are always dropped.
+        template<class... ConnectArgs, class Callable>
+        auto result_lambda(Callable&& callable) const
+        {
+            return [callable = std::forward<Callable>(callable),
+                    source = this]<class... CallArgs>(CallArgs&&... call_args) mutable
+                requires partially_callable<Callable&, CallArgs...>
+            {
+                auto* sink { (asynchronous_policy<ConnectArgs> || ...)
+                                 ? nullptr
+                                 : result_sink<Result>::current(source) };
+                if (sink == nullptr)
+                {
+                    partial_call(callable, std::forward<CallArgs>(call_args)...);
+                    return;
+                }
+
+                if (!sink->done())
+                {
+                    sink->accept(partial_call(callable, std::forward<CallArgs>(call_args)...));
+                }
+            };
+        }
+
+        signal<Args...> m_signal;
+    };
+
+    template<std::derived_from<chainable> Chainable,
+             class Callable,
+             class Guard,
+             execution_policy Policy>
+        requires(std::same_as<void, Guard> || guard_like<Guard>)
+    class chain
+    {
+    public:
+        chain(Chainable&& chainable, const connect<Callable, Guard, Policy>& connect):
+            m_chainable { std::forward<Chainable>(chainable) },
+            m_connect { std::move(connect) }
+        {
+        }
+
+        template<source_like Source>
+        friend auto operator|(Source&& source, chain& chain)
+        {
+            return std::forward<Source>(source) | chain.m_chainable | chain.m_connect;
+        }
+
+    private:
+        std::remove_cvref_t<Chainable> m_chainable;
+        connect<Callable, Guard, Policy> m_connect;
+    };
+
+    template<std::derived_from<chainable> Chainable,
+             class Receiver,
+             signal_like<Receiver> Signal,
+             details::execution_policy Policy>
+    class chain<Chainable, Signal Receiver::*, void, Policy>
+    {
+    public:
+        chain(Chainable&& chainable,
+              const forward_result<Receiver, Signal Receiver::*, Policy>& connect_result):
+            m_chainable { std::forward<Chainable>(chainable) },
+            m_connect_result { std::move(connect_result) }
+        {
+        }
+
+        template<source_like Source>
+        friend auto operator|(Source&& source, chain& chain)
+        {
+            return std::forward<Source>(source) | chain.m_chainable | chain.m_connect_result;
+        }
+
+    private:
+        std::remove_cvref_t<Chainable> m_chainable;
+        forward_result<Receiver, Signal Receiver::*, Policy> m_connect_result;
+    };
+
+} // namespace details
+
+class chainable
+{
+public:
+    template<class Self, std::derived_from<chainable> OtherChainable>
+    auto operator|(this Self&& self, OtherChainable&& other);
+
+    template<class Self, class Callable, class Guard, details::execution_policy Policy>
+        requires(std::same_as<void, Guard> || guard_like<Guard>)
+    auto operator|(this Self&& self, const connect<Callable, Guard, Policy>& connect)
+        -> details::chain<Self, Callable, Guard, Policy>
+    {
+        return { std::forward<Self>(self), connect };
+    }
+
+    template<class Self,
+             class Receiver,
+             details::signal_like<Receiver> Signal,
+             details::execution_policy Policy>
+    auto operator|(
+        this Self&& self,
+        const details::forward_result<Receiver, Signal Receiver::*, Policy>& connect_result)
+        -> details::chain<Self, Signal Receiver::*, void, Policy>
+    {
+        return { std::forward<Self>(self), connect_result };
+    }
+};
+
+namespace details
+{
+    template<std::derived_from<chainable> Lhs, std::derived_from<chainable> Rhs>
+    class composed_chainable: public chainable
+    {
+    public:
+        composed_chainable(Lhs&& lhs, Rhs&& rhs):
+            m_lhs { std::forward<Lhs>(lhs) },
+            m_rhs { std::forward<Rhs>(rhs) }
+        {
+        }
+
+        template<source_like Source>
+        friend auto operator|(Source&& source, composed_chainable& composed_chainable)
+        {
+            return (std::forward<Source>(source) | composed_chainable.m_lhs) |
+                   composed_chainable.m_rhs;
+        }
+
+    private:
+        Lhs m_lhs;
+        Rhs m_rhs;
+    };
+} // namespace details
+
+template<class Self, std::derived_from<chainable> OtherChainable>
+auto chainable::operator|(this Self&& self, OtherChainable&& other)
+{
+    return details::composed_chainable { std::forward<Self>(self),
+                                         std::forward<OtherChainable>(other) };
+}
+
+// ### class map
+
+namespace details
+{
+    template<class Source, std::size_t... Indexes>
+    concept valid_map = requires {
+        ::source_like<Source>;
+        (in_tuple_range<Indexes, typename std::remove_cvref_t<Source>::args> && ...);
+        all_different<Indexes...>;
+    };
+
+    template<::source_like Source, std::size_t... Indexes>
+        requires(valid_map<Source, Indexes...>)
+    class mapped_source: public std::remove_cvref_t<Source>::connectable_type
+    {
+    public:
+        friend std::remove_cvref_t<Source>::connectable_type;
+
+        using args = std::tuple<
+            std::tuple_element_t<Indexes, typename std::remove_cvref_t<Source>::args>...>;
+
+        explicit mapped_source(Source&& origin):
+            m_source { std::forward<Source>(origin) }
+        {
+        }
+
+    private:
+        template<partially_callable<
+            std::tuple_element_t<Indexes, typename std::remove_cvref_t<Source>::args>...> Callable>
+        auto forwarding_lambda(Callable&& callable) const
+        {
+            return
+                // Clang-tidy doesn't seem to understand template parameter pack indexing.
+                // NOLINTNEXTLINE(cppcoreguidelines-missing-std-forward)
+                [callable = std::forward<Callable>(callable)]<class... Args>(Args&&... args) mutable
+                requires partially_callable<std::decay_t<Callable>&, Args...[Indexes]...>
+            {
+                partial_call(callable,
+                             std::forward<decltype(args...[Indexes])>(args...[Indexes])...);
+            };
+        }
+
+        Source m_source;
+    };
+} // namespace details
+
+template<std::size_t... Indexes>
+    requires details::all_different<Indexes...>
+class map: public chainable
+{
+public:
+    template<source_like Source>
+    auto accept(Source&& origin) -> details::mapped_source<Source, Indexes...>
+    {
+        return details::mapped_source<Source, Indexes...> { std::forward<Source>(origin) };
+    }
+};
+
+// ### class transform
+
+namespace details
+{
+    template<class Source, class... Transformations>
+    concept valid_transformations = requires(Transformations... transformations,
+                                             typename std::remove_cvref_t<Source>::args args) {
+        ::source_like<Source>;
+        [transformations,
+         args]<std::size_t... Indexes>(const std::index_sequence<Indexes...>&) constexpr
+            requires(
+                (std::invocable<
+                     Transformations...[Indexes],
+                     std::tuple_element_t<Indexes, typename std::remove_cvref_t<Source>::args>> &&
+                 ...) &&
+                (not_void<std::invoke_result_t<
+                     Transformations...[Indexes],
+                     std::tuple_element_t<Indexes, typename std::remove_cvref_t<Source>::args>>> &&
+                 ...)) {}(std::make_index_sequence<sizeof...(Transformations)> {});
+    };
+
+    template<class Tuple, class... Transformations>
+    struct transformed_source_args;
+
+    template<class Tuple, class... Transformations>
+    using transformed_source_args_t = transformed_source_args<Tuple, Transformations...>::type;
+
+    template<class... Args, class... Transformations>
+    struct transformed_source_args<std::tuple<Args...>, Transformations...>
+    {
+        using type = std::tuple<std::invoke_result_t<Transformations, Args>...>;
+    };
+
+    template<::source_like Source, class... Transformations>
+        requires(valid_transformations<Source, Transformations...>)
+    class transformed_source: public std::remove_cvref_t<Source>::connectable_type
+    {
+    public:
+        friend std::remove_cvref_t<Source>::connectable_type;
+
+        using args = transformed_source_args_t<typename std::remove_cvref_t<Source>::args,
+                                               Transformations...>;
+
+        transformed_source(Source&& origin, std::tuple<Transformations...> transformations):
+            m_source { std::forward<Source>(origin) },
+            m_transformations { std::move(transformations) }
+        {
+        }
+
+    private:
+        template<partially_tuple_callable<args> Callable>
+        auto forwarding_lambda(Callable&& callable) const
+        {
+            return [callable = std::forward<Callable>(callable),
+                    transformations = m_transformations]<class... Args>(Args&&... args) mutable
+                requires partially_callable<std::decay_t<Callable>&,
+                                            std::invoke_result_t<Transformations&, Args>...>
+            {
+                auto& [... transformationsCallable] { transformations };
+                return partial_call(callable, transformationsCallable(std::forward<Args>(args))...);
+            };
+        }
+
+        Source m_source;
+        std::tuple<Transformations...> m_transformations;
+    };
+
+    template<class Source, class... Transformations>
+    transformed_source(Source&&, std::tuple<Transformations...>)
+        -> transformed_source<Source, Transformations...>;
+} // namespace details
+
+template<class... Transformations>
+class transform: public chainable
+{
+private:
+    template<std::size_t>
+    using identity = std::identity;
+
+public:
+    explicit transform(Transformations... transformations):
+        m_transformations { std::forward<Transformations>(transformations)... }
+    {
+    }
+
+    template<source_like Source>
+    auto accept(Source&& origin)
+    {
+        static constexpr std::make_index_sequence<
+            std::tuple_size_v<typename std::remove_cvref_t<Source>::args> -
+            sizeof...(Transformations)>
+            index_sequence {};
+
+        auto [... identities] { create_identities(index_sequence) };
+        auto& [... transformations] { m_transformations };
+
+        return details::transformed_source { std::forward<Source>(origin),
+                                             std::make_tuple(transformations..., identities...) };
+    }
+
+private:
+    template<std::size_t... Indexes>
+    static constexpr auto create_identities(const std::index_sequence<Indexes...>&)
+    {
+        return std::make_tuple(identity<Indexes> {}...);
+    }
+
+    std::tuple<Transformations...> m_transformations;
+};
+
+// ### class filter
+
+namespace details
+{
+    template<class Source, class Filter>
+    concept valid_filter = requires {
+        ::source_like<Source>;
+        partially_tuple_callable<Filter, typename std::remove_cvref_t<Source>::args>;
+        std::convertible_to<decltype(partial_tuple_call(
+                                std::declval<Filter>(),
+                                std::declval<typename std::remove_cvref_t<Source>::args>())),
+                            bool>;
+    };
+
+    template<::source_like Source,
+             partially_tuple_callable<typename std::remove_cvref_t<Source>::args> Filter>
+        requires valid_filter<Source, Filter>
+    class filtered_source: public std::remove_cvref_t<Source>::connectable_type
+    {
+    public:
+        friend std::remove_cvref_t<Source>::connectable_type;
+
+        using args = typename std::remove_cvref_t<Source>::args;
+
+        filtered_source(Source&& origin, Filter filter):
+            m_source { std::forward<Source>(origin) },
+            m_filter { std::move(filter) }
+        {
+        }
+
+    private:
+        template<partially_tuple_callable<args> Callable>
+        auto forwarding_lambda(Callable&& callable) const
+        {
+            return [callable = std::forward<Callable>(callable),
+                    filter = m_filter]<class... Args>(Args&&... args) mutable
+                requires(partially_callable<Filter&, Args&...> &&
+                         partially_callable<std::decay_t<Callable>&, Args...>)
+            {
+                if (static_cast<bool>(partial_call(filter, args...)))
+                {
+                    partial_call(callable, std::forward<Args>(args)...);
+                }
+            };
+        }
+
+        Source m_source;
+        Filter m_filter;
+    };
+} // namespace details
+
+template<class Filter>
+class filter: public chainable
+{
+public:
+    explicit filter(Filter filter):
+        m_filter { std::move(filter) }
+    {
+    }
+
+    template<source_like Source>
+    auto accept(Source&& origin) -> details::filtered_source<Source, Filter>
+    {
+        return { std::forward<Source>(origin), m_filter };
+    }
+
+private:
+    Filter m_filter;
+};
+
+// ### class take, skip, take_while and take_until
+
+namespace details
+{
+    // Sources whose connections are held by std::shared_ptr belong to thread safe emitters.
+    template<template<class> class SharedPointer>
+    struct shared_pointer_mutex
+    {
+        using type = std::mutex;
+    };
+
+    template<>
+    struct shared_pointer_mutex<unsafe_shared_pointer>
+    {
+        using type = fake_mutex;
+    };
+
+    // Counts calls, whatever the threads making them. Copies start from the copied count.
+    class call_counter
+    {
+    public:
+        call_counter() = default;
+
+        call_counter(const call_counter& other):
+            m_count { other.m_count.load(std::memory_order_relaxed) }
+        {
+        }
+
+        auto operator=(const call_counter&) -> call_counter& = delete;
+        auto operator=(call_counter&&) -> call_counter& = delete;
+
+        ~call_counter() = default;
+
+        // The number of calls before this one.
+        auto count_call() -> std::size_t
+        {
+            return m_count.fetch_add(1, std::memory_order_relaxed);
+        }
+
+    private:
+        std::atomic<std::size_t> m_count { 0 };
+    };
+
+    // Open until closed, whatever the threads. Copies start in the state of the copied gate.
+    class gate
+    {
+    public:
+        gate() = default;
+
+        gate(const gate& other):
+            m_open { other.m_open.load(std::memory_order_relaxed) }
+        {
+        }
+
+        auto operator=(const gate&) -> gate& = delete;
+        auto operator=(gate&&) -> gate& = delete;
+
+        ~gate() = default;
+
+        auto is_open() const -> bool
+        {
+            return m_open.load(std::memory_order_acquire);
+        }
+
+        // Whether this call closed it.
+        auto close() -> bool
+        {
+            return m_open.exchange(false, std::memory_order_acq_rel);
+        }
+
+    private:
+        std::atomic<bool> m_open { true };
+    };
+
+    enum class count_limit
+    {
+        take,
+        skip
+    };
+
+    // Each connection counts its own calls. take expires the connection with its last call.
+    template<::source_like Source, count_limit Limit>
+    class counted_source: public std::remove_cvref_t<Source>::connectable_type
+    {
+    public:
+        friend std::remove_cvref_t<Source>::connectable_type;
+
+        using args = typename std::remove_cvref_t<Source>::args;
+
+        counted_source(Source&& origin, std::size_t count):
+            m_source { std::forward<Source>(origin) },
+            m_count { count }
+        {
+        }
+
+    private:
+        template<partially_tuple_callable<args> Callable>
+        auto forwarding_lambda(Callable&& callable) const
+        {
+            return [callable = std::forward<Callable>(callable),
+                    count = m_count,
+                    calls = call_counter {}]<class... Args>(Args&&... args) mutable
+                requires partially_callable<std::decay_t<Callable>&, Args...>
+            {
+                const auto call { calls.count_call() };
+                if constexpr (Limit == count_limit::take)
+                {
+                    if (call + 1 == std::max(count, std::size_t { 1 }))
+                    {
+                        running_connection::expire();
+                    }
+                    if (call >= count)
+                    {
+                        return;
+                    }
+                }
+                else if (call < count)
+                {
+                    return;
+                }
+
+                partial_call(callable, std::forward<Args>(args)...);
+            };
+        }
+
+        Source m_source;
+        std::size_t m_count;
+    };
+
+    template<class Source, class Predicate>
+    concept valid_take_while = requires {
+        requires ::source_like<Source>;
+        requires partially_tuple_callable<Predicate&, typename std::remove_cvref_t<Source>::args>;
+        requires std::convertible_to<
+            decltype(partial_tuple_call(
+                std::declval<Predicate&>(),
+                std::declval<typename std::remove_cvref_t<Source>::args>())),
+            bool>;
+    };
+
+    // Each connection forwards emissions until the predicate is false for one of them.
+    template<::source_like Source, class Predicate>
+        requires valid_take_while<Source, Predicate>
+    class take_while_source: public std::remove_cvref_t<Source>::connectable_type
+    {
+    public:
+        friend std::remove_cvref_t<Source>::connectable_type;
+
+        using args = typename std::remove_cvref_t<Source>::args;
+
+        take_while_source(Source&& origin, Predicate predicate):
+            m_source { std::forward<Source>(origin) },
+            m_predicate { std::move(predicate) }
+        {
+        }
+
+    private:
+        template<partially_tuple_callable<args> Callable>
+        auto forwarding_lambda(Callable&& callable) const
+        {
+            return [callable = std::forward<Callable>(callable),
+                    predicate = m_predicate,
+                    open = gate {}]<class... Args>(Args&&... args) mutable
+                requires(partially_callable<Predicate&, Args&...> &&
+                         partially_callable<std::decay_t<Callable>&, Args...>)
+            {
+                if (!open.is_open())
+                {
+                    return;
+                }
+
+                if (!static_cast<bool>(partial_call(predicate, args...)))
+                {
+                    if (open.close())
+                    {
+                        running_connection::expire();
+                    }
+                    return;
+                }
+
+                partial_call(callable, std::forward<Args>(args)...);
+            };
+        }
+
+        Source m_source;
+        Predicate m_predicate;
+    };
+
+    template<class Source, class Notifier>
+    concept valid_take_until =
+        ::source_like<Source> && ::source_like<Notifier> &&
+        std::same_as<typename std::remove_cvref_t<Source>::connectable_type,
+                     typename std::remove_cvref_t<Notifier>::connectable_type>;
+
+    template<class Source,
+             class Notifier,
+             class Connectable = typename std::remove_cvref_t<Source>::connectable_type>
+    class take_until_source;
+
+    // Each connection forwards emissions until the notifier emits. It connects to the notifier
+    // itself, and that connection goes away with it. The notifier ends the connection as soon
+    // as it emits.
+    template<class Source, class Notifier, template<class> class SharedPointer>
+    class take_until_source<Source, Notifier, connectable<SharedPointer>>
+        : public connectable<SharedPointer>
+    {
+        // Only weakly held by the notifier connection.
+        struct until_state
+        {
+            // Called by the notifier, while emitting: the connection is retired, like those
+            // of a disconnected group, and removed by its signal.
+            void close()
+            {
+                if (!open.close())
+                {
+                    return;
+                }
+
+                std::optional<connection<SharedPointer>> closed;
+                {
+                    std::lock_guard lock { mutex };
+                    closed = running;
+                }
+                if (closed.has_value())
+                {
+                    closed->with_holder([](connection_holder& holder) { holder.retire(); });
+                }
+            }
+
+            // The notifier may have emitted while connecting.
+            void bind(connection<SharedPointer> made)
+            {
+                {
+                    std::lock_guard lock { mutex };
+                    running = made;
+                }
+                if (!open.is_open())
+                {
+                    made.disconnect();
+                }
+            }
+
+            gate open;
+            typename shared_pointer_mutex<SharedPointer>::type mutex;
+            std::optional<connection<SharedPointer>> running;
+            std::optional<scoped_connection<SharedPointer>> notifier_connection;
+        };
+
+        // Given the state by the forwarding lambda, then the connection made with it.
+        struct bind_target
+        {
+            void bind(const connection<SharedPointer>& made) const
+            {
+                state->bind(made);
+            }
+
+            SharedPointer<until_state> state;
+        };
+
+    public:
+        friend connectable<SharedPointer>;
+
+        using args = typename std::remove_cvref_t<Source>::args;
+
+        take_until_source(Source&& origin, const Notifier& notifier):
+            m_source { std::forward<Source>(origin) },
+            m_notifier { notifier }
+        {
+        }
+
+    private:
+        template<partially_tuple_callable<args> Callable>
+        auto forwarding_lambda(Callable&& callable, bind_target& target) const
+        {
+            SharedPointer<until_state> state { new until_state() };
+            state->notifier_connection.emplace(m_notifier.connect_once(
+                [weak_state = typename SharedPointer<until_state>::weak_type { state }]
+                {
+                    auto locked_state { weak_state.lock() };
+                    if (locked_state)
+                    {
+                        locked_state->close();
+                    }
+                }));
+            target.state = state;
+
+            return [callable = std::forward<Callable>(callable),
+                    state = std::move(state)]<class... Args>(Args&&... args) mutable
+                requires partially_callable<std::decay_t<Callable>&, Args...>
+            {
+                if (!state->open.is_open())
+                {
+                    running_connection::expire();
+                    return;
+                }
+
+                partial_call(callable, std::forward<Args>(args)...);
+            };
+        }
+
+        Source m_source;
+        Notifier m_notifier;
+    };
+} // namespace details
+
+// Forwards the first count emissions of each connection, which then ends.
+class take: public chainable
+{
+public:
+    explicit take(std::size_t count):
+        m_count { count }
+    {
+    }
+
+    template<source_like Source>
+    auto accept(Source&& origin) -> details::counted_source<Source, details::count_limit::take>
+    {
+        return { std::forward<Source>(origin), m_count };
+    }
+
+private:
+    std::size_t m_count;
+};
+
+// Drops the first count emissions of each connection.
+class skip: public chainable
+{
+public:
+    explicit skip(std::size_t count):
+        m_count { count }
+    {
+    }
+
+    template<source_like Source>
+    auto accept(Source&& origin) -> details::counted_source<Source, details::count_limit::skip>
+    {
+        return { std::forward<Source>(origin), m_count };
+    }
+
+private:
+    std::size_t m_count;
+};
+
+// Forwards emissions while the predicate holds. The first emission for which it doesn't ends
+// the connection.
+template<class Predicate>
+class take_while: public chainable
+{
+public:
+    explicit take_while(Predicate predicate):
+        m_predicate { std::move(predicate) }
+    {
+    }
+
+    template<source_like Source>
+        requires details::valid_take_while<Source, Predicate>
+    auto accept(Source&& origin) -> details::take_while_source<Source, Predicate>
+    {
+        return { std::forward<Source>(origin), m_predicate };
+    }
+
+private:
+    Predicate m_predicate;
+};
+
+// Forwards emissions until the notifier emits.
+template<class Notifier>
+class take_until: public chainable
+{
+public:
+    explicit take_until(Notifier&& notifier):
+        m_notifier { std::forward<Notifier>(notifier) }
+    {
+    }
+
+    template<source_like Source>
+        requires details::valid_take_until<Source, Notifier>
+    auto accept(Source&& origin) -> details::take_until_source<Source, Notifier>
+    {
+        return { std::forward<Source>(origin), m_notifier };
+    }
+
+private:
+    Notifier m_notifier;
+};
+
+template<class Notifier>
+take_until(Notifier&&) -> take_until<Notifier>;
+
+// ### class share
+
+namespace details
+{
+    // Emits Args to every connection of a staged source, from what its source emits. It is
+    // connected to its source only while it has connections itself, and that upstream
+    // connection keeps it alive. Stage decides in receive what is emitted, and when.
+    template<class Stage, class Source, template<class> class SharedPointer, class... Args>
+    class shared_stage<Stage, Source, std::tuple<Args...>, connectable<SharedPointer>>
+        : public emitter<typename shared_pointer_mutex<SharedPointer>::type, SharedPointer>,
+          public connection_observer
+    {
+        using stage_emitter =
+            emitter<typename shared_pointer_mutex<SharedPointer>::type, SharedPointer>;
+        using source_args = typename std::remove_cvref_t<Source>::args;
+
+    public:
+        using args = std::tuple<Args...>;
+        using connectable_type = connectable<SharedPointer>;
+        using stage_pointer = SharedPointer<Stage>;
+
+        shared_stage(const shared_stage&) = delete;
+        shared_stage(shared_stage&&) = delete;
+
+        auto operator=(const shared_stage&) -> shared_stage& = delete;
+        auto operator=(shared_stage&&) -> shared_stage& = delete;
+
+        template<class... StageArgs>
+        static auto create(Source&& origin, StageArgs&&... stage_args) -> stage_pointer
+        {
+            stage_pointer stage { new Stage(std::forward<Source>(origin),
+                                            std::forward<StageArgs>(stage_args)...) };
+            stage->m_self = typename stage_pointer::weak_type { stage };
+            stage->stage_signal.observe_connections(*stage);
+            return stage;
+        }
+
+        void connections_changed() override
+        {
+            std::lock_guard lock { m_mutex };
+
+            const bool connected { stage_signal.slot_count() != 0 };
+            if (connected == m_upstream.has_value())
+            {
+                return;
+            }
+
+            if (!connected)
+            {
+                m_upstream->disconnect();
+                m_upstream.reset();
+                return;
+            }
+
+            m_upstream.emplace(m_source.connect(
+                [stage = m_self.lock()]<class... EmittedArgs>(EmittedArgs&&... emitted_args)
+                    requires(sizeof...(EmittedArgs) == std::tuple_size_v<source_args>)
+                { stage->receive(std::forward<EmittedArgs>(emitted_args)...); }));
+        }
+
+        // It might be bad, but this is done on purpose.
+        // NOLINTNEXTLINE(misc-non-private-member-variables-in-classes)
+        typename stage_emitter::template signal<Args...> stage_signal;
+
+    protected:
+        using mutex_type = typename shared_pointer_mutex<SharedPointer>::type;
+
+        explicit shared_stage(Source&& origin):
+            m_source { std::forward<Source>(origin) }
+        {
+        }
+
+        ~shared_stage() = default;
+
+        template<class... EmittedArgs>
+        void publish(EmittedArgs&&... emitted_args) const
+        {
+            this->emit(&shared_stage::stage_signal, std::forward<EmittedArgs>(emitted_args)...);
+        }
+
+        auto self() const -> stage_pointer
+        {
+            return m_self.lock();
+        }
+
+    private:
+        Source m_source;
+        typename stage_pointer::weak_type m_self;
+        std::optional<connection<SharedPointer>> m_upstream;
+        mutex_type m_mutex;
+    };
+
+    // Runs the transformations of its source once per emission, for all the connections of a
+    // shared source.
+    template<class Source>
+    class multicast_stage final: public shared_stage<multicast_stage<Source>, Source>
+    {
+        using base = shared_stage<multicast_stage<Source>, Source>;
+
+    public:
+        friend base;
+
+    private:
+        explicit multicast_stage(Source&& origin):
+            base { std::forward<Source>(origin) }
+        {
+        }
+
+        template<class... EmittedArgs>
+        void receive(EmittedArgs&&... emitted_args) const
+        {
+            this->publish(std::forward<EmittedArgs>(emitted_args)...);
+        }
+    };
+
+    // Connections are made to the signal of the stage, which gets its source emissions.
+    template<class Stage, class Connectable = typename Stage::connectable_type>
+    class staged_source;
+
+    template<class Stage, template<class> class SharedPointer>
+    class staged_source<Stage, connectable<SharedPointer>>: public connectable<SharedPointer>
+    {
+    public:
+        friend connectable<SharedPointer>;
+
+        using args = typename Stage::args;
+
+        explicit staged_source(SharedPointer<Stage> stage):
+            m_stage { std::move(stage) },
+            m_source { m_stage->stage_signal }
+        {
+        }
+
+    private:
+        template<partially_tuple_callable<args> Callable>
+        auto forwarding_lambda(Callable&& callable) const
+        {
+            return std::forward<Callable>(callable);
+        }
+
+        SharedPointer<Stage> m_stage;
+        // It might be bad, but this is done on purpose.
+        // NOLINTNEXTLINE(cppcoreguidelines-avoid-const-or-ref-data-members)
+        const decltype(Stage::stage_signal)& m_source;
+    };
+} // namespace details
+
+class share: public chainable
+{
+public:
+    template<source_like Source>
+    auto accept(Source&& origin) -> details::staged_source<details::multicast_stage<Source>>
+    {
+        return details::staged_source<details::multicast_stage<Source>> {
+            details::multicast_stage<Source>::create(std::forward<Source>(origin))
+        };
+    }
+};
+
+// ### class distinct_until_changed
+
+namespace details
+{
+    // The emission itself: its only argument, or a tuple of them.
+    struct emission_value
+    {
+        template<class Arg>
+        auto operator()(const Arg& arg) const -> std::decay_t<Arg>
+        {
+            return arg;
+        }
+
+        template<class... Args>
+            requires(sizeof...(Args) != 1)
+        auto operator()(const Args&... args) const -> std::tuple<std::decay_t<Args>...>
+        {
+            return { args... };
+        }
+    };
+
+    template<class Source, class Projection>
+    using projection_t = decltype(partial_tuple_call(
+        std::declval<const Projection&>(),
+        std::declval<typename std::remove_cvref_t<Source>::args>()));
+
+    template<class Source, class Projection, class Equal>
+    concept valid_distinct =
+        ::source_like<Source> &&
+        partially_tuple_callable<const Projection&, typename std::remove_cvref_t<Source>::args> &&
+        std::predicate<const Equal&,
+                       const projection_t<Source, Projection>&,
+                       const projection_t<Source, Projection>&>;
+
+    // Emits an emission only when its projection differs from the one of the previous emission.
+    template<class Source, class Projection, class Equal>
+        requires valid_distinct<Source, Projection, Equal>
+    class distinct_stage final
+        : public shared_stage<distinct_stage<Source, Projection, Equal>, Source>
+    {
+        using base = shared_stage<distinct_stage<Source, Projection, Equal>, Source>;
+
+    public:
+        friend base;
+
+    private:
+        distinct_stage(Source&& origin, Projection projection, Equal equal):
+            base { std::forward<Source>(origin) },
+            m_projection { std::move(projection) },
+            m_equal { std::move(equal) }
+        {
+        }
+
+        template<class... EmittedArgs>
+        void receive(EmittedArgs&&... emitted_args)
+        {
+            {
+                std::lock_guard lock { m_mutex };
+
+                auto projection { partial_call(m_projection, std::as_const(emitted_args)...) };
+                if (m_last.has_value() &&
+                    std::invoke(m_equal, std::as_const(*m_last), std::as_const(projection)))
+                {
+                    return;
+                }
+                m_last = std::move(projection);
+            }
+
+            this->publish(std::forward<EmittedArgs>(emitted_args)...);
+        }
+
+        Projection m_projection;
+        Equal m_equal;
+        std::optional<projection_t<Source, Projection>> m_last;
+        typename base::mutex_type m_mutex;
+    };
+} // namespace details
+
+// Emits an emission only when it differs from the previous one. The projection picks what is
+// compared, the emission itself by default.
+template<class Projection = details::emission_value, class Equal = std::equal_to<>>
+class distinct_until_changed: public chainable
+{
+public:
+    explicit distinct_until_changed(Projection projection = {}, Equal equal = {}):
+        m_projection { std::move(projection) },
+        m_equal { std::move(equal) }
+    {
+    }
+
+    template<source_like Source>
+        requires details::valid_distinct<Source, Projection, Equal>
+    auto accept(Source&& origin)
+        -> details::staged_source<details::distinct_stage<Source, Projection, Equal>>
+    {
+        return details::staged_source<details::distinct_stage<Source, Projection, Equal>> {
+            details::distinct_stage<Source, Projection, Equal>::create(
+                std::forward<Source>(origin), m_projection, m_equal)
+        };
+    }
+
+private:
+    Projection m_projection;
+    Equal m_equal;
+};
+
+// ### Property definition
+
+// Compares the values of a property by their hash alone, for values that are costly to compare:
+// values with the same hash are considered equal.
+template<class Hash>
+struct by_hash
+{
+};
+
+namespace details
+{
+    // Tells whether a property changes, comparing its values with Equal.
+    template<class T, class Equal>
+    class property_comparison
+    {
+    public:
+        explicit property_comparison(const T&)
+        {
+        }
+
+        auto changed(const T& current, const T& next) -> bool
+        {
+            return !static_cast<bool>(std::invoke(m_equal, current, next));
+        }
+
+    private:
+        Equal m_equal;
+    };
+
+    // Keeps the hash of the current value, so that only the next one is hashed.
+    template<class T, class Hash>
+    class property_comparison<T, by_hash<Hash>>
+    {
+    public:
+        explicit property_comparison(const T& initial):
+            m_hash { std::invoke(m_hasher, initial) }
+        {
+        }
+
+        auto changed(const T&, const T& next) -> bool
+        {
+            const std::size_t next_hash { std::invoke(m_hasher, next) };
+            return std::exchange(m_hash, next_hash) != next_hash;
+        }
+
+    private:
+        Hash m_hasher;
+        std::size_t m_hash;
+    };
+
+    template<basic_lockable Mutex, template<class> class SharedPointer>
+        requires shared_pointer_like<SharedPointer>
+    template<class T, class Equal>
+    class emitter<Mutex, SharedPointer>::property final
+    {
+    public:
+        using connection_type = connection<SharedPointer>;
+        using value_type = T;
+
+        friend emitter;
+
+        template<class... ValueArgs>
+            requires std::constructible_from<T, ValueArgs&&...>
+        explicit property(ValueArgs&&... value_args):
+            m_value(std::forward<ValueArgs>(value_args)...),
+            m_comparison { m_value }
+        {
+        }
+
+        // A copy has the value, but not the connections.
+        property(const property& other):
+            property(other.value())
+        {
+        }
+
+        // Not noexcept: reading the other value locks its mutex.
+        property(property&& other):
+            property(other.value())
+        {
+        }
+
+        auto operator=(const property& other) -> property&
+        {
+            assign(other.value());
+            return *this;
+        }
+
+        auto operator=(property&& other) -> property&
+        {
+            assign(other.value());
+            return *this;
+        }
+
+        ~property() = default;
+
+        auto value() const -> T
+        {
+            std::lock_guard lock { m_mutex };
+            return m_value;
+        }
+
+        // The connection is called with the current value before this returns, or through its
+        // policy, and then with every new value. While another thread emits the property, that
+        // thread gives the connection its first value instead, after the value being emitted
+        // if the connection already got it.
+        template<class... ConnectArgs>
+            requires requires(const signal<T>& connected_signal, ConnectArgs&&... connect_args) {
+                connected_signal.connect(std::forward<ConnectArgs>(connect_args)...);
+            }
+        auto connect(ConnectArgs&&... connect_args) const -> connection<SharedPointer>
+        {
+            std::unique_lock lock { m_mutex };
+
+            auto connection { m_signal.connect(std::forward<ConnectArgs>(connect_args)...) };
+            // Nothing else connects to the signal, so the connection is the last one.
+            auto holder { m_signal.last_connection() };
+
+            if constexpr (std::same_as<Mutex, fake_mutex>)
+            {
+                (*holder)(holder, std::as_const(m_value));
+            }
+            else
+            {
+                m_pending_connections.push_back(std::move(holder));
+                emit_changes(lock);
+            }
+
+            return connection;
+        }
+
+        void block() const
+        {
+            m_signal.block();
+        }
+
+        void unblock() const
+        {
+            m_signal.unblock();
+        }
+
+        auto blocked() const -> bool
+        {
+            return m_signal.blocked();
+        }
+
+        auto suppressed_emissions() const -> std::size_t
+        {
+            return m_signal.suppressed_emissions();
+        }
+
+        auto has_active_slots() const -> bool
+        {
+            return m_signal.has_active_slots();
+        }
+
+        auto slot_count() const -> std::size_t
+        {
+            return m_signal.slot_count();
+        }
+
+        void freeze() const
+        {
+            m_signal.freeze();
+        }
+
+        auto frozen() const -> bool
+        {
+            return m_signal.frozen();
+        }
+
+    private:
+        // Without emitting.
+        void assign(T value)
+        {
+            std::lock_guard lock { m_mutex };
+            m_comparison.changed(m_value, value);
+            m_value = std::move(value);
+        }
+
+        auto set(const emitter& owner, T value) -> bool
+        {
+            std::unique_lock lock { m_mutex };
+            if (!m_comparison.changed(m_value, value))
+            {
+                return false;
+            }
+            m_value = std::move(value);
+
+            if (owner.suppress_emission())
+            {
+                return true;
+            }
+            m_signal.follow_freezes(owner.freezes());
+
+            if constexpr (std::same_as<Mutex, fake_mutex>)
+            {
+                m_signal.emit(std::as_const(m_value));
+            }
+            else
+            {
+                ++m_changes;
+                emit_changes(lock);
+            }
+
+            return true;
+        }
+
+        // Emits without the lock, one value at a time, so that slots get the values in the
+        // order they were set and the last one they get is the current value. A thread that
+        // changes the value or connects while another one emits leaves the emission to it, as
+        // does a slot setting the value again: the current value is emitted once the emission
+        // returns, skipping those set meanwhile.
+        void emit_changes(std::unique_lock<Mutex>& lock) const
+        {
+            if (m_emitting)
+            {
+                return;
+            }
+
+            m_emitting = true;
+            try
+            {
+                while (m_emitted_changes != m_changes || !m_pending_connections.empty())
+                {
+                    // Other threads may set the value during the emission: they must not
+                    // change what is being emitted.
+                    T emitted { m_value };
+                    if (m_emitted_changes != m_changes)
+                    {
+                        m_emitted_changes = m_changes;
+                        // Connections made before the value was copied are emitted it as well.
+                        // They are released without the lock, as releasing the last reference to
+                        // a connection disposes of it.
+                        const auto emitted_connections { std::exchange(m_pending_connections,
+                                                                       {}) };
+
+                        lock.unlock();
+                        m_signal.emit(std::move(emitted));
+                    }
+                    else
+                    {
+                        auto pending { std::exchange(m_pending_connections, {}) };
+
+                        lock.unlock();
+                        for (const auto& holder: pending)
+                        {
+                            (*holder)(holder, std::as_const(emitted));
+                        }
+                    }
+                    lock.lock();
+                }
+            }
+            catch (...)
+            {
+                if (!lock.owns_lock())
+                {
+                    lock.lock();
+                }
+                m_emitted_changes = m_changes;
+                m_emitting = false;
+                const auto dropped_connections { std::exchange(m_pending_connections, {}) };
+                lock.unlock();
+                throw;
+            }
+            m_emitting = false;
+        }
+
+        T m_value;
+        property_comparison<T, Equal> m_comparison;
+        signal<T> m_signal;
+        mutable Mutex m_mutex;
+        // Guarded by the mutex, to serialize the emissions of a thread-safe property.
+        mutable bool m_emitting { false };
+        mutable std::uint64_t m_changes { 0 };
+        mutable std::uint64_t m_emitted_changes { 0 };
+        mutable typename signal<T>::slot_list m_pending_connections;
+    };
+} // namespace details
+
+// ### class scan
+
+// Where the accumulator of a scan lives: each connection has its own, or all the connections to
+// the scanned source share one.
+enum class scan_state
+{
+    per_connection,
+    shared
+};
+
+namespace details
+{
+    template<class Connectable>
+    struct connectable_mutex;
+
+    template<template<class> class SharedPointer>
+    struct connectable_mutex<connectable<SharedPointer>>: shared_pointer_mutex<SharedPointer>
+    {
+    };
+
+    template<class Source>
+    using source_mutex_t =
+        connectable_mutex<typename std::remove_cvref_t<Source>::connectable_type>::type;
+
+    template<class Function, class Accumulator, class Source>
+    concept valid_scan = requires {
+        requires ::source_like<Source>;
+        requires std::copyable<Accumulator>;
+        requires partially_tuple_callable<
+            Function&,
+            tuple_cat_result_t<std::tuple<Accumulator&>,
+                               typename std::remove_cvref_t<Source>::args>>;
+    };
+
+    // Holds an accumulator, which the function either updates in place, or replaces with what
+    // it returns. Copies start from the copied accumulator, with a mutex of their own.
+    template<class Accumulator, basic_lockable Mutex>
+    class accumulator_cell
+    {
+    public:
+        explicit accumulator_cell(const Accumulator& initial):
+            m_accumulator { initial }
+        {
+        }
+
+        accumulator_cell(const accumulator_cell& other):
+            m_accumulator { other.m_accumulator }
+        {
+        }
+
+        accumulator_cell(accumulator_cell&& other) noexcept(
+            std::is_nothrow_move_constructible_v<Accumulator>):
+            m_accumulator { std::move(other.m_accumulator) }
+        {
+        }
+
+        auto operator=(const accumulator_cell&) -> accumulator_cell& = delete;
+        auto operator=(accumulator_cell&&) -> accumulator_cell& = delete;
+
+        ~accumulator_cell() = default;
+
+        // The accumulator is updated under the lock, and the callable is given the accumulator,
+        // or a copy of it taken under the lock with thread safe emitters, so that other
+        // emissions don't change it during the call.
+        template<class Function, class Callable, class... Args>
+        void update(Function& function, Callable&& callable, Args&&... args)
+        {
+            std::unique_lock lock { m_mutex };
+
+            if constexpr (std::is_void_v<decltype(partial_call(function,
+                                                               m_accumulator,
+                                                               std::forward<Args>(args)...))>)
+            {
+                partial_call(function, m_accumulator, std::forward<Args>(args)...);
+            }
+            else
+            {
+                m_accumulator = partial_call(function, m_accumulator, std::forward<Args>(args)...);
+            }
+
+            if constexpr (std::same_as<Mutex, fake_mutex>)
+            {
+                std::invoke(std::forward<Callable>(callable), std::as_const(m_accumulator));
+            }
+            else
+            {
+                const Accumulator current { m_accumulator };
+                lock.unlock();
+                std::invoke(std::forward<Callable>(callable), current);
+            }
+        }
+
+    private:
+        Accumulator m_accumulator;
+        Mutex m_mutex;
+    };
+
+    // Each connection has its own accumulator, kept in its slot.
+    template<::source_like Source, class Accumulator, class Function>
+        requires valid_scan<Function, Accumulator, Source>
+    class scanned_source: public std::remove_cvref_t<Source>::connectable_type
+    {
+    public:
+        friend std::remove_cvref_t<Source>::connectable_type;
+
+        using args = std::tuple<const Accumulator&>;
+
+        scanned_source(Source&& origin, Accumulator initial, Function function):
+            m_source { std::forward<Source>(origin) },
+            m_initial { std::move(initial) },
+            m_function { std::move(function) }
+        {
+        }
+
+    private:
+        template<partially_tuple_callable<args> Callable>
+        auto forwarding_lambda(Callable&& callable) const
+        {
+            return [callable = std::forward<Callable>(callable),
+                    cell = accumulator_cell<Accumulator, source_mutex_t<Source>> { m_initial },
+                    function = m_function]<class... Args>(Args&&... args) mutable
+                requires partially_callable<Function&, Accumulator&, Args...>
+            {
+                cell.update(function,
+                            [&callable](const Accumulator& accumulator)
+                            { partial_call(callable, accumulator); },
+                            std::forward<Args>(args)...);
+            };
+        }
+
+        Source m_source;
+        Accumulator m_initial;
+        Function m_function;
+    };
+
+    // All the connections share the accumulator, updated once per emission.
+    template<class Source, class Accumulator, class Function>
+        requires valid_scan<Function, Accumulator, Source>
+    class scan_stage final
+        : public shared_stage<scan_stage<Source, Accumulator, Function>,
+                              Source,
+                              std::tuple<const Accumulator&>>
+    {
+        using base = shared_stage<scan_stage<Source, Accumulator, Function>,
+                                  Source,
+                                  std::tuple<const Accumulator&>>;
+
+    public:
+        friend base;
+
+    private:
+        scan_stage(Source&& origin, const Accumulator& initial, Function function):
+            base { std::forward<Source>(origin) },
+            m_cell { initial },
+            m_function { std::move(function) }
+        {
+        }
+
+        template<class... EmittedArgs>
+        void receive(EmittedArgs&&... emitted_args)
+        {
+            m_cell.update(m_function,
+                          [this](const Accumulator& accumulator) { this->publish(accumulator); },
+                          std::forward<EmittedArgs>(emitted_args)...);
+        }
+
+        accumulator_cell<Accumulator, typename base::mutex_type> m_cell;
+        Function m_function;
+    };
+
+    template<scan_state State, class Accumulator, class Function>
+    class scan_chainable: public chainable
+    {
+    public:
+        scan_chainable(Accumulator initial, Function function):
+            m_initial { std::move(initial) },
+            m_function { std::move(function) }
+        {
+        }
+
+        template<source_like Source>
+            requires valid_scan<Function, Accumulator, Source>
+        auto accept(Source&& origin)
+        {
+            if constexpr (State == scan_state::shared)
+            {
+                return staged_source<scan_stage<Source, Accumulator, Function>> {
+                    scan_stage<Source, Accumulator, Function>::create(
+                        std::forward<Source>(origin), m_initial, m_function)
+                };
+            }
+            else
+            {
+                return scanned_source<Source, Accumulator, Function> {
+                    std::forward<Source>(origin), m_initial, m_function
+                };
+            }
+        }
+
+    private:
+        Accumulator m_initial;
+        Function m_function;
+    };
+} // namespace details
+
+// Emits an accumulator, updated by the function on each emission: either in place, when it
+// returns void, or by what it returns.
+template<scan_state State = scan_state::per_connection, class Accumulator, class Function>
+auto scan(Accumulator initial, Function function)
+    -> details::scan_chainable<State, Accumulator, Function>
+{
+    return { std::move(initial), std::move(function) };
+}
+
+// ### class timer_wheel
+
+namespace details
+{
+    template<class Clock>
+    concept clock_like = requires(const Clock& clock) {
+        typename Clock::duration;
+        typename Clock::time_point;
+        { clock.now() } -> std::same_as<typename Clock::time_point>;
+    };
+
+    // Scheduled on a timer wheel, which expires it once its delay has elapsed.
+    class timer
+    {
+    public:
+        timer(const timer&) = delete;
+        timer(timer&&) = delete;
+
+        auto operator=(const timer&) -> timer& = delete;
+        auto operator=(timer&&) -> timer& = delete;
+
+        // Called without the wheel locked, so that it may schedule timers again.
+        virtual void expire() = 0;
+        // The wheel is destroyed while the timer is scheduled.
+        virtual void discard() = 0;
+
+    protected:
+        timer() = default;
+        ~timer() = default;
+
+    private:
+        template<basic_lockable Mutex, clock_like Clock>
+        friend class timer_wheel;
+
+        timer* m_next { nullptr };
+        timer* m_previous { nullptr };
+        // The head of the slot holding the timer, null when not scheduled.
+        timer** m_slot { nullptr };
+        std::uint64_t m_expiry { 0 };
+        std::size_t m_level { 0 };
+    };
+
+    // Hierarchical timer wheel: each level has 64 slots, and each slot of a level covers a whole
+    // turn of the level below. Scheduling and cancelling cost the same whatever the number of
+    // timers, and advancing skips the turns of the empty levels. Timers further away than the
+    // last level are parked in it, and placed again when it is reached.
+    // Nothing advances the wheel on its own: advance must be called regularly, typically from an
+    // event loop.
+    template<basic_lockable Mutex, clock_like Clock>
+    class timer_wheel
+    {
+    public:
+        using clock = Clock;
+        using duration = typename Clock::duration;
+        using time_point = typename Clock::time_point;
+
+        static constexpr duration default_resolution { std::chrono::duration_cast<duration>(
+            std::chrono::milliseconds { 1 }) };
+
+        explicit timer_wheel(duration resolution = default_resolution, Clock wheel_clock = {}):
+            m_clock { std::move(wheel_clock) },
+            m_resolution { resolution },
+            m_start { m_clock.now() }
+        {
+        }
+
+        timer_wheel(const timer_wheel&) = delete;
+        timer_wheel(timer_wheel&&) = delete;
+
+        auto operator=(const timer_wheel&) -> timer_wheel& = delete;
+        auto operator=(timer_wheel&&) -> timer_wheel& = delete;
+
+        ~timer_wheel()
+        {
+            for (auto& level: m_slots)
+            {
+                for (auto*& slot: level)
+                {
+                    while (slot != nullptr)
+                    {
+                        auto& discarded { *slot };
+                        unlink(discarded);
+                        discarded.discard();
+                    }
+                }
+            }
+        }
+
+        auto now() const -> time_point
+        {
+            return m_clock.now();
+        }
+
+        // Expires the timer once the delay has elapsed, rounded up to the resolution. Scheduling
+        // a scheduled timer moves it.
+        void schedule(timer& scheduled_timer, duration delay)
+        {
+            const auto elapsed { now() - m_start + delay };
+            const auto expiry { static_cast<std::uint64_t>(
+                (elapsed + m_resolution - duration { 1 }) / m_resolution) };
+
+            std::lock_guard lock { m_mutex };
+            if (scheduled_timer.m_slot != nullptr)
+            {
+                unlink(scheduled_timer);
+                --m_size;
+            }
+
+            // The current tick is already expired.
+            scheduled_timer.m_expiry = std::max(expiry, m_current + 1);
+            link(scheduled_timer);
+            ++m_size;
+        }
+
+        auto cancel(timer& cancelled_timer) -> bool
+        {
+            std::lock_guard lock { m_mutex };
+            if (cancelled_timer.m_slot == nullptr)
+            {
+                return false;
+            }
+
+            unlink(cancelled_timer);
+            --m_size;
+            return true;
+        }
+
+        auto scheduled(const timer& checked_timer) const -> bool
+        {
+            std::lock_guard lock { m_mutex };
+            return checked_timer.m_slot != nullptr;
+        }
+
+        auto size() const -> std::size_t
+        {
+            std::lock_guard lock { m_mutex };
+            return m_size;
+        }
+
+        // Expires the timers due by now, and returns how many there were. Calls made while
+        // another call is advancing the wheel, including from an expiring timer, do nothing.
+        auto advance() -> std::size_t
+        {
+            {
+                std::lock_guard lock { m_mutex };
+                if (m_advancing)
+                {
+                    return 0;
+                }
+                m_advancing = true;
+            }
+
+            advancing_scope scope { *this };
+            const auto target { static_cast<std::uint64_t>((now() - m_start) / m_resolution) };
+
+            std::size_t expired { 0 };
+            for (auto* due { next_due(target) }; due != nullptr; due = next_due(target))
+            {
+                due->expire();
+                ++expired;
+            }
+            return expired;
+        }
+
+    private:
+        static constexpr std::size_t level_bits { 6 };
+        static constexpr std::size_t level_count { 4 };
+        static constexpr std::size_t slot_count { std::size_t { 1 } << level_bits };
+        static constexpr std::uint64_t slot_mask { slot_count - 1 };
+        static constexpr std::uint64_t wheel_span { std::uint64_t { 1 }
+                                                    << (level_bits * level_count) };
+
+        class advancing_scope
+        {
+        public:
+            explicit advancing_scope(timer_wheel& wheel):
+                m_wheel { wheel }
+            {
+            }
+
+            advancing_scope(const advancing_scope&) = delete;
+            advancing_scope(advancing_scope&&) = delete;
+
+            auto operator=(const advancing_scope&) -> advancing_scope& = delete;
+            auto operator=(advancing_scope&&) -> advancing_scope& = delete;
+
+            ~advancing_scope()
+            {
+                std::lock_guard lock { m_wheel.m_mutex };
+                m_wheel.m_advancing = false;
+            }
+
+        private:
+            // It might be bad, but this is done on purpose.
+            // NOLINTNEXTLINE(cppcoreguidelines-avoid-const-or-ref-data-members)
+            timer_wheel& m_wheel;
+        };
+
+        // Takes the next timer due by the target tick out of the wheel, moving the wheel
+        // forward until there is one.
+        auto next_due(std::uint64_t target) -> timer*
+        {
+            std::lock_guard lock { m_mutex };
+            while (true)
+            {
+                // Timers of the current tick slot are all due.
+                if (auto* due { m_slots[0][m_current & slot_mask] }; due != nullptr)
+                {
+                    unlink(*due);
+                    --m_size;
+                    return due;
+                }
+
+                if (m_current >= target)
+                {
+                    return nullptr;
+                }
+
+                if (m_size == 0)
+                {
+                    m_current = target;
+                    return nullptr;
+                }
+
+                // Nothing is due before the next turn of the lowest non empty level.
+                auto next { m_current + 1 };
+                for (std::size_t level { 0 };
+                     level + 1 < level_count && m_level_sizes[level] == 0;
+                     ++level)
+                {
+                    const auto shift { level_bits * (level + 1) };
+                    next = ((m_current >> shift) + 1) << shift;
+                }
+
+                m_current = std::min(next, target);
+                cascade();
+            }
+        }
+
+        // Must be called with the mutex locked. Timers of the slots that begin with the current
+        // tick move down to the levels below.
+        void cascade()
+        {
+            for (std::size_t level { level_count - 1 }; level > 0; --level)
+            {
+                const auto shift { level_bits * level };
+                if ((m_current & ((std::uint64_t { 1 } << shift) - 1)) != 0)
+                {
+                    continue;
+                }
+
+                auto* moved { m_slots[level][(m_current >> shift) & slot_mask] };
+                while (moved != nullptr)
+                {
+                    auto* next { moved->m_next };
+                    unlink(*moved);
+                    link(*moved);
+                    moved = next;
+                }
+            }
+        }
+
+        // Must be called with the mutex locked.
+        void link(timer& linked_timer)
+        {
+            const auto expiry { linked_timer.m_expiry };
+            const auto delta { expiry > m_current ? expiry - m_current : 0 };
+
+            std::size_t level { 0 };
+            while (level + 1 < level_count &&
+                   delta >= (std::uint64_t { 1 } << (level_bits * (level + 1))))
+            {
+                ++level;
+            }
+
+            // Beyond the last level, parked in its furthest slot.
+            const auto position { std::min(expiry, m_current + wheel_span - 1) };
+            auto*& head { m_slots[level][(position >> (level_bits * level)) & slot_mask] };
+
+            linked_timer.m_level = level;
+            ++m_level_sizes[level];
+            linked_timer.m_previous = nullptr;
+            linked_timer.m_next = head;
+            if (head != nullptr)
+            {
+                head->m_previous = &linked_timer;
+            }
+            head = &linked_timer;
+            linked_timer.m_slot = &head;
+        }
+
+        // Must be called with the mutex locked.
+        void unlink(timer& unlinked_timer)
+        {
+            --m_level_sizes[unlinked_timer.m_level];
+
+            if (unlinked_timer.m_previous != nullptr)
+            {
+                unlinked_timer.m_previous->m_next = unlinked_timer.m_next;
+            }
+            else
+            {
+                *unlinked_timer.m_slot = unlinked_timer.m_next;
+            }
+
+            if (unlinked_timer.m_next != nullptr)
+            {
+                unlinked_timer.m_next->m_previous = unlinked_timer.m_previous;
+            }
+
+            unlinked_timer.m_next = nullptr;
+            unlinked_timer.m_previous = nullptr;
+            unlinked_timer.m_slot = nullptr;
+        }
+
+        Clock m_clock;
+        duration m_resolution;
+        time_point m_start;
+        std::uint64_t m_current { 0 };
+        std::array<std::array<timer*, slot_count>, level_count> m_slots {};
+        std::array<std::size_t, level_count> m_level_sizes {};
+        std::size_t m_size { 0 };
+        bool m_advancing { false };
+        mutable Mutex m_mutex;
+    };
+} // namespace details
+
+// ### class debounce, throttle and sample
+
+enum class throttle_edge
+{
+    // The first emission of each period is emitted at once.
+    leading,
+    // The last emission of each period is emitted when it ends.
+    trailing
+};
+
+namespace details
+{
+    enum class pacing
+    {
+        debounce,
+        leading_throttle,
+        trailing_throttle,
+        sample
+    };
+
+    template<class Tuple>
+    struct decayed_tuple;
+
+    template<class Tuple>
+    using decayed_tuple_t = decayed_tuple<Tuple>::type;
+
+    template<class... Args>
+    struct decayed_tuple<std::tuple<Args...>>
+    {
+        using type = std::tuple<std::decay_t<Args>...>;
+    };
+
+    // Holds emissions back and emits them when its timer expires, as the pacing dictates. The
+    // timer keeps the stage alive while it is scheduled.
+    template<class Source, class Wheel>
+    class paced_stage final: public shared_stage<paced_stage<Source, Wheel>, Source>,
+                             public timer
+    {
+        using base = shared_stage<paced_stage<Source, Wheel>, Source>;
+
+        using pending_args = decayed_tuple_t<typename base::args>;
+
+    public:
+        friend base;
+
+        void expire() override
+        {
+            std::optional<pending_args> pending;
+            typename base::stage_pointer keep_alive;
+            {
+                std::lock_guard lock { m_mutex };
+
+                // Scheduled again since it expired: the new schedule will expire it.
+                if (m_wheel.scheduled(*this))
+                {
+                    return;
+                }
+
+                std::swap(pending, m_pending);
+                // Samples are taken periodically, until a period without emission.
+                if (m_pacing == pacing::sample && pending.has_value())
+                {
+                    m_wheel.schedule(*this, m_period);
+                }
+                else
+                {
+                    std::swap(keep_alive, m_keep_alive);
+                }
+            }
+
+            if (pending.has_value())
+            {
+                std::apply([this]<class... PendingArgs>(PendingArgs&&... values)
+                           { this->publish(std::forward<PendingArgs>(values)...); },
+                           std::move(*pending));
+            }
+        }
+
+        void discard() override
+        {
+            typename base::stage_pointer keep_alive;
+
+            std::lock_guard lock { m_mutex };
+            m_pending.reset();
+            std::swap(keep_alive, m_keep_alive);
+        }
+
+    private:
+        paced_stage(Source&& origin,
+                    Wheel& wheel,
+                    typename Wheel::duration period,
+                    pacing stage_pacing):
+            base { std::forward<Source>(origin) },
+            m_wheel { wheel },
+            m_period { period },
+            m_pacing { stage_pacing }
+        {
+        }
+
+        template<class... EmittedArgs>
+        void receive(EmittedArgs&&... emitted_args)
+        {
+            std::unique_lock lock { m_mutex };
+
+            switch (m_pacing)
+            {
+            case pacing::debounce:
+                m_pending.emplace(std::forward<EmittedArgs>(emitted_args)...);
+                arm();
+                break;
+            case pacing::leading_throttle:
+                if (m_wheel.scheduled(*this))
+                {
+                    return;
+                }
+
+                arm();
+                lock.unlock();
+                this->publish(std::forward<EmittedArgs>(emitted_args)...);
+                break;
+            case pacing::trailing_throttle:
+            case pacing::sample:
+                m_pending.emplace(std::forward<EmittedArgs>(emitted_args)...);
+                if (!m_wheel.scheduled(*this))
+                {
+                    arm();
+                }
+                break;
+            }
+        }
+
+        // Must be called with the mutex locked.
+        void arm()
+        {
+            m_wheel.schedule(*this, m_period);
+            if (!m_keep_alive)
+            {
+                m_keep_alive = this->self();
+            }
+        }
+
+        // It might be bad, but this is done on purpose.
+        // NOLINTNEXTLINE(cppcoreguidelines-avoid-const-or-ref-data-members)
+        Wheel& m_wheel;
+        typename Wheel::duration m_period;
+        pacing m_pacing;
+        std::optional<pending_args> m_pending;
+        typename base::stage_pointer m_keep_alive;
+        typename base::mutex_type m_mutex;
+    };
+
+    template<class Wheel>
+    class paced_chainable: public chainable
+    {
+    public:
+        template<source_like Source>
+        auto accept(Source&& origin) -> staged_source<paced_stage<Source, Wheel>>
+        {
+            return staged_source<paced_stage<Source, Wheel>> { paced_stage<Source, Wheel>::create(
+                std::forward<Source>(origin), m_wheel, m_period, m_pacing) };
+        }
+
+    protected:
+        paced_chainable(typename Wheel::duration period, Wheel& wheel, pacing chainable_pacing):
+            m_wheel { wheel },
+            m_period { period },
+            m_pacing { chainable_pacing }
+        {
+        }
+
+    private:
+        // It might be bad, but this is done on purpose.
+        // NOLINTNEXTLINE(cppcoreguidelines-avoid-const-or-ref-data-members)
+        Wheel& m_wheel;
+        typename Wheel::duration m_period;
+        pacing m_pacing;
+    };
+} // namespace details
+
+// Emits the last emission once none happened for the delay.
+template<class Wheel>
+class debounce: public details::paced_chainable<Wheel>
+{
+public:
+    debounce(typename Wheel::duration delay, Wheel& wheel):
+        details::paced_chainable<Wheel> { delay, wheel, details::pacing::debounce }
+    {
+    }
+};
+
+// Emits at most one emission per period: the first one, or the last one.
+template<class Wheel>
+class throttle: public details::paced_chainable<Wheel>
+{
+public:
+    throttle(typename Wheel::duration period,
+             Wheel& wheel,
+             throttle_edge edge = throttle_edge::leading):
+        details::paced_chainable<Wheel> { period,
+                                          wheel,
+                                          edge == throttle_edge::leading
+                                              ? details::pacing::leading_throttle
+                                              : details::pacing::trailing_throttle }
+    {
+    }
+};
+
+// Emits the last emission of each period, at a steady pace while emissions keep coming.
+template<class Wheel>
+class sample: public details::paced_chainable<Wheel>
+{
+public:
+    sample(typename Wheel::duration period, Wheel& wheel):
+        details::paced_chainable<Wheel> { period, wheel, details::pacing::sample }
+    {
+    }
+};
+
+// ### class buffer, window and buffer_for
+
+namespace details
+{
+    // An emission, as stored in a batch: its only argument, or a tuple of them.
+    template<class Tuple>
+    struct batch_element;
+
+    template<class Source>
+    using batch_element_t = batch_element<typename std::remove_cvref_t<Source>::args>::type;
+
+    template<class Source>
+    using batch_args_t = std::tuple<std::span<const batch_element_t<Source>>>;
+
+    template<class... Args>
+    struct batch_element<std::tuple<Args...>>
+    {
+        using type = std::tuple<std::decay_t<Args>...>;
+    };
+
+    template<class Arg>
+    struct batch_element<std::tuple<Arg>>
+    {
+        using type = std::decay_t<Arg>;
+    };
+
+    // Batches are taken from the pool while they are filled and emitted, and given back with
+    // their capacity once the slots returned. More batches than one are only allocated when
+    // several are emitted at the same time, by several threads or nested emissions.
+    // Must be used with the mutex of its stage locked.
+    template<class Element>
+    class batch_pool
+    {
+    public:
+        explicit batch_pool(std::size_t capacity):
+            m_capacity { capacity }
+        {
+        }
+
+        auto take() -> std::vector<Element>
+        {
+            if (m_batches.empty())
+            {
+                std::vector<Element> batch;
+                batch.reserve(m_capacity);
+                return batch;
+            }
+
+            auto batch { std::move(m_batches.back()) };
+            m_batches.pop_back();
+            return batch;
+        }
+
+        void give_back(std::vector<Element>&& batch)
+        {
+            batch.clear();
+            m_batches.emplace_back(std::move(batch));
+        }
+
+    private:
+        std::size_t m_capacity;
+        std::vector<std::vector<Element>> m_batches;
+    };
+
+    // Emits the last count emissions every slide emissions. Emissions between two windows, when
+    // the slide is longer than the window, are dropped.
+    template<class Source>
+    class window_stage final
+        : public shared_stage<window_stage<Source>, Source, batch_args_t<Source>>
+    {
+        using base = shared_stage<window_stage<Source>, Source, batch_args_t<Source>>;
+        using element = batch_element_t<Source>;
+
+    public:
+        friend base;
+
+    private:
+        window_stage(Source&& origin, std::size_t count, std::size_t slide):
+            base { std::forward<Source>(origin) },
+            m_count { count },
+            m_slide { slide },
+            m_remaining { count },
+            m_pool { count },
+            m_elements { m_pool.take() }
+        {
+        }
+
+        template<class... EmittedArgs>
+        void receive(EmittedArgs&&... emitted_args)
+        {
+            std::unique_lock lock { m_mutex };
+
+            if (m_remaining-- > m_count)
+            {
+                return;
+            }
+
+            if (m_elements.size() < m_count)
+            {
+                m_elements.emplace_back(std::forward<EmittedArgs>(emitted_args)...);
+            }
+            else
+            {
+                m_elements[m_oldest] = element(std::forward<EmittedArgs>(emitted_args)...);
+                m_oldest = (m_oldest + 1) % m_count;
+            }
+
+            if (m_remaining != 0)
+            {
+                return;
+            }
+            m_remaining = m_slide;
+
+            auto batch { take_window() };
+            lock.unlock();
+
+            this->publish(std::span<const element> { batch });
+
+            lock.lock();
+            m_pool.give_back(std::move(batch));
+        }
+
+        // Must be called with the mutex locked.
+        auto take_window() -> std::vector<element>
+        {
+            // Windows don't overlap: the elements are the window.
+            if (m_slide >= m_count)
+            {
+                return std::exchange(m_elements, m_pool.take());
+            }
+
+            // The elements are a ring, whose oldest element starts the window.
+            auto batch { m_pool.take() };
+            const auto oldest { m_elements.begin() + static_cast<std::ptrdiff_t>(m_oldest) };
+            batch.insert(batch.end(), oldest, m_elements.end());
+            batch.insert(batch.end(), m_elements.begin(), oldest);
+            return batch;
+        }
+
+        std::size_t m_count;
+        std::size_t m_slide;
+        // Emissions until the end of the next window.
+        std::size_t m_remaining;
+        std::size_t m_oldest { 0 };
+        batch_pool<element> m_pool;
+        std::vector<element> m_elements;
+        typename base::mutex_type m_mutex;
+    };
+
+    // Emits the emissions received during a period, which starts with the first of them. The
+    // timer keeps the stage alive while it is scheduled.
+    template<class Source, class Wheel>
+    class timed_batch_stage final
+        : public shared_stage<timed_batch_stage<Source, Wheel>, Source, batch_args_t<Source>>,
+          public timer
+    {
+        using base = shared_stage<timed_batch_stage<Source, Wheel>, Source, batch_args_t<Source>>;
+        using element = batch_element_t<Source>;
+
+    public:
+        friend base;
+
+        void expire() override
+        {
+            typename base::stage_pointer keep_alive;
+            std::vector<element> batch;
+            {
+                std::lock_guard lock { m_mutex };
+
+                // Scheduled again since it expired: the new schedule will expire it.
+                if (m_wheel.scheduled(*this))
+                {
+                    return;
+                }
+
+                std::swap(keep_alive, m_keep_alive);
+                batch = std::exchange(m_elements, m_pool.take());
+            }
+
+            this->publish(std::span<const element> { batch });
+
+            std::lock_guard lock { m_mutex };
+            m_pool.give_back(std::move(batch));
+        }
+
+        void discard() override
+        {
+            typename base::stage_pointer keep_alive;
+
+            std::lock_guard lock { m_mutex };
+            m_elements.clear();
+            std::swap(keep_alive, m_keep_alive);
+        }
+
+    private:
+        timed_batch_stage(Source&& origin, Wheel& wheel, typename Wheel::duration period):
+            base { std::forward<Source>(origin) },
+            m_wheel { wheel },
+            m_period { period },
+            m_pool { 0 },
+            m_elements { m_pool.take() }
+        {
+        }
+
+        template<class... EmittedArgs>
+        void receive(EmittedArgs&&... emitted_args)
+        {
+            std::lock_guard lock { m_mutex };
+
+            m_elements.emplace_back(std::forward<EmittedArgs>(emitted_args)...);
+            if (!m_wheel.scheduled(*this))
+            {
+                m_wheel.schedule(*this, m_period);
+                if (!m_keep_alive)
+                {
+                    m_keep_alive = this->self();
+                }
+            }
+        }
+
+        // It might be bad, but this is done on purpose.
+        // NOLINTNEXTLINE(cppcoreguidelines-avoid-const-or-ref-data-members)
+        Wheel& m_wheel;
+        typename Wheel::duration m_period;
+        // Batches keep the capacity of the largest ones.
+        batch_pool<element> m_pool;
+        std::vector<element> m_elements;
+        typename base::stage_pointer m_keep_alive;
+        typename base::mutex_type m_mutex;
+    };
+
+    class window_chainable: public chainable
+    {
+    public:
+        template<source_like Source>
+        auto accept(Source&& origin) -> staged_source<window_stage<Source>>
+        {
+            return staged_source<window_stage<Source>> { window_stage<Source>::create(
+                std::forward<Source>(origin), m_count, m_slide) };
+        }
+
+    protected:
+        window_chainable(std::size_t count, std::size_t slide):
+            m_count { count },
+            m_slide { slide }
+        {
+            if (count == 0 || slide == 0)
+            {
+                throw std::invalid_argument { "Windows must have a count and a slide" };
+            }
+        }
+
+    private:
+        std::size_t m_count;
+        std::size_t m_slide;
+    };
+} // namespace details
+
+// Emits the emissions by batches of count.
+class buffer: public details::window_chainable
+{
+public:
+    explicit buffer(std::size_t count):
+        details::window_chainable { count, count }
+    {
+    }
+};
+
+// Emits the last count emissions, every slide emissions.
+class window: public details::window_chainable
+{
+public:
+    explicit window(std::size_t count, std::size_t slide = 1):
+        details::window_chainable { count, slide }
+    {
+    }
+};
+
+// Emits the emissions received during a period, which starts with the first of them.
+template<class Wheel>
+class buffer_for: public chainable
+{
+public:
+    buffer_for(typename Wheel::duration period, Wheel& wheel):
+        m_wheel { wheel },
+        m_period { period }
+    {
+    }
+
+    template<source_like Source>
+    auto accept(Source&& origin)
+        -> details::staged_source<details::timed_batch_stage<Source, Wheel>>
+    {
+        return details::staged_source<details::timed_batch_stage<Source, Wheel>> {
+            details::timed_batch_stage<Source, Wheel>::create(
+                std::forward<Source>(origin), m_wheel, m_period)
+        };
+    }
+
+private:
+    // It might be bad, but this is done on purpose.
+    // NOLINTNEXTLINE(cppcoreguidelines-avoid-const-or-ref-data-members)
+    Wheel& m_wheel;
+    typename Wheel::duration m_period;
+};
+
+// ### merge, combine_latest and zip
+
+namespace details
+{
+    template<class... Sources>
+    using first_source_t = std::remove_cvref_t<std::tuple_element_t<0, std::tuple<Sources...>>>;
+
+    template<class Source>
+    using source_values_t = decayed_tuple_t<typename std::remove_cvref_t<Source>::args>;
+
+    // A stage can only connect to sources whose connections are all of the same kind.
+    template<class... Sources>
+    concept fan_in_sources =
+        sizeof...(Sources) >= 2 && (::source_like<Sources> && ...) &&
+        (std::same_as<typename std::remove_cvref_t<Sources>::connectable_type,
+                      typename first_source_t<Sources...>::connectable_type> &&
+         ...);
+
+    // Like shared_stage, for several sources: it is connected to all of them while it has
+    // connections itself, and gets the emissions of the Index-th one in receive<Index>.
+    template<class Stage,
+             class... Args,
+             template<class> class SharedPointer,
+             class... Sources>
+    class fan_in_stage<Stage, std::tuple<Args...>, connectable<SharedPointer>, Sources...>
+        : public emitter<typename shared_pointer_mutex<SharedPointer>::type, SharedPointer>,
+          public connection_observer
+    {
+        using stage_emitter =
+            emitter<typename shared_pointer_mutex<SharedPointer>::type, SharedPointer>;
+
+        template<std::size_t Index>
+        using source_args =
+            typename std::remove_cvref_t<std::tuple_element_t<Index, std::tuple<Sources...>>>::args;
+
+        using upstream_connections = std::array<connection<SharedPointer>, sizeof...(Sources)>;
+
+    public:
+        using args = std::tuple<Args...>;
+        using connectable_type = connectable<SharedPointer>;
+        using stage_pointer = SharedPointer<Stage>;
+
+        fan_in_stage(const fan_in_stage&) = delete;
+        fan_in_stage(fan_in_stage&&) = delete;
+
+        auto operator=(const fan_in_stage&) -> fan_in_stage& = delete;
+        auto operator=(fan_in_stage&&) -> fan_in_stage& = delete;
+
+        static auto create(Sources&&... origins) -> stage_pointer
+        {
+            stage_pointer stage { new Stage(std::forward<Sources>(origins)...) };
+            stage->m_self = typename stage_pointer::weak_type { stage };
+            stage->stage_signal.observe_connections(*stage);
+            return stage;
+        }
+
+        void connections_changed() override
+        {
+            std::lock_guard lock { m_mutex };
+
+            const bool connected { stage_signal.slot_count() != 0 };
+            if (connected == m_upstreams.has_value())
+            {
+                return;
+            }
+
+            if (!connected)
+            {
+                for (auto& upstream: *m_upstreams)
+                {
+                    upstream.disconnect();
+                }
+                m_upstreams.reset();
+                return;
+            }
+
+            m_upstreams.emplace(connect_upstreams(std::index_sequence_for<Sources...> {}));
+        }
+
+        // It might be bad, but this is done on purpose.
+        // NOLINTNEXTLINE(misc-non-private-member-variables-in-classes)
+        typename stage_emitter::template signal<Args...> stage_signal;
+
+    protected:
+        using mutex_type = typename shared_pointer_mutex<SharedPointer>::type;
+
+        explicit fan_in_stage(Sources&&... origins):
+            m_sources { std::forward<Sources>(origins)... }
+        {
+        }
+
+        ~fan_in_stage() = default;
+
+        template<class... EmittedArgs>
+        void publish(EmittedArgs&&... emitted_args) const
+        {
+            this->emit(&fan_in_stage::stage_signal, std::forward<EmittedArgs>(emitted_args)...);
+        }
+
+    private:
+        template<std::size_t... Indices>
+        auto connect_upstreams(std::index_sequence<Indices...> /*indices*/) -> upstream_connections
+        {
+            return { std::get<Indices>(m_sources).connect(
+                [stage = m_self.lock()]<class... EmittedArgs>(EmittedArgs&&... emitted_args)
+                    requires(sizeof...(EmittedArgs) == std::tuple_size_v<source_args<Indices>>)
+                {
+                    stage->template receive<Indices>(std::forward<EmittedArgs>(emitted_args)...);
+                })... };
+        }
+
+        std::tuple<Sources...> m_sources;
+        typename stage_pointer::weak_type m_self;
+        std::optional<upstream_connections> m_upstreams;
+        mutex_type m_mutex;
+    };
+
+    template<class Stage, class StageArgs, class... Sources>
+    using fan_in_base = fan_in_stage<Stage,
+                                     StageArgs,
+                                     typename first_source_t<Sources...>::connectable_type,
+                                     Sources...>;
+
+    template<class... Sources>
+    using merged_args_t = source_values_t<first_source_t<Sources...>>;
+
+    template<class... Sources>
+    concept valid_merge =
+        fan_in_sources<Sources...> &&
+        (std::same_as<source_values_t<Sources>, merged_args_t<Sources...>> && ...);
+
+    // Emits the emissions of every source, as they come.
+    template<class... Sources>
+        requires valid_merge<Sources...>
+    class merge_stage final
+        : public fan_in_base<merge_stage<Sources...>, merged_args_t<Sources...>, Sources...>
+    {
+        using base = fan_in_base<merge_stage<Sources...>, merged_args_t<Sources...>, Sources...>;
+
+    public:
+        friend base;
+
+    private:
+        explicit merge_stage(Sources&&... origins):
+            base { std::forward<Sources>(origins)... }
+        {
+        }
+
+        template<std::size_t Index, class... EmittedArgs>
+        void receive(EmittedArgs&&... emitted_args) const
+        {
+            this->publish(std::forward<EmittedArgs>(emitted_args)...);
+        }
+    };
+
+    template<class... Sources>
+    using combined_args_t = tuple_cat_result_t<source_values_t<Sources>...>;
+
+    // Emits the latest values of every source, each time one of them emits, once they all did.
+    template<class... Sources>
+        requires fan_in_sources<Sources...>
+    class combine_latest_stage final: public fan_in_base<combine_latest_stage<Sources...>,
+                                                         combined_args_t<Sources...>,
+                                                         Sources...>
+    {
+        using base =
+            fan_in_base<combine_latest_stage<Sources...>, combined_args_t<Sources...>, Sources...>;
+
+        using latest_values = std::tuple<std::optional<source_values_t<Sources>>...>;
+
+    public:
+        friend base;
+
+    private:
+        explicit combine_latest_stage(Sources&&... origins):
+            base { std::forward<Sources>(origins)... }
+        {
+        }
+
+        // The slots get a copy of the latest values, taken under the lock and emitted without
+        // it, so that they may make a source emit again, or wait for another thread to.
+        template<std::size_t Index, class... EmittedArgs>
+        void receive(EmittedArgs&&... emitted_args)
+        {
+            std::unique_lock lock { m_mutex };
+
+            auto& latest { std::get<Index>(m_latest) };
+            if (latest.has_value())
+            {
+                *latest = std::forward_as_tuple(std::forward<EmittedArgs>(emitted_args)...);
+            }
+            else
+            {
+                latest.emplace(std::forward<EmittedArgs>(emitted_args)...);
+                --m_missing;
+            }
+
+            if (m_missing != 0)
+            {
+                return;
+            }
+
+            auto combined { std::apply([](const auto&... source_latest)
+                                       { return std::tuple_cat(*source_latest...); },
+                                       m_latest) };
+            lock.unlock();
+
+            std::apply([this]<class... Values>(Values&&... values)
+                       { this->publish(std::forward<Values>(values)...); },
+                       std::move(combined));
+        }
+
+        latest_values m_latest;
+        std::size_t m_missing { sizeof...(Sources) };
+        typename base::mutex_type m_mutex;
+    };
+
+    // A queue of fixed capacity. When it is full, pushing drops its oldest element.
+    template<class T, std::size_t Capacity>
+    class bounded_ring
+    {
+    public:
+        auto empty() const -> bool
+        {
+            return m_size == 0;
+        }
+
+        template<class... Args>
+        void push(Args&&... args)
+        {
+            if (m_size == Capacity)
+            {
+                m_elements[m_front].emplace(std::forward<Args>(args)...);
+                m_front = (m_front + 1) % Capacity;
+                return;
+            }
+
+            m_elements[(m_front + m_size) % Capacity].emplace(std::forward<Args>(args)...);
+            ++m_size;
+        }
+
+        auto pop() -> T
+        {
+            T front { std::move(*m_elements[m_front]) };
+            m_elements[m_front].reset();
+            m_front = (m_front + 1) % Capacity;
+            --m_size;
+            return front;
+        }
+
+    private:
+        std::array<std::optional<T>, Capacity> m_elements;
+        std::size_t m_front { 0 };
+        std::size_t m_size { 0 };
+    };
+
+    // Emits the n-th emissions of every source together, once they all emitted n times. Each
+    // source keeps at most Capacity emissions waiting for the other ones.
+    template<std::size_t Capacity, class... Sources>
+        requires(fan_in_sources<Sources...> && Capacity != 0)
+    class zip_stage final: public fan_in_base<zip_stage<Capacity, Sources...>,
+                                              combined_args_t<Sources...>,
+                                              Sources...>
+    {
+        using base =
+            fan_in_base<zip_stage<Capacity, Sources...>, combined_args_t<Sources...>, Sources...>;
+
+    public:
+        friend base;
+
+    private:
+        explicit zip_stage(Sources&&... origins):
+            base { std::forward<Sources>(origins)... }
+        {
+        }
+
+        template<std::size_t Index, class... EmittedArgs>
+        void receive(EmittedArgs&&... emitted_args)
+        {
+            std::unique_lock lock { m_mutex };
+
+            std::get<Index>(m_pending).push(std::forward<EmittedArgs>(emitted_args)...);
+            if (!std::apply([](const auto&... pending) { return (!pending.empty() && ...); },
+                            m_pending))
+            {
+                return;
+            }
+
+            auto zipped { std::apply([](auto&... pending)
+                                     { return std::tuple_cat(pending.pop()...); },
+                                     m_pending) };
+            lock.unlock();
+
+            std::apply([this]<class... Values>(Values&&... values)
+                       { this->publish(std::forward<Values>(values)...); },
+                       std::move(zipped));
+        }
+
+        std::tuple<bounded_ring<source_values_t<Sources>, Capacity>...> m_pending;
+        typename base::mutex_type m_mutex;
+    };
+} // namespace details
+
+// Emits the emissions of all the sources, which must emit the same values.
+template<class... Sources>
+    requires details::valid_merge<Sources...>
+auto merge(Sources&&... sources) -> details::staged_source<details::merge_stage<Sources...>>
+{
+    return details::staged_source<details::merge_stage<Sources...>> {
+        details::merge_stage<Sources...>::create(std::forward<Sources>(sources)...)
+    };
+}
+
+// Emits the latest values of all the sources, once each of them emitted, whenever one emits.
+template<class... Sources>
+    requires details::fan_in_sources<Sources...>
+auto combine_latest(Sources&&... sources)
+    -> details::staged_source<details::combine_latest_stage<Sources...>>
+{
+    return details::staged_source<details::combine_latest_stage<Sources...>> {
+        details::combine_latest_stage<Sources...>::create(std::forward<Sources>(sources)...)
+    };
+}
+
+// Emits the values of all the sources together, pairing their emissions in order. At most
+// Capacity emissions of a source wait for the other sources: older ones are dropped.
+template<std::size_t Capacity = 16, class... Sources>
+    requires(details::fan_in_sources<Sources...> && Capacity != 0)
+auto zip(Sources&&... sources)
+    -> details::staged_source<details::zip_stage<Capacity, Sources...>>
+{
+    return details::staged_source<details::zip_stage<Capacity, Sources...>> {
+        details::zip_stage<Capacity, Sources...>::create(std::forward<Sources>(sources)...)
+    };
+}
+
+// ### connection_holder_implementation class
+
+namespace details
+{
+
+    // Held by the index of the key, and by the connections to its signal. Defined here, as the
+    // signal is only complete once its class is.
+    template<basic_lockable Mutex, template<class> class SharedPointer>
+        requires shared_pointer_like<SharedPointer>
+    template<signal_arg... Args>
+    struct emitter<Mutex, SharedPointer>::signal<Args...>::key_entry final
+        : public signal_owner,
+          public connection_observer
+    {
+        explicit key_entry(key_index_base& index):
+            parent_index { index }
+        {
+        }
+
+        // Erases the key once its last connection is gone.
+        void connections_changed() override
+        {
+            if (key_signal.slot_count() == 0)
+            {
+                parent_index.erase_if_unused(*this);
+            }
+        }
+
+        // It might be bad, but this is done on purpose.
+        // NOLINTNEXTLINE(cppcoreguidelines-avoid-const-or-ref-data-members)
+        key_index_base& parent_index;
+        signal key_signal;
+        // Only touched with the parent state mutex locked.
+        bool erased { false };
+    };
+
+    template<basic_lockable Mutex, template<class> class SharedPointer>
+        requires shared_pointer_like<SharedPointer>
+    template<signal_arg... Args>
+    class alignas(cache_line_size)
+        emitter<Mutex, SharedPointer>::signal<Args...>::connection_holder_implementation
+        : public connection_holder
+    {
+        // Never modified once shared: pending asynchronous calls keep the handlers that were
+        // attached when they were emitted.
+        using exception_handler_list = SharedPointer<std::vector<exception_handler>>;
+
+        // State that is not needed to emit. It is only allocated when a guard or an exception
+        // handler is attached to the connection, or when its signal has an owner.
+        struct cold_state
+        {
+            exception_handler_list exception_handlers;
+            guard<Mutex, SharedPointer>* connection_guard { nullptr };
+            // Set by rebind. Calls copy it under the mutex, so that they keep the slot they
+            // started with.
+            SharedPointer<slot_interface<Args...>> rebound;
+            // Set once, before the grouped flag.
+            SharedPointer<group_state> group;
+            // Set on connection to a signal with an owner, which lives as long as its connections.
+            SharedPointer<signal_owner> owner;
+            Mutex mutex;
+        };
+
+    public:
+        template<partially_callable<Args...> Callable>
+        connection_holder_implementation(const signal& connected_signal,
+                                         Callable&& callable,
+                                         bool single_shot = false):
+            m_flags { single_shot ? single_shot_flag : 0U },
+            m_slot { generate_slot(std::forward<Callable>(callable)) },
+            m_signal { &connected_signal }
+        {
+            // The hot data fills a single cache line. The cold state only takes a pointer in it,
+            // and lives in its own allocation.
+            static_assert(sizeof(connection_holder_implementation) == cache_line_size);
+            static_assert(alignof(connection_holder_implementation) == cache_line_size);
+        }
+
+        template<partially_callable<Args...> Callable>
+        connection_holder_implementation(const signal& connected_signal,
+                                         Callable&& callable,
+                                         guard<Mutex, SharedPointer>& guard,
+                                         bool single_shot = false):
+            connection_holder_implementation(connected_signal,
+                                             std::forward<Callable>(callable),
+                                             single_shot)
+        {
+            get_cold_state().connection_guard = &guard;
+        }
+
+        connection_holder_implementation(const connection_holder_implementation&) = delete;
+        connection_holder_implementation(connection_holder_implementation&&) = delete;
+
+        auto operator=(const connection_holder_implementation&)
+            -> connection_holder_implementation& = delete;
+        auto operator=(connection_holder_implementation&&)
+            -> connection_holder_implementation& = delete;
+
+        ~connection_holder_implementation() override
+        {
+            delete m_cold_state.load(std::memory_order_acquire);
+        }
+
+        // The owner is the pointer the signal holds this connection with. Asynchronous calls keep
+        // a copy of it, as they may run after the connection is gone from the signal.
+        template<class... EmittedArgs>
+            requires std::invocable<signal::slot, EmittedArgs...>
+        void operator()(const SharedPointer<connection_holder_implementation>& owner,
+                        EmittedArgs&&... args)
+        {
+            auto flags { m_flags.load(std::memory_order_relaxed) };
+            if ((flags & suspended_flag) != 0)
+            {
+                return;
+            }
+            if ((flags & grouped_flag) != 0 && group_suspended())
+            {
+                return;
+            }
+            if ((flags & single_shot_flag) != 0 && !claim_single_shot(flags))
+            {
+                return;
+            }
+
+            if constexpr ((std::is_convertible_v<EmittedArgs&&, Args&&> && ...))
+            {
+                call_moved(owner, std::forward<EmittedArgs>(args)...);
+            }
+            else
+            {
+                call(owner, std::forward<EmittedArgs>(args)...);
+            }
+        }
+
+        // Whether this connection already fired, expired or retired, and waits to be removed.
+        auto expired() const -> bool
+        {
+            return (m_flags.load(std::memory_order_relaxed) & fired_flag) != 0;
+        }
+
+        auto suspended() const -> bool
+        {
+            return (m_flags.load(std::memory_order_relaxed) & suspended_flag) != 0;
+        }
+
+        // The signal no longer holds this connection.
+        void detach()
+        {
+            m_signal.store(nullptr, std::memory_order_release);
+        }
+
+        void disconnect() override
+        {
+            // Drops pending asynchronous calls.
+            m_epoch.fetch_add(1, std::memory_order_release);
+
+            // Only the first disconnection reaches the signal, if it still exists.
+            const auto flags { m_flags.fetch_or(disconnected_flag, std::memory_order_acq_rel) };
+            if ((flags & disconnected_flag) != 0)
+            {
+                return;
+            }
+
+            const auto* connected_signal { m_signal.load(std::memory_order_acquire) };
+            if (connected_signal != nullptr)
+            {
+                connected_signal->disconnect(this);
+                flags_changed(flags, flags | disconnected_flag);
+            }
+
+            release_guard();
+        }
+
+        // Also marked as fired, so that the signal removes it with the fired connections.
+        void retire() override
+        {
+            m_epoch.fetch_add(1, std::memory_order_release);
+
+            constexpr auto retired_flags { fired_flag | disconnected_flag };
+            const auto flags { m_flags.fetch_or(retired_flags, std::memory_order_acq_rel) };
+            if ((flags & disconnected_flag) != 0)
+            {
+                return;
+            }
+
+            flags_changed(flags, flags | retired_flags);
+            release_guard();
+        }
+
+        void expire() override
+        {
+            auto flags { m_flags.load(std::memory_order_relaxed) };
+            do
+            {
+                if (!connected(flags))
+                {
+                    return;
+                }
+            } while (!m_flags.compare_exchange_weak(flags,
+                                                    flags | fired_flag,
+                                                    std::memory_order_acq_rel,
+                                                    std::memory_order_relaxed));
+
+            flags_changed(flags, flags | fired_flag);
+        }
+
+        auto rebind(slot_binding& binding) -> bool override
+        {
+            if (binding.signature() != &slot_signature<Args...>::id)
+            {
+                throw std::invalid_argument { "Rebound slots must take the signal arguments" };
+            }
+
+            // The signal may still hold a disconnected connection until it updates.
+            if ((m_flags.load(std::memory_order_acquire) & disconnected_flag) != 0)
+            {
+                return false;
+            }
+
+            auto replacement {
+                static_cast<typed_slot_binding<SharedPointer, Args...>&>(binding).take_slot()
+            };
+            auto& current_state { get_cold_state() };
+            {
+                // The replaced slot is released once the lock is.
+                std::lock_guard lock { current_state.mutex };
+                std::swap(replacement, current_state.rebound);
+            }
+            m_flags.fetch_or(rebound_flag, std::memory_order_release);
+
+            return true;
+        }
+
+        void join(group_binding& binding) override
+        {
+            auto& current_state { get_cold_state() };
+            {
+                std::lock_guard lock { current_state.mutex };
+                if (current_state.group != nullptr)
+                {
+                    throw std::invalid_argument { "A connection joins one group at most" };
+                }
+                current_state.group =
+                    static_cast<typed_group_binding<SharedPointer>&>(binding).state();
+            }
+            m_flags.fetch_or(grouped_flag, std::memory_order_release);
+        }
+
+        // Pending asynchronous calls are dropped, and are not run on resumption.
+        void suspend() override
+        {
+            const auto flags { m_flags.fetch_or(suspended_flag, std::memory_order_acq_rel) };
+            m_epoch.fetch_add(1, std::memory_order_release);
+            flags_changed(flags, flags | suspended_flag);
+        }
+
+        void resume() override
+        {
+            const auto flags { m_flags.fetch_and(~suspended_flag, std::memory_order_acq_rel) };
+            flags_changed(flags, flags & ~suspended_flag);
+        }
+
+        // Must be called before the connection is published.
+        void keep_owner(SharedPointer<signal_owner> owner)
+        {
+            get_cold_state().owner = std::move(owner);
+        }
+
+        void add_exception_handler(connection_holder::exception_handler handler) override
+        {
+            auto& current_state { get_cold_state() };
+
+            std::lock_guard lock { current_state.mutex };
+            exception_handler_list exception_handlers { new std::vector<exception_handler>() };
+            if (current_state.exception_handlers != nullptr)
+            {
+                *exception_handlers = *current_state.exception_handlers;
+            }
+            exception_handlers->emplace_back(std::move(handler));
+
+            current_state.exception_handlers = std::move(exception_handlers);
+        }
+
+    protected:
+        // Implemented by connection_holder_policy_implementation, which knows the policy.
+        virtual void call(const SharedPointer<connection_holder_implementation>& owner,
+                          shared_slot_arg_t<Args>... args) = 0;
+        virtual void call_moved(const SharedPointer<connection_holder_implementation>& owner,
+                                Args&&... args) = 0;
+
+        template<class... ExecuteArgs>
+        void execute_synchronously(ExecuteArgs&&... execute_args)
+        {
+            const running_connection running { *this };
+
+            try
+            {
+                call_slot(std::forward<ExecuteArgs>(execute_args)...);
+            }
+            catch (...)
+            {
+                handle_exception(copy_exception_handlers());
+            }
+        }
+
+        // For policies taking tasks. The task is recycled once run or discarded.
+        template<class... ExecuteArgs>
+        auto asynchronous_task(const SharedPointer<connection_holder_implementation>& owner,
+                               ExecuteArgs&&... execute_args) -> task&
+        {
+            return object_pool<asynchronous_call>::acquire(
+                owner,
+                m_epoch.load(std::memory_order_relaxed),
+                copy_exception_handlers(),
+                std::forward<ExecuteArgs>(execute_args)...);
+        }
+
+        // For policies taking a std::function, which must be copyable.
+        template<class... ExecuteArgs>
+        auto asynchronous_closure(const SharedPointer<connection_holder_implementation>& owner,
+                                  ExecuteArgs&&... execute_args)
+        {
+            return [holder = owner,
+                    emitted_epoch = m_epoch.load(std::memory_order_relaxed),
+                    exception_handlers = copy_exception_handlers(),
+                    ... args = ref_or_value<Args>(std::forward<ExecuteArgs>(execute_args))] mutable
+            {
+                holder->execute_pending(emitted_epoch,
+                                        exception_handlers,
+                                        std::forward<decltype(args)>(args)...);
+            };
+        }
+
+    private:
+        static constexpr std::uint32_t suspended_flag { 1U << 0U };
+        static constexpr std::uint32_t single_shot_flag { 1U << 1U };
+        static constexpr std::uint32_t fired_flag { 1U << 2U };
+        static constexpr std::uint32_t disconnected_flag { 1U << 3U };
+        static constexpr std::uint32_t rebound_flag { 1U << 4U };
+        static constexpr std::uint32_t grouped_flag { 1U << 5U };
+
+        // Whether the signal counts the connection as connected, and as active.
+        static constexpr auto connected(std::uint32_t flags) -> bool
+        {
+            return (flags & (fired_flag | disconnected_flag)) == 0;
+        }
+
+        static constexpr auto active(std::uint32_t flags) -> bool
+        {
+            return connected(flags) && (flags & suspended_flag) == 0;
+        }
+
+        // Exactly one emission gets to call a single shot connection, whatever the thread. It
+        // doesn't disconnect: the signal removes fired connections in batches, away from emission.
+        auto claim_single_shot(std::uint32_t flags) -> bool
+        {
+            do
+            {
+                if ((flags & (suspended_flag | fired_flag)) != 0)
+                {
+                    return false;
+                }
+            } while (!m_flags.compare_exchange_weak(flags,
+                                                    flags | fired_flag,
+                                                    std::memory_order_acq_rel,
+                                                    std::memory_order_relaxed));
+
+            flags_changed(flags, flags | fired_flag);
+            return true;
+        }
+
+        auto group_suspended() const -> bool
+        {
+            // The flags were read relaxed: this pairs with join setting the grouped flag.
+            std::atomic_thread_fence(std::memory_order_acquire);
+            return m_cold_state.load(std::memory_order_relaxed)
+                ->group->suspended.load(std::memory_order_relaxed);
+        }
+
+        void release_guard()
+        {
+            auto* current_state { m_cold_state.load(std::memory_order_acquire) };
+            if (current_state != nullptr && current_state->connection_guard != nullptr)
+            {
+                guard<Mutex, SharedPointer>* guard { nullptr };
+                std::swap(guard, current_state->connection_guard);
+                guard->clean(this);
+            }
+        }
+
+        // Every change goes through a single atomic operation on the flags, so exactly one thread
+        // reports each transition to the signal. Connections the signal no longer counts have
+        // nothing to report.
+        void flags_changed(std::uint32_t old_flags, std::uint32_t new_flags) const
+        {
+            if (!connected(old_flags) && !connected(new_flags))
+            {
+                return;
+            }
+
+            const auto* connected_signal { m_signal.load(std::memory_order_acquire) };
+            if (connected_signal != nullptr)
+            {
+                const std::ptrdiff_t connected_change { std::ptrdiff_t { connected(new_flags) } -
+                                                         std::ptrdiff_t { connected(old_flags) } };
+                const std::ptrdiff_t active_change { std::ptrdiff_t { active(new_flags) } -
+                                                      std::ptrdiff_t { active(old_flags) } };
+                connected_signal->connection_changed(connected_change, active_change);
+            }
+        }
+
+        // Keeps the connection alive, instead of copying its slot.
+        class asynchronous_call final: public task
+        {
+        public:
+            template<class... CallArgs>
+            asynchronous_call(object_pool<asynchronous_call>& pool,
+                              SharedPointer<connection_holder_implementation> holder,
+                              std::uint32_t emitted_epoch,
+                              exception_handler_list exception_handlers,
+                              CallArgs&&... call_args):
+                m_pool { pool },
+                m_holder { std::move(holder) },
+                m_emitted_epoch { emitted_epoch },
+                m_exception_handlers { std::move(exception_handlers) },
+                m_args { std::forward<CallArgs>(call_args)... }
+            {
+            }
+
+            void run() override
+            {
+                try
+                {
+                    std::apply(
+                        [this]<class... StoredArgs>(StoredArgs&&... stored_args)
+                    {
+                        m_holder->execute_pending(m_emitted_epoch,
+                                                  m_exception_handlers,
+                                                  std::forward<StoredArgs>(stored_args)...);
+                    },
+                        std::move(m_args));
+                }
+                catch (...)
+                {
+                    m_pool.release(*this);
+                    throw;
+                }
+
+                m_pool.release(*this);
+            }
+
+            void discard() override
+            {
+                m_pool.release(*this);
+            }
+
+        private:
+            // It might be bad, but this is done on purpose.
+            // NOLINTNEXTLINE(cppcoreguidelines-avoid-const-or-ref-data-members)
+            object_pool<asynchronous_call>& m_pool;
+            SharedPointer<connection_holder_implementation> m_holder;
+            std::uint32_t m_emitted_epoch;
+            exception_handler_list m_exception_handlers;
+            std::tuple<ref_or_value<Args>...> m_args;
+        };
+
+        // A pending call only runs if its connection was neither disconnected nor suspended since
+        // it was emitted. A call that already started is not interrupted.
+        template<class... ExecuteArgs>
+        void execute_pending(std::uint32_t emitted_epoch,
+                             const exception_handler_list& exception_handlers,
+                             ExecuteArgs&&... execute_args)
+        {
+            if (m_epoch.load(std::memory_order_acquire) != emitted_epoch)
+            {
+                return;
+            }
+
+            const running_connection running { *this };
+
+            try
+            {
+                call_slot(std::forward<ExecuteArgs>(execute_args)...);
+            }
+            catch (...)
+            {
+                handle_exception(exception_handlers);
+            }
+        }
+
+        // The slot given on connection never changes, so that calls read it without locking, until
+        // the connection is rebound. Rebound slots are copied under the lock of the cold state,
+        // and called once it is released.
+        template<class... CallArgs>
+        void call_slot(CallArgs&&... call_args)
+        {
+            if ((m_flags.load(std::memory_order_acquire) & rebound_flag) == 0)
+            {
+                (*m_slot)(std::forward<CallArgs>(call_args)...);
+                return;
+            }
+
+            SharedPointer<slot_interface<Args...>> current_slot;
+            {
+                auto& current_state { *m_cold_state.load(std::memory_order_acquire) };
+                std::lock_guard lock { current_state.mutex };
+                current_slot = current_state.rebound;
+            }
+            (*current_slot)(std::forward<CallArgs>(call_args)...);
+        }
+
+        // Must be called from a catch block.
+        static void handle_exception(const exception_handler_list& exception_handlers)
+        {
+            if (exception_handlers == nullptr || exception_handlers->empty())
+            {
+                throw;
+            }
+            auto current_exception { std::current_exception() };
+            for (const auto& handler: *exception_handlers)
+            {
+                // Exception handlers shouldn't throw. If they do, that's not on us.
+                handler(current_exception);
+            }
+        }
+
+        auto copy_exception_handlers() const -> exception_handler_list
+        {
+            auto* current_state { m_cold_state.load(std::memory_order_acquire) };
+            if (current_state == nullptr)
+            {
+                return {};
+            }
+
+            std::lock_guard lock { current_state->mutex };
+            return current_state->exception_handlers;
+        }
+
+        auto get_cold_state() -> cold_state&
+        {
+            auto* current_state { m_cold_state.load(std::memory_order_acquire) };
+            if (current_state != nullptr)
+            {
+                return *current_state;
+            }
+
+            auto* new_state { new cold_state() };
+            if (m_cold_state.compare_exchange_strong(current_state,
+                                                     new_state,
+                                                     std::memory_order_acq_rel,
+                                                     std::memory_order_acquire))
+            {
+                return *new_state;
+            }
+
+            delete new_state;
+            return *current_state;
+        }
+
+        template<partially_callable<Args...> Callable>
+        static auto generate_slot(Callable&& callable) -> SharedPointer<slot_interface<Args...>>
+        {
+            return SharedPointer<slot_interface<Args...>>(
+                new slot_implementation<std::decay_t<Callable>, Args...>(
+                    std::forward<Callable>(callable)));
+        }
+
+        // Hot data, read on every emit.
+        // Suspension and single shot state, changed without locking.
+        std::atomic<std::uint32_t> m_flags;
+        // Changed on each disconnection or suspension.
+        std::atomic<std::uint32_t> m_epoch { 0 };
+        SharedPointer<slot_interface<Args...>> m_slot;
+
+        // Cold data, only read to manage the connection.
+        std::atomic<const signal*> m_signal;
+        std::atomic<cold_state*> m_cold_state { nullptr };
+    };
+
+    // The policy is known at connection time, so each connection is specialized for it: emitting
+    // costs a single virtual call, and the policy receives the closure or task itself. The memory
+    // of connections is recycled, so that connecting and disconnecting repeatedly doesn't go back
+    // to the allocator each time.
+    template<basic_lockable Mutex, template<class> class SharedPointer>
+        requires shared_pointer_like<SharedPointer>
+    template<signal_arg... Args>
+    template<class StoredPolicy>
+    class emitter<Mutex, SharedPointer>::signal<Args...>::connection_holder_policy_implementation
+        final: public connection_holder_implementation
+    {
+    public:
+        template<partially_callable<Args...> Callable, class Policy, class... HolderArgs>
+        connection_holder_policy_implementation(
+            object_pool<connection_holder_policy_implementation>& pool,
+            const signal& connected_signal,
+            Callable&& callable,
+            Policy&& policy,
+            HolderArgs&&... holder_args):
+            connection_holder_implementation(connected_signal,
+                                             std::forward<Callable>(callable),
+                                             std::forward<HolderArgs>(holder_args)...),
+            m_policy(std::forward<Policy>(policy)),
+            m_handle { connection_registry<SharedPointer>::add(*this, &pool, &dispose) }
+        {
+            // The policy is hot as well. Kept by reference or stateless, it goes in the tail
+            // padding of the base class, so that everything emit touches stays on one cache line.
+            // Policies moved into the connection take the room they need. ABIs that don't reuse
+            // tail padding give the policy and the handle a cache line of their own.
+            static_assert(!reuses_tail_padding ||
+                          (!std::is_empty_v<StoredPolicy> &&
+                           std::same_as<StoredPolicy, std::unwrap_reference_t<StoredPolicy>>) ||
+                          sizeof(connection_holder_policy_implementation) == cache_line_size);
+        }
+
+        // Shared pointers delete connections, without knowing about their pool. Connections may
+        // still be pinned through their handles, so they are only disposed of once unpinned.
+        static void operator delete(connection_holder_policy_implementation* holder,
+                                    std::destroying_delete_t,
+                                    std::align_val_t)
+        {
+            connection_registry<SharedPointer>::remove(holder->m_handle);
+        }
+
+        auto handle() const -> connection_handle
+        {
+            return m_handle;
+        }
+
+    private:
+        static void dispose(connection_holder& holder, void* pool)
+        {
+            static_cast<object_pool<connection_holder_policy_implementation>*>(pool)->release(
+                static_cast<connection_holder_policy_implementation&>(holder));
+        }
+
+        using policy_type = std::remove_cvref_t<std::unwrap_reference_t<StoredPolicy>>;
+
+        void call(const SharedPointer<connection_holder_implementation>& owner,
+                  shared_slot_arg_t<Args>... args) override
+        {
+            execute(owner, args...);
+        }
+
+        void call_moved(const SharedPointer<connection_holder_implementation>& owner,
+                        Args&&... args) override
+        {
+            execute(owner, std::forward<Args>(args)...);
+        }
+
+        auto get_policy() -> std::unwrap_reference_t<StoredPolicy>&
+        {
+            return m_policy;
+        }
+
+        template<class... ExecuteArgs>
+        void execute([[maybe_unused]] const SharedPointer<connection_holder_implementation>& owner,
+                     ExecuteArgs&&... execute_args)
+        {
+            if constexpr (policy_type::is_synchronous)
+            {
+                get_policy().execute([&]
+                { this->execute_synchronously(std::forward<ExecuteArgs>(execute_args)...); });
+            }
+            else if constexpr (task_execution_policy<policy_type&>)
+            {
+                get_policy().execute(
+                    this->asynchronous_task(owner, std::forward<ExecuteArgs>(execute_args)...));
+            }
+            else
+            {
+                get_policy().execute(
+                    this->asynchronous_closure(owner, std::forward<ExecuteArgs>(execute_args)...));
+            }
+        }
+
+        [[no_unique_address]] StoredPolicy m_policy;
+        // Last, so that it doesn't push the policy out of the cache line of the connection.
+        connection_handle m_handle;
+    };
+
+    // ### emitter implementation
+
+    template<basic_lockable Mutex, template<class> class SharedPointer>
+        requires shared_pointer_like<SharedPointer>
+    template<class Receiver,
+             signal_arg... ReceiverArgs,
+             source_like Emitter,
+             execution_policy Policy>
+        requires(partially_tuple_callable<
+                 typename emitter<Mutex, SharedPointer>::template signal<ReceiverArgs...>::slot,
+                 typename std::remove_cvref_t<Emitter>::args>)
+    auto emitter<Mutex, SharedPointer>::connect(
+        this const Receiver& self,
+        Emitter&& emitter,
+        ::details::emitter<Mutex, SharedPointer>::template signal<ReceiverArgs...> Receiver::*
+            receiver_signal,
+        Policy&& policy) -> typename std::remove_cvref_t<Emitter>::connection_type
+    {
+        auto connection { std::forward<Emitter>(emitter).connect(
+            self.forwarding_lambda(receiver_signal),
+            std::forward<Policy>(policy)) };
+        (self.*receiver_signal).add_emitting_source(connection);
+        return connection;
+    }
+
+    template<basic_lockable Mutex, template<class> class SharedPointer>
+        requires shared_pointer_like<SharedPointer>
+    template<class Receiver,
+             signal_arg... ReceiverArgs,
+             source_like Emitter,
+             execution_policy Policy>
+        requires(partially_tuple_callable<
+                 typename emitter<Mutex, SharedPointer>::template signal<ReceiverArgs...>::slot,
+                 typename std::remove_cvref_t<Emitter>::args>)
+    auto emitter<Mutex, SharedPointer>::connect_once(
+        this const Receiver& self,
+        Emitter&& emitter,
+        signal<ReceiverArgs...> Receiver::* receiver_signal,
+        Policy&& policy) -> typename std::remove_cvref_t<Emitter>::connection_type
+    {
+        auto connection { std::forward<Emitter>(emitter).connect_once(
+            self.forwarding_lambda(receiver_signal),
+            std::forward<Policy>(policy)) };
+        (self.*receiver_signal).add_emitting_source(connection);
+        return connection;
+    }
+
+    template<class Receiver, class Signal, execution_policy Policy>
+    template<source_like Source>
+    auto forward_result<Receiver, Signal Receiver::*, Policy>::create_connection(Source&& origin) ->
+        typename std::remove_cvref_t<Source>::connection_type
+    {
+        if (m_connect_once)
+        {
+            return m_receiver.connect_once(std::forward<Source>(origin),
+                                           m_receiver_signal,
+                                           m_policy);
+        }
+        return m_receiver.connect(std::forward<Source>(origin), m_receiver_signal, m_policy);
+    }
+
+    template<basic_lockable Mutex, template<class> class SharedPointer>
+        requires shared_pointer_like<SharedPointer>
+    template<class Receiver, signal_arg... ReceiverArgs>
+    auto emitter<Mutex, SharedPointer>::forwarding_lambda(
+        this const Receiver& self,
+        signal<ReceiverArgs...> Receiver::* receiver_signal)
+    {
+        // Going through the receiver, so that blocking it also blocks what it forwards.
+        return [&self, receiver_signal]<signal_arg... Args>(Args&&... args) mutable
+            requires partially_callable<std::function<void(ReceiverArgs...)>, Args...>
+        {
+            auto lambda { [&]<class... CallArgs>(CallArgs&&... call_args) mutable
+                              requires(sizeof...(CallArgs) == sizeof...(ReceiverArgs))
+            {
+                if (!forwarding_queue::draining())
+                {
+                    forwarding_queue::emit_and_drain(
+                        [&] { self.emit(receiver_signal, std::forward<CallArgs>(call_args)...); });
+                    return;
+                }
+
+                if constexpr (!(deferrable_arg<ReceiverArgs> && ...))
+                {
+                    self.emit(receiver_signal, std::forward<CallArgs>(call_args)...);
+                }
+                else
+                {
+                    // Nothing would be called, and nothing would be counted as suppressed:
+                    // neither the arguments are copied, nor the emission queued.
+                    const auto& forwarded_signal { self.*receiver_signal };
+                    if (!forwarded_signal.has_active_slots() && !forwarded_signal.blocked() &&
+                        !self.signals_blocked())
+                    {
+                        return;
+                    }
+
+                    using emission = forwarded_emission<Receiver, ReceiverArgs...>;
+                    forwarding_queue::push(
+                        object_pool<emission>::acquire(self,
+                                                     receiver_signal,
+                                                     std::forward<CallArgs>(call_args)...));
+                }
+            } };
+            details::partial_call(lambda, std::forward<Args>(args)...);
+        };
+    }
+
+    // ### signal implementation
+
+    template<basic_lockable Mutex, template<class> class SharedPointer>
+        requires shared_pointer_like<SharedPointer>
+    template<signal_arg... Args>
+    template<partially_callable<Args...> Callable, execution_policy Policy>
+    auto emitter<Mutex, SharedPointer>::signal<Args...>::connect_impl(Callable&& callable,
+                                                                      Policy&& policy,
+                                                                      bool connect_once) const
+        -> connection<SharedPointer>
+    {
+        auto& current_state { get_state() };
+
+        connection_handle handle {};
+        {
+            std::lock_guard lock { current_state.mutex };
+            SharedPointer<slot_list> slots { new slot_list() };
+
+            slots->reserve(current_state.slots->size() + 1);
+            std::ranges::copy(*current_state.slots, std::back_inserter(*slots));
+
+            using holder_type = connection_holder_policy_implementation<stored_policy_t<Policy>>;
+            auto& holder { object_pool<holder_type>::acquire(*this,
+                                                             std::forward<Callable>(callable),
+                                                             std::forward<Policy>(policy),
+                                                             connect_once) };
+            if (auto owner { current_state.owner.lock() })
+            {
+                holder.keep_owner(std::move(owner));
+            }
+            slots->emplace_back(&holder);
+
+            std::swap(slots, current_state.slots);
+            mark_outdated(current_state);
+            count_connections(current_state, 1, 1);
+            handle = holder.handle();
+        }
+
+        free_replaced_frozen(current_state);
+        return connection<SharedPointer> { handle };
+    }
+
+    template<basic_lockable Mutex, template<class> class SharedPointer>
+        requires shared_pointer_like<SharedPointer>
+    template<signal_arg... Args>
+    template<partially_callable<Args...> Callable, execution_policy Policy>
+    auto emitter<Mutex, SharedPointer>::signal<Args...>::connect(Callable&& callable,
+                                                                 Policy&& policy) const
+        -> connection<SharedPointer>
+    {
+        return connect_impl(std::forward<Callable>(callable), std::forward<Policy>(policy), false);
+    }
+
+    template<basic_lockable Mutex, template<class> class SharedPointer>
+        requires shared_pointer_like<SharedPointer>
+    template<signal_arg... Args>
+    template<partially_callable<Args...> Callable, execution_policy Policy>
+    auto emitter<Mutex, SharedPointer>::signal<Args...>::connect_once(Callable&& callable,
+                                                                      Policy&& policy) const
+        -> connection<SharedPointer>
+    {
+        return connect_impl(std::forward<Callable>(callable), std::forward<Policy>(policy), true);
+    }
+
+    template<basic_lockable Mutex, template<class> class SharedPointer>
+        requires shared_pointer_like<SharedPointer>
+    template<signal_arg... Args>
+    template<partially_callable<Args...> Callable, guard_like Receiver, execution_policy Policy>
+    auto emitter<Mutex, SharedPointer>::signal<Args...>::connect_with_guard(Callable&& callable,
+                                                                            const Receiver& guard,
+                                                                            Policy&& policy,
+                                                                            bool connect_once) const
+        -> connection<SharedPointer>
+    {
+        auto connection { connect_impl(std::forward<Callable>(callable),
+                                       std::forward<Policy>(policy),
+                                       connect_once) };
+        guard.add_emitting_source(connection);
+
+        return connection;
+    }
+
+    template<basic_lockable Mutex, template<class> class SharedPointer>
+        requires shared_pointer_like<SharedPointer>
+    template<signal_arg... Args>
+    template<partially_callable<Args...> Callable, guard_like Receiver, execution_policy Policy>
+    auto emitter<Mutex, SharedPointer>::signal<Args...>::connect(Callable&& callable,
+                                                                 const Receiver& guard,
+                                                                 Policy&& policy) const
+        -> connection<SharedPointer>
+    {
+        return connect_with_guard(std::forward<Callable>(callable),
+                                  guard,
+                                  std::forward<Policy>(policy),
+                                  false);
+    }
+
+    template<basic_lockable Mutex, template<class> class SharedPointer>
+        requires shared_pointer_like<SharedPointer>
+    template<signal_arg... Args>
+    template<partially_callable<Args...> Callable, guard_like Receiver, execution_policy Policy>
+    auto emitter<Mutex, SharedPointer>::signal<Args...>::connect_once(Callable&& callable,
+                                                                      const Receiver& guard,
+                                                                      Policy&& policy) const
+        -> connection<SharedPointer>
+    {
+        return connect_with_guard(std::forward<Callable>(callable),
+                                  guard,
+                                  std::forward<Policy>(policy),
+                                  true);
+    }
+
+    template<basic_lockable Mutex, template<class> class SharedPointer>
+        requires shared_pointer_like<SharedPointer>
+    template<signal_arg... Args>
+    template<guard_like Receiver,
+             class Result,
+             execution_policy Policy,
+             class... MemberFunctionArgs>
+        requires partially_callable<Result (Receiver::*)(MemberFunctionArgs...), Receiver, Args...>
+    auto emitter<Mutex, SharedPointer>::signal<Args...>::connect(
+        Result (Receiver::*callable)(MemberFunctionArgs...),
+        Receiver& guard,
+        Policy&& policy) const -> connection<SharedPointer>
+    {
+        return connect_with_guard(member_function_lambda(callable, guard),
+                                  guard,
+                                  std::forward<Policy>(policy),
+                                  false);
+    }
+
+    template<basic_lockable Mutex, template<class> class SharedPointer>
+        requires shared_pointer_like<SharedPointer>
+    template<signal_arg... Args>
+    template<guard_like Receiver,
+             class Result,
+             execution_policy Policy,
+             class... MemberFunctionArgs>
+        requires partially_callable<Result (Receiver::*)(MemberFunctionArgs...), Receiver, Args...>
+    auto emitter<Mutex, SharedPointer>::signal<Args...>::connect_once(
+        Result (Receiver::*callable)(MemberFunctionArgs...),
+        Receiver& guard,
+        Policy&& policy) const -> connection<SharedPointer>
+    {
+        return connect_with_guard(member_function_lambda(callable, guard),
+                                  guard,
+                                  std::forward<Policy>(policy),
+                                  true);
+    }
+
+    template<basic_lockable Mutex, template<class> class SharedPointer>
+        requires shared_pointer_like<SharedPointer>
+    template<signal_arg... Args>
+    template<guard_like Receiver,
+             class Result,
+             execution_policy Policy,
+             class... MemberFunctionArgs>
+        requires partially_callable<Result (Receiver::*)(MemberFunctionArgs...) const,
+                                    const Receiver,
+                                    Args...>
+    auto emitter<Mutex, SharedPointer>::signal<Args...>::connect(
+        Result (Receiver::*callable)(MemberFunctionArgs...) const,
+        const Receiver& guard,
+        Policy&& policy) const -> connection<SharedPointer>
+    {
+        return connect_with_guard(member_function_lambda(callable, guard),
+                                  guard,
+                                  std::forward<Policy>(policy),
+                                  false);
+    }
+
+    template<basic_lockable Mutex, template<class> class SharedPointer>
+        requires shared_pointer_like<SharedPointer>
+    template<signal_arg... Args>
+    template<guard_like Receiver,
+             class Result,
+             execution_policy Policy,
+             class... MemberFunctionArgs>
+        requires partially_callable<Result (Receiver::*)(MemberFunctionArgs...) const,
+                                    const Receiver,
+                                    Args...>
+    auto emitter<Mutex, SharedPointer>::signal<Args...>::connect_once(
+        Result (Receiver::*callable)(MemberFunctionArgs...) const,
+        const Receiver& guard,
+        Policy&& policy) const -> connection<SharedPointer>
+    {
+        return connect_with_guard(member_function_lambda(callable, guard),
+                                  guard,
+                                  std::forward<Policy>(policy),
+                                  true);
+    }
+
+    // ### connect class
+
+    template<class Callable, execution_policy Policy>
+    class connect_base
+    {
+    public:
+        connect_base(Callable&& callable, Policy&& policy):
+            m_callable { std::forward<Callable>(callable) },
+            m_policy { std::forward<Policy>(policy) }
+        {
+        }
+
+    protected:
+        // It might be bad, but this is done on purpose.
+        // NOLINTNEXTLINE(misc-non-private-member-variables-in-classes)
+        std::decay_t<Callable> m_callable;
+        // It might be bad, but this is done on purpose.
+        // NOLINTNEXTLINE(misc-non-private-member-variables-in-classes)
+        std::remove_reference_t<Policy> m_policy;
+    };
+} // namespace details
+
+template<class Callable, details::execution_policy Policy>
+class connect<Callable, void, Policy>: public details::connect_base<Callable, Policy>
+{
+public:
+    explicit connect(Callable&& callable, Policy&& policy = {}):
+        details::connect_base<Callable, Policy> { std::forward<Callable>(callable),
+                                                  std::forward<Policy>(policy) }
+    {
+    }
+
+    template<source_like Source>
+    auto create_connection(Source&& origin) -> std::remove_cvref_t<Source>::connection_type
+    {
+        return std::forward<Source>(origin).connect(
+            details::connect_base<Callable, Policy>::m_callable,
+            details::connect_base<Callable, Policy>::m_policy);
+    }
+};
+
+template<class Callable, guard_like Guard, details::execution_policy Policy>
+class connect<Callable, Guard, Policy>: public details::connect_base<Callable, Policy>
+{
+public:
+    connect(Callable&& callable, const Guard& guard, Policy&& policy = {}):
+        details::connect_base<Callable, Policy> { std::forward<Callable>(callable),
+                                                  std::forward<Policy>(policy) },
+        m_guard { guard }
+    {
+    }
+
+    template<source_like Source>
+    auto create_connection(Source&& origin) -> std::remove_cvref_t<Source>::connection_type
+    {
+        return std::forward<Source>(origin).connect(
+            details::connect_base<Callable, Policy>::m_callable,
+            m_guard,
+            details::connect_base<Callable, Policy>::m_policy);
+    }
+
+private:
+    // It might be bad, but this is done on purpose.
+    // NOLINTNEXTLINE(cppcoreguidelines-avoid-const-or-ref-data-members)
+    const Guard& m_guard;
+};
+
+template<class Result, class... Args, guard_like Guard, details::execution_policy Policy>
+class connect<Result (Guard::*)(Args...), Guard, Policy>
+    : public details::connect_base<Result (Guard::*)(Args...), Policy>
+{
+public:
+    connect(Result (Guard::*callable)(Args...), Guard& guard, Policy&& policy = {}):
+        details::connect_base<Result (Guard::*)(Args...), Policy>(std::move(callable),
+                                                                  std::forward<Policy>(policy)),
+        m_guard { guard }
+    {
+    }
+
+    template<source_like Source>
+    auto create_connection(Source&& origin) -> std::remove_cvref_t<Source>::connection_type
+    {
+        return std::forward<Source>(origin).connect(
+            details::connect_base<Result (Guard::*)(Args...), Policy>::m_callable,
+            m_guard,
+            details::connect_base<Result (Guard::*)(Args...), Policy>::m_policy);
+    }
+
+private:
+    // It might be bad, but this is done on purpose.
+    // NOLINTNEXTLINE(cppcoreguidelines-avoid-const-or-ref-data-members)
+    Guard& m_guard;
+};
+
+template<class Result, class... Args, guard_like Guard, details::execution_policy Policy>
+class connect<Result (Guard::*)(Args...) const, const Guard, Policy>
+    : public details::connect_base<Result (Guard::*)(Args...) const, Policy>
+{
+public:
+    connect(Result (Guard::*callable)(Args...) const, const Guard& guard, Policy&& policy = {}):
+        details::connect_base<Result (Guard::*)(Args...) const, Policy>(
+            std::move(callable),
+            std::forward<Policy>(policy)),
+        m_guard { guard }
+    {
+    }
+
+    template<source_like Source>
+    auto create_connection(Source&& origin) -> std::remove_cvref_t<Source>::connection_type
+    {
+        return std::forward<Source>(origin).connect(
+            details::connect_base<Result (Guard::*)(Args...) const, Policy>::m_callable,
+            m_guard,
+            details::connect_base<Result (Guard::*)(Args...) const, Policy>::m_policy);
+    }
+
+private:
+    // It might be bad, but this is done on purpose.
+    // NOLINTNEXTLINE(cppcoreguidelines-avoid-const-or-ref-data-members)
+    const Guard& m_guard;
+};
+
+template<class Result, class... Args, guard_like Guard, details::execution_policy Policy>
+connect(Result (Guard::*)(Args...) const, const Guard&, Policy)
+    -> connect<Result (Guard::*)(Args...) const, Guard, Policy>;
+
+template<class Result, class... Args, guard_like Guard>
+connect(Result (Guard::*)(Args...) const, const Guard&)
+    -> connect<Result (Guard::*)(Args...) const, Guard, details::synchronous_policy>;
+
+template<class Result, class... Args, guard_like Guard, details::execution_policy Policy>
+connect(Result (Guard::*)(Args...), Guard&, Policy)
+    -> connect<Result (Guard::*)(Args...), Guard, Policy>;
+
+template<class Result, class... Args, guard_like Guard>
+connect(Result (Guard::*)(Args...), Guard&)
+    -> connect<Result (Guard::*)(Args...), Guard, details::synchronous_policy>;
+
+template<class Callable, guard_like Guard, details::execution_policy Policy>
+connect(Callable&&, const Guard&, Policy&&) -> connect<Callable, Guard, Policy>;
+
+template<class Callable, guard_like Guard>
+connect(Callable&&, const Guard&) -> connect<Callable, Guard, details::synchronous_policy>;
+
+template<class Callable, details::execution_policy Policy>
+connect(Callable&&, Policy&&) -> connect<Callable, void, Policy>;
+
+template<class Callable>
+connect(Callable&&) -> connect<Callable, void, details::synchronous_policy>;
+
+// ### topic_broker
+
+namespace details
+{
+    // Routes emissions by topic, such as "md.eq.US.AAPL.trade", whose levels are separated by
+    // dots. A subscription pattern may use "*" for any single level, and end with "#" for any
+    // number of levels, none included. Publishing costs the depth of the topic and the matching
+    // subscriptions: subscriptions are kept in a trie, and the subscriptions matching recently
+    // published topics are cached. Nodes of the trie are erased once nothing subscribes to them
+    // or to their children.
+    template<basic_lockable Mutex, template<class> class SharedPointer, signal_arg... Args>
+        requires shared_pointer_like<SharedPointer>
+    class topic_broker
+    {
+    public:
+        static constexpr std::size_t default_cache_capacity { 1024 };
+
+        explicit topic_broker(std::size_t cache_capacity = default_cache_capacity):
+            m_root { *this, nullptr },
+            m_cache_capacity { cache_capacity }
+        {
+        }
+
+        topic_broker(const topic_broker&) = delete;
+        topic_broker(topic_broker&&) = delete;
+
+        auto operator=(const topic_broker&) -> topic_broker& = delete;
+        auto operator=(topic_broker&&) -> topic_broker& = delete;
+
+        // Subscriptions may outlive the broker, and must let go of their patterns.
+        ~topic_broker()
+        {
+            release_subscriptions(m_root);
+        }
+
+        // Takes whatever a signal connect takes after the pattern. Throws std::invalid_argument
+        // if "#" isn't the last level of the pattern.
+        template<class... ConnectArgs>
+        auto subscribe(std::string_view pattern, ConnectArgs&&... connect_args)
+            -> connection<SharedPointer>
+        {
+            const subscription pending { *this, pattern };
+            return pending.subscribed().topic_signal.connect(
+                std::forward<ConnectArgs>(connect_args)...);
+        }
+
+        template<class... EmittedArgs>
+            requires std::invocable<std::function<void(Args...)>, EmittedArgs&&...>
+        void publish(std::string_view topic, EmittedArgs&&... emitted_args) const
+        {
+            auto matching { matching_patterns(topic) };
+
+            if (matching->empty())
+            {
+                return;
+            }
+
+            auto begin { matching->begin() };
+            auto previous_to_end { std::prev(matching->end()) };
+
+            for (auto it { begin }; it != previous_to_end; ++it)
+            {
+                pattern_of(*it).publish(emitted_args...);
+            }
+
+            pattern_of(matching->back()).publish(std::forward<EmittedArgs>(emitted_args)...);
+        }
+
+    private:
+        static constexpr std::string_view single_level_wildcard { "*" };
+        static constexpr std::string_view multi_level_wildcard { "#" };
+
+        struct string_hash
+        {
+            using is_transparent = void;
+
+            auto operator()(std::string_view value) const -> std::size_t
+            {
+                return std::hash<std::string_view> {}(value);
+            }
+        };
+
+        struct node;
+
+        // Subscriptions to a pattern share its signal. The signal may outlive the node of the
+        // pattern, as cached matches and subscriptions keep it.
+        class pattern_signal final: public emitter<Mutex, SharedPointer>,
+                                    public signal_owner,
+                                    public connection_observer
+        {
+        public:
+            pattern_signal(topic_broker& broker, node& subscribed_node):
+                m_broker { broker },
+                m_node { &subscribed_node }
+            {
+                topic_signal.observe_connections(*this);
+            }
+
+            template<class... EmittedArgs>
+            void publish(EmittedArgs&&... emitted_args) const
+            {
+                if (topic_signal.has_active_slots())
+                {
+                    this->emit(&pattern_signal::topic_signal,
+                               std::forward<EmittedArgs>(emitted_args)...);
+                }
+            }
+
+            // Erases the node of the pattern once its last subscription is gone.
+            void connections_changed() override
+            {
+                if (topic_signal.slot_count() == 0)
+                {
+                    m_broker.erase_if_unused(*this);
+                }
+            }
+
+            // Must be called with the broker mutex locked.
+            auto pattern_node() const -> node*
+            {
+                return m_node;
+            }
+
+            // Must be called with the broker mutex locked. The subscriptions that are left may
+            // outlive the pattern, and let go of it.
+            void erase()
+            {
+                m_node = nullptr;
+                topic_signal.release_connections();
+            }
+
+            // It might be bad, but this is done on purpose.
+            // NOLINTNEXTLINE(misc-non-private-member-variables-in-classes)
+            typename emitter<Mutex, SharedPointer>::template signal<Args...> topic_signal;
+
+        private:
+            // It might be bad, but this is done on purpose.
+            // NOLINTNEXTLINE(cppcoreguidelines-avoid-const-or-ref-data-members)
+            topic_broker& m_broker;
+            // Null once the node is erased.
+            node* m_node;
+        };
+
+        // Only touched with the broker mutex locked.
+        struct node
+        {
+            node(topic_broker& broker, node* parent_node):
+                pattern { new pattern_signal(broker, *this) },
+                parent { parent_node }
+            {
+                pattern_of(pattern).topic_signal.set_owner(pattern);
+            }
+
+            auto child(std::string_view level) const -> const node*
+            {
+                auto it { children.find(level) };
+                return it == children.end() ? nullptr : it->second.get();
+            }
+
+            auto unused() const -> bool
+            {
+                return children.empty() && subscribing == 0 &&
+                       pattern_of(pattern).topic_signal.slot_count() == 0;
+            }
+
+            // It might be bad, but this is done on purpose.
+            // NOLINTBEGIN(misc-non-private-member-variables-in-classes)
+            SharedPointer<signal_owner> pattern;
+            // Null for the root.
+            node* parent;
+            // The key of the node in the children of its parent, which doesn't move.
+            std::string_view level;
+            // Subscriptions being made, which the node must outlive.
+            std::size_t subscribing { 0 };
+            std::unordered_map<std::string, std::unique_ptr<node>, string_hash, std::equal_to<>>
+                children;
+            // NOLINTEND(misc-non-private-member-variables-in-classes)
+        };
+
+        // Keeps the node of the pattern until the subscription is made, then erases it if the
+        // subscription is already gone.
+        class subscription
+        {
+        public:
+            subscription(topic_broker& broker, std::string_view pattern):
+                m_broker { broker },
+                m_pattern { broker.subscription_pattern(pattern) }
+            {
+            }
+
+            subscription(const subscription&) = delete;
+            subscription(subscription&&) = delete;
+
+            auto operator=(const subscription&) -> subscription& = delete;
+            auto operator=(subscription&&) -> subscription& = delete;
+
+            ~subscription()
+            {
+                m_broker.finish_subscription(pattern_of(m_pattern));
+            }
+
+            auto subscribed() const -> pattern_signal&
+            {
+                return pattern_of(m_pattern);
+            }
+
+        private:
+            // It might be bad, but this is done on purpose.
+            // NOLINTNEXTLINE(cppcoreguidelines-avoid-const-or-ref-data-members)
+            topic_broker& m_broker;
+            SharedPointer<signal_owner> m_pattern;
+        };
+
+        using pattern_list = std::vector<SharedPointer<signal_owner>>;
+
+        struct cached_match
+        {
+            SharedPointer<pattern_list> matching;
+            typename std::list<std::string_view>::iterator recent;
+        };
+
+        using topic_cache =
+            std::unordered_map<std::string, cached_match, string_hash, std::equal_to<>>;
+
+        static auto pattern_of(const SharedPointer<signal_owner>& pattern) -> pattern_signal&
+        {
+            return *static_cast<pattern_signal*>(pattern.get());
+        }
+
+        // Splits the first level off the topic, which is left null once there is none left.
+        static auto next_level(std::string_view& topic, std::string_view& level) -> bool
+        {
+            if (topic.data() == nullptr)
+            {
+                return false;
+            }
+
+            auto separator { topic.find('.') };
+            level = topic.substr(0, separator);
+            topic = separator == std::string_view::npos ? std::string_view {}
+                                                        : topic.substr(separator + 1);
+            return true;
+        }
+
+        auto subscription_pattern(std::string_view pattern) -> SharedPointer<signal_owner>
+        {
+            std::string_view level;
+            for (auto remaining_pattern { pattern }; next_level(remaining_pattern, level);)
+            {
+                if (level == multi_level_wildcard && remaining_pattern.data() != nullptr)
+                {
+                    throw std::invalid_argument { "\"#\" must be the last level of a pattern" };
+                }
+            }
+
+            std::lock_guard lock { m_mutex };
+
+            auto* current { &m_root };
+            bool created { false };
+            while (next_level(pattern, level))
+            {
+                auto it { current->children.find(level) };
+                if (it == current->children.end())
+                {
+                    it = current->children.emplace(level, std::make_unique<node>(*this, current))
+                             .first;
+                    it->second->level = it->first;
+                    created = true;
+                }
+                current = it->second.get();
+            }
+
+            // Cached topics may match the new nodes.
+            if (created)
+            {
+                clear_cache();
+            }
+
+            ++current->subscribing;
+            return current->pattern;
+        }
+
+        void finish_subscription(pattern_signal& subscribed)
+        {
+            // Released once the lock is.
+            std::vector<std::unique_ptr<node>> erased;
+
+            std::lock_guard lock { m_mutex };
+            auto* subscribed_node { subscribed.pattern_node() };
+            --subscribed_node->subscribing;
+            erased = erase_unused(subscribed_node);
+        }
+
+        void erase_if_unused(pattern_signal& changed)
+        {
+            // Released once the lock is.
+            std::vector<std::unique_ptr<node>> erased;
+
+            std::lock_guard lock { m_mutex };
+            erased = erase_unused(changed.pattern_node());
+        }
+
+        // Must be called with the mutex locked. Erases the node, then its ancestors, while they
+        // have neither subscriptions, children, nor subscriptions being made. Returns them, for
+        // the caller to release. Cached matches may hold their patterns: they are dropped.
+        auto erase_unused(node* current) -> std::vector<std::unique_ptr<node>>
+        {
+            std::vector<std::unique_ptr<node>> erased;
+            while (current != nullptr && current->parent != nullptr && current->unused())
+            {
+                auto* parent { current->parent };
+                auto erased_node { parent->children.find(current->level) };
+                pattern_of(current->pattern).erase();
+                erased.emplace_back(std::move(erased_node->second));
+                parent->children.erase(erased_node);
+                current = parent;
+            }
+
+            if (!erased.empty())
+            {
+                clear_cache();
+            }
+
+            return erased;
+        }
+
+        static void release_subscriptions(node& released)
+        {
+            pattern_of(released.pattern).topic_signal.release_connections();
+            for (const auto& child: released.children)
+            {
+                release_subscriptions(*child.second);
+            }
+        }
+
+        // Topics matching no pattern aren't cached, so that publishing to many of them doesn't
+        // evict the others. Once full, the least recently published topic is evicted.
+        auto matching_patterns(std::string_view topic) const -> SharedPointer<pattern_list>
+        {
+            std::lock_guard lock { m_mutex };
+
+            if (auto cached { m_cache.find(topic) }; cached != m_cache.end())
+            {
+                m_recent.splice(m_recent.begin(), m_recent, cached->second.recent);
+                return cached->second.matching;
+            }
+
+            SharedPointer<pattern_list> matching { new pattern_list() };
+            std::vector<const node*> current_level { &m_root };
+            std::vector<const node*> next_level_nodes;
 
-    // ### connect class
+            auto remaining_topic { topic };
+            std::string_view level;
+            while (next_level(remaining_topic, level))
+            {
+                for (const auto* current: current_level)
+                {
+                    // The rest of the topic, one level at least.
+                    if (const auto* any_levels { current->child(multi_level_wildcard) })
+                    {
+                        matching->emplace_back(any_levels->pattern);
+                    }
+                    if (const auto* exact { current->child(level) })
+                    {
+                        next_level_nodes.emplace_back(exact);
+                    }
+                    if (const auto* any_level { current->child(single_level_wildcard) })
+                    {
+                        next_level_nodes.emplace_back(any_level);
+                    }
+                }
 
-    template<class Callable, execution_policy Policy>
-    class connect_base
-    {
-    public:
-        connect_base(Callable&& callable, Policy&& policy):
-            m_callable { std::forward<Callable>(callable) },
-            m_policy { std::forward<Policy>(policy) }
+                std::swap(current_level, next_level_nodes);
+                next_level_nodes.clear();
+            }
+
+            for (const auto* current: current_level)
+            {
+                matching->emplace_back(current->pattern);
+                // No level left.
+                if (const auto* any_levels { current->child(multi_level_wildcard) })
+                {
+                    matching->emplace_back(any_levels->pattern);
+                }
+            }
+
+            if (matching->empty() || m_cache_capacity == 0)
+            {
+                return matching;
+            }
+
+            if (m_cache.size() == m_cache_capacity)
+            {
+                m_cache.erase(m_cache.find(m_recent.back()));
+                m_recent.pop_back();
+            }
+            auto cached { m_cache.emplace(topic, cached_match { .matching = matching }).first };
+            m_recent.emplace_front(cached->first);
+            cached->second.recent = m_recent.begin();
+
+            return matching;
+        }
+
+        void clear_cache() const
         {
+            m_cache.clear();
+            m_recent.clear();
         }
 
-    protected:
-        // It might be bad, but this is done on purpose.
-        // NOLINTNEXTLINE(misc-non-private-member-variables-in-classes)
-        std::decay_t<Callable> m_callable;
-        // It might be bad, but this is done on purpose.
-        // NOLINTNEXTLINE(misc-non-private-member-variables-in-classes)
-        std::remove_reference_t<Policy> m_policy;
+        node m_root;
+        std::size_t m_cache_capacity;
+        mutable topic_cache m_cache;
+        // Cached topics, the most recently published first. Views of the keys of the cache.
+        mutable std::list<std::string_view> m_recent;
+        mutable Mutex m_mutex;
     };
 } // namespace details
 
-template<class Callable, details::execution_policy Policy>
-class connect<Callable, void, Policy>: public details::connect_base<Callable, Policy>
-{
-public:
-    explicit connect(Callable&& callable, Policy&& policy = {}):
-        details::connect_base<Callable, Policy> { std::forward<Callable>(callable),
-                                                  std::forward<Policy>(policy) }
-    {
-    }
+using basic_emitter = details::emitter<details::fake_mutex, details::unsafe_shared_pointer>;
+using safe_emitter = details::emitter<std::mutex, std::shared_ptr>;
+using basic_receiver = details::receiver<details::fake_mutex, details::unsafe_shared_pointer>;
+using safe_receiver = details::receiver<std::mutex, std::shared_ptr>;
+using basic_connection_group =
+    details::connection_group<details::fake_mutex, details::unsafe_shared_pointer>;
+using safe_connection_group = details::connection_group<std::mutex, std::shared_ptr>;
+using task = details::task;
 
-    template<source_like Source>
-    auto create_connection(Source&& origin) -> std::remove_cvref_t<Source>::connection_type
-    {
-        return std::forward<Source>(origin).connect(
-            details::connect_base<Callable, Policy>::m_callable,
-            details::connect_base<Callable, Policy>::m_policy);
-    }
-};
+template<details::clock_like Clock = std::chrono::steady_clock>
+using timer_wheel = details::timer_wheel<details::fake_mutex, Clock>;
+template<details::clock_like Clock = std::chrono::steady_clock>
+using safe_timer_wheel = details::timer_wheel<std::mutex, Clock>;
 
-template<class Callable, guard_like Guard, details::execution_policy Policy>
-class connect<Callable, Guard, Policy>: public details::connect_base<Callable, Policy>
+// ### combiners
+
+// Combiners of the results of slots, for signals returning results. None of them allocates.
+namespace combiners
 {
-public:
-    connect(Callable&& callable, const Guard& guard, Policy&& policy = {}):
-        details::connect_base<Callable, Policy> { std::forward<Callable>(callable),
-                                                  std::forward<Policy>(policy) },
-        m_guard { guard }
+    template<class T>
+    class sum
     {
-    }
+    public:
+        void accept(T value)
+        {
+            m_total += std::move(value);
+        }
 
-    template<source_like Source>
-    auto create_connection(Source&& origin) -> std::remove_cvref_t<Source>::connection_type
-    {
-        return std::forward<Source>(origin).connect(
-            details::connect_base<Callable, Policy>::m_callable,
-            m_guard,
-            details::connect_base<Callable, Policy>::m_policy);
-    }
+        auto done() const -> bool
+        {
+            return false;
+        }
 
-private:
-    // It might be bad, but this is done on purpose.
-    // NOLINTNEXTLINE(cppcoreguidelines-avoid-const-or-ref-data-members)
-    const Guard& m_guard;
-};
+        auto result() const -> T
+        {
+            return m_total;
+        }
 
-template<class Result, class... Args, guard_like Guard, details::execution_policy Policy>
-class connect<Result (Guard::*)(Args...), Guard, Policy>
-    : public details::connect_base<Result (Guard::*)(Args...), Policy>
-{
-public:
-    connect(Result (Guard::*callable)(Args...), Guard& guard, Policy&& policy = {}):
-        details::connect_base<Result (Guard::*)(Args...), Policy>(std::move(callable),
-                                                                  std::forward<Policy>(policy)),
-        m_guard { guard }
+    private:
+        T m_total {};
+    };
+
+    // Empty if no slot was called.
+    template<class T>
+    class minimum
     {
-    }
+    public:
+        void accept(T value)
+        {
+            if (!m_minimum.has_value() || value < *m_minimum)
+            {
+                m_minimum = std::move(value);
+            }
+        }
 
-    template<source_like Source>
-    auto create_connection(Source&& origin) -> std::remove_cvref_t<Source>::connection_type
+        auto done() const -> bool
+        {
+            return false;
+        }
+
+        auto result() const -> std::optional<T>
+        {
+            return m_minimum;
+        }
+
+    private:
+        std::optional<T> m_minimum;
+    };
+
+    // Empty if no slot was called.
+    template<class T>
+    class maximum
     {
-        return std::forward<Source>(origin).connect(
-            details::connect_base<Result (Guard::*)(Args...), Policy>::m_callable,
-            m_guard,
-            details::connect_base<Result (Guard::*)(Args...), Policy>::m_policy);
-    }
+    public:
+        void accept(T value)
+        {
+            if (!m_maximum.has_value() || *m_maximum < value)
+            {
+                m_maximum = std::move(value);
+            }
+        }
 
-private:
-    // It might be bad, but this is done on purpose.
-    // NOLINTNEXTLINE(cppcoreguidelines-avoid-const-or-ref-data-members)
-    Guard& m_guard;
-};
+        auto done() const -> bool
+        {
+            return false;
+        }
 
-template<class Result, class... Args, guard_like Guard, details::execution_policy Policy>
-class connect<Result (Guard::*)(Args...) const, const Guard, Policy>
-    : public details::connect_base<Result (Guard::*)(Args...) const, Policy>
-{
-public:
-    connect(Result (Guard::*callable)(Args...) const, const Guard& guard, Policy&& policy = {}):
-        details::connect_base<Result (Guard::*)(Args...) const, Policy>(
-            std::move(callable),
-            std::forward<Policy>(policy)),
-        m_guard { guard }
+        auto result() const -> std::optional<T>
+        {
+            return m_maximum;
+        }
+
+    private:
+        std::optional<T> m_maximum;
+    };
+
+    // The first result converting to true, such as a non empty std::optional. Slots aren't
+    // called anymore once it is found.
+    template<class T>
+    class first_non_empty
     {
-    }
+    public:
+        void accept(T value)
+        {
+            if (static_cast<bool>(value))
+            {
+                m_result = std::move(value);
+                m_found = true;
+            }
+        }
 
-    template<source_like Source>
-    auto create_connection(Source&& origin) -> std::remove_cvref_t<Source>::connection_type
+        auto done() const -> bool
+        {
+            return m_found;
+        }
+
+        auto result() const -> T
+        {
+            return m_result;
+        }
+
+    private:
+        T m_result {};
+        bool m_found { false };
+    };
+
+    // True if no slot was called. Slots aren't called anymore once one returned false.
+    class all_of
     {
-        return std::forward<Source>(origin).connect(
-            details::connect_base<Result (Guard::*)(Args...) const, Policy>::m_callable,
-            m_guard,
-            details::connect_base<Result (Guard::*)(Args...) const, Policy>::m_policy);
-    }
+    public:
+        void accept(bool value)
+        {
+            m_result = value;
+        }
 
-private:
-    // It might be bad, but this is done on purpose.
-    // NOLINTNEXTLINE(cppcoreguidelines-avoid-const-or-ref-data-members)
-    const Guard& m_guard;
-};
+        auto done() const -> bool
+        {
+            return !m_result;
+        }
 
-template<class Result, class... Args, guard_like Guard, details::execution_policy Policy>
-connect(Result (Guard::*)(Args...) const, const Guard&, Policy)
-    -> connect<Result (Guard::*)(Args...) const, Guard, Policy>;
+        auto result() const -> bool
+        {
+            return m_result;
+        }
 
-template<class Result, class... Args, guard_like Guard>
-connect(Result (Guard::*)(Args...) const, const Guard&)
-    -> connect<Result (Guard::*)(Args...) const, Guard, details::synchronous_policy>;
+    private:
+        bool m_result { true };
+    };
 
-template<class Result, class... Args, guard_like Guard, details::execution_policy Policy>
-connect(Result (Guard::*)(Args...), Guard&, Policy)
-    -> connect<Result (Guard::*)(Args...), Guard, Policy>;
+    // False if no slot was called. Slots aren't called anymore once one returned true.
+    class any_of
+    {
+    public:
+        void accept(bool value)
+        {
+            m_result = value;
+        }
 
-template<class Result, class... Args, guard_like Guard>
-connect(Result (Guard::*)(Args...), Guard&)
-    -> connect<Result (Guard::*)(Args...), Guard, details::synchronous_policy>;
+        auto done() const -> bool
+        {
+            return m_result;
+        }
 
-template<class Callable, guard_like Guard, details::execution_policy Policy>
-connect(Callable&&, const Guard&, Policy&&) -> connect<Callable, Guard, Policy>;
+        auto result() const -> bool
+        {
+            return m_result;
+        }
 
-template<class Callable, guard_like Guard>
-connect(Callable&&, const Guard&) -> connect<Callable, Guard, details::synchronous_policy>;
+    private:
+        bool m_result { false };
+    };
 
-template<class Callable, details::execution_policy Policy>
-connect(Callable&&, Policy&&) -> connect<Callable, void, Policy>;
+    // Stores results in a buffer given by the caller, and returns the part of it that was
+    // filled. Slots aren't called anymore once it is full.
+    template<class T>
+    class collect
+    {
+    public:
+        explicit collect(std::span<T> buffer):
+            m_buffer { buffer }
+        {
+        }
 
-template<class Callable>
-connect(Callable&&) -> connect<Callable, void, details::synchronous_policy>;
+        void accept(T value)
+        {
+            m_buffer[m_size++] = std::move(value);
+        }
 
-using basic_emitter = details::emitter<details::fake_mutex, details::unsafe_shared_pointer>;
-using safe_emitter = details::emitter<std::mutex, std::shared_ptr>;
-using basic_receiver = details::receiver<details::fake_mutex, details::unsafe_shared_pointer>;
-using safe_receiver = details::receiver<std::mutex, std::shared_ptr>;
+        auto done() const -> bool
+        {
+            return m_size == m_buffer.size();
+        }
+
+        auto result() const -> std::span<T>
+        {
+            return m_buffer.first(m_size);
+        }
+
+    private:
+        std::span<T> m_buffer;
+        std::size_t m_size { 0 };
+    };
+} // namespace combiners
+
+template<details::signal_arg... Args>
+using topic_broker =
+    details::topic_broker<details::fake_mutex, details::unsafe_shared_pointer, Args...>;
+template<details::signal_arg... Args>
+using safe_topic_broker = details::topic_broker<std::mutex, std::shared_ptr, Args...>;
 
 #endif // STIMULUS_H_
\ No newline at end of file
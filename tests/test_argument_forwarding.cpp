@@ -0,0 +1,150 @@
+#include "stimulus.h"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "utilities.h"
+
+class test_argument_forwarding: public ::testing::Test
+{
+protected:
+    generic_emitter<copy_move_counter> copy_move_emitter;
+    generic_emitter<std::string> string_emitter;
+
+    // Copy and move count seen by each slot, in call order.
+    std::vector<std::pair<int, int>> counters;
+
+    auto const_reference_slot()
+    {
+        return [this](const copy_move_counter& counter)
+        { counters.emplace_back(counter.copy_counter, counter.move_counter); };
+    }
+
+    auto value_slot()
+    {
+        return [this](copy_move_counter counter)
+        { counters.emplace_back(counter.copy_counter, counter.move_counter); };
+    }
+
+    auto rvalue_reference_slot()
+    {
+        return [this](copy_move_counter&& counter)
+        { counters.emplace_back(counter.copy_counter, counter.move_counter); };
+    }
+};
+
+TEST_F(test_argument_forwarding, const_reference_slots_never_copy)
+{
+    for (int i { 0 }; i < 50; ++i)
+    {
+        copy_move_emitter.generic_signal.connect(const_reference_slot());
+    }
+
+    copy_move_emitter.generic_emit({});
+
+    ASSERT_EQ(counters.size(), 50);
+    for (const auto& [copy_count, move_count]: counters)
+    {
+        EXPECT_EQ(copy_count, 0);
+        EXPECT_EQ(move_count, 0);
+    }
+}
+
+TEST_F(test_argument_forwarding, value_slots_copy_all_but_last)
+{
+    copy_move_emitter.generic_signal.connect(value_slot());
+    copy_move_emitter.generic_signal.connect(value_slot());
+    copy_move_emitter.generic_signal.connect(value_slot());
+
+    copy_move_emitter.generic_emit({});
+
+    ASSERT_EQ(counters.size(), 3);
+    EXPECT_EQ(counters[0], std::make_pair(1, 0));
+    EXPECT_EQ(counters[1], std::make_pair(1, 0));
+    // The last slot is the only one allowed to steal the argument.
+    EXPECT_EQ(counters[2], std::make_pair(0, 1));
+}
+
+TEST_F(test_argument_forwarding, only_value_slots_copy)
+{
+    copy_move_emitter.generic_signal.connect(const_reference_slot());
+    copy_move_emitter.generic_signal.connect(value_slot());
+    copy_move_emitter.generic_signal.connect(const_reference_slot());
+
+    copy_move_emitter.generic_emit({});
+
+    ASSERT_EQ(counters.size(), 3);
+    EXPECT_EQ(counters[0], std::make_pair(0, 0));
+    EXPECT_EQ(counters[1], std::make_pair(1, 0));
+    EXPECT_EQ(counters[2], std::make_pair(0, 0));
+}
+
+TEST_F(test_argument_forwarding, rvalue_reference_slots)
+{
+    copy_move_emitter.generic_signal.connect(rvalue_reference_slot());
+    copy_move_emitter.generic_signal.connect(rvalue_reference_slot());
+
+    copy_move_emitter.generic_emit({});
+
+    ASSERT_EQ(counters.size(), 2);
+    // Shared arguments can't be given away, so a copy is made for the first slot.
+    EXPECT_EQ(counters[0], std::make_pair(1, 0));
+    EXPECT_EQ(counters[1], std::make_pair(0, 0));
+}
+
+TEST_F(test_argument_forwarding, mapped_const_reference_slots_never_copy)
+{
+    copy_move_emitter.generic_signal.apply(map<0> {}).connect(const_reference_slot());
+    copy_move_emitter.generic_signal.apply(map<0> {}).connect(const_reference_slot());
+
+    copy_move_emitter.generic_emit({});
+
+    ASSERT_EQ(counters.size(), 2);
+    EXPECT_EQ(counters[0], std::make_pair(0, 0));
+    EXPECT_EQ(counters[1], std::make_pair(0, 0));
+}
+
+TEST_F(test_argument_forwarding, string_shared_between_slots)
+{
+    std::vector<const std::string*> addresses;
+
+    for (int i { 0 }; i < 10; ++i)
+    {
+        string_emitter.generic_signal.connect([&addresses](const std::string& value)
+                                              { addresses.emplace_back(&value); });
+    }
+
+    string_emitter.generic_emit("a string long enough to not fit in the small buffer");
+
+    ASSERT_EQ(addresses.size(), 10);
+    for (const auto* address: addresses)
+    {
+        EXPECT_EQ(address, addresses.front());
+    }
+}
+
+TEST_F(test_argument_forwarding, rvalue_reference_member_function)
+{
+    struct receiver: public basic_receiver
+    {
+        void slot(copy_move_counter&& counter)
+        {
+            counters.emplace_back(counter.copy_counter, counter.move_counter);
+        }
+
+        std::vector<std::pair<int, int>> counters;
+    };
+
+    receiver rec;
+    copy_move_emitter.generic_signal.connect(&receiver::slot, rec);
+    copy_move_emitter.generic_signal.apply(map<0> {}).connect(&receiver::slot, rec);
+
+    copy_move_emitter.generic_emit({});
+
+    ASSERT_EQ(rec.counters.size(), 2);
+    EXPECT_EQ(rec.counters[0], std::make_pair(1, 0));
+    EXPECT_EQ(rec.counters[1], std::make_pair(0, 0));
+}
@@ -0,0 +1,212 @@
+#include "stimulus.h"
+
+#include <exception>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <utility>
+
+#include <gtest/gtest.h>
+#include <vector>
+
+#include "utilities.h"
+
+namespace
+{
+    struct function_policy
+    {
+        void execute(std::function<void()> callable)
+        {
+            callable();
+        }
+
+        static constexpr bool is_synchronous { false };
+    };
+
+    // Takes anything, but doesn't opt in to tasks.
+    struct forwarding_policy
+    {
+        template<class Callable>
+        void execute(Callable&& callable)
+        {
+            std::forward<Callable>(callable)();
+        }
+
+        static constexpr bool is_synchronous { false };
+    };
+} // namespace
+
+static_assert(details::task_execution_policy<task_queue_policy>);
+static_assert(!details::task_execution_policy<function_policy>);
+static_assert(!details::task_execution_policy<details::synchronous_policy>);
+static_assert(!details::task_execution_policy<forwarding_policy>);
+
+class test_asynchronous_tasks: public ::testing::Test
+{
+protected:
+    generic_emitter<int> int_emitter;
+    generic_emitter<copy_move_counter> copy_move_emitter;
+    safe_generic_emitter<int> safe_int_emitter;
+
+    task_queue_policy policy;
+};
+
+TEST_F(test_asynchronous_tasks, tasks_run_in_order)
+{
+    int& count = call_count<int>;
+    reset<int>();
+
+    int_emitter.generic_signal.connect(slot_function<int>, policy);
+
+    int_emitter.generic_emit(5);
+    int_emitter.generic_emit(6);
+    EXPECT_EQ(policy.size(), 2);
+    EXPECT_EQ(policy.function_count, 0);
+    EXPECT_EQ(count, 0);
+
+    policy.run_all();
+    EXPECT_EQ(count, 2);
+    EXPECT_EQ(call_args<int>.front(), 5);
+    EXPECT_EQ(call_args<int>.back(), 6);
+}
+
+TEST_F(test_asynchronous_tasks, copy_move_emit)
+{
+    int& count = call_count<copy_move_counter>;
+    reset<copy_move_counter>();
+
+    copy_move_emitter.generic_signal.connect(slot_function<copy_move_counter>, policy);
+    copy_move_emitter.generic_signal.connect(slot_function<copy_move_counter>, policy);
+
+    copy_move_emitter.generic_emit({});
+    policy.run_all();
+
+    EXPECT_EQ(count, 2);
+    // 1 to store it in the task, as other slots share the emitted argument.
+    EXPECT_EQ(call_args<copy_move_counter>.front().copy_counter, 1);
+    // 1 to pass it to the function, and 1 to store it.
+    EXPECT_EQ(call_args<copy_move_counter>.front().move_counter, 2);
+    EXPECT_EQ(call_args<copy_move_counter>.back().copy_counter, 0);
+    // 1 to store it in the task, 1 to pass it to the function, and 1 to store it.
+    EXPECT_EQ(call_args<copy_move_counter>.back().move_counter, 3);
+}
+
+TEST_F(test_asynchronous_tasks, discarded_task_is_not_run)
+{
+    int& count = call_count<int>;
+    reset<int>();
+
+    int_emitter.generic_signal.connect(slot_function<int>, policy);
+
+    int_emitter.generic_emit(5);
+    policy.pop().discard();
+
+    EXPECT_TRUE(policy.empty());
+    EXPECT_EQ(count, 0);
+}
+
+TEST_F(test_asynchronous_tasks, task_memory_is_recycled)
+{
+    int_emitter.generic_signal.connect([](int) {}, policy);
+
+    int_emitter.generic_emit(5);
+    auto& first_task { policy.pop() };
+    first_task.run();
+
+    int_emitter.generic_emit(6);
+    auto& second_task { policy.pop() };
+    EXPECT_EQ(&first_task, &second_task);
+    second_task.run();
+}
+
+TEST_F(test_asynchronous_tasks, tasks_run_on_another_thread)
+{
+    int& count = call_count<int>;
+    reset<int>();
+
+    safe_int_emitter.generic_signal.connect(slot_function<int>, policy);
+
+    for (int i { 0 }; i < 100; ++i)
+    {
+        safe_int_emitter.generic_emit(i);
+    }
+
+    std::thread worker { [this] { policy.run_all(); } };
+    worker.join();
+    EXPECT_EQ(count, 100);
+
+    // Tasks given back by the worker are taken again.
+    for (int i { 0 }; i < 100; ++i)
+    {
+        safe_int_emitter.generic_emit(i);
+    }
+    policy.run_all();
+    EXPECT_EQ(count, 200);
+}
+
+TEST_F(test_asynchronous_tasks, tasks_outlive_emitting_thread)
+{
+    int& count = call_count<int>;
+    reset<int>();
+
+    safe_int_emitter.generic_signal.connect(slot_function<int>, policy);
+
+    std::thread emitting_thread { [this]
+    {
+        safe_int_emitter.generic_emit(5);
+        safe_int_emitter.generic_emit(6);
+    } };
+    emitting_thread.join();
+
+    policy.run_all();
+    EXPECT_EQ(count, 2);
+}
+
+TEST_F(test_asynchronous_tasks, task_outlives_signal)
+{
+    int& count = call_count<int>;
+    reset<int>();
+
+    auto temporary_emitter { std::make_unique<generic_emitter<int>>() };
+    auto connection { temporary_emitter->generic_signal.connect(slot_function<int>, policy) };
+
+    temporary_emitter->generic_emit(5);
+    temporary_emitter->generic_emit(6);
+    temporary_emitter.reset();
+
+    policy.pop().run();
+    EXPECT_EQ(count, 1);
+
+    // The connection is kept alive by the last task, but its signal is gone.
+    connection.disconnect();
+
+    policy.run_all();
+    EXPECT_EQ(count, 1);
+}
+
+TEST_F(test_asynchronous_tasks, exception_handlers_are_the_emitted_ones)
+{
+    int caught { 0 };
+
+    auto connection { int_emitter.generic_signal.connect([](int value) { throw value; }, policy) };
+
+    int_emitter.generic_emit(5);
+    connection.add_exception_handler([&caught](const std::exception_ptr&) { ++caught; });
+    int_emitter.generic_emit(6);
+
+    EXPECT_THROW(policy.pop().run(), int);
+    EXPECT_EQ(caught, 0);
+
+    policy.pop().run();
+    EXPECT_EQ(caught, 1);
+}
+
+TEST_F(test_asynchronous_tasks, policies_opt_in_to_tasks)
+{
+    int count { 0 };
+    int_emitter.generic_signal.connect([&count](int) { ++count; }, forwarding_policy {});
+
+    int_emitter.generic_emit(5);
+
+    EXPECT_EQ(count, 1);
+}
@@ -0,0 +1,229 @@
+#include "stimulus.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "utilities.h"
+
+using namespace std::chrono_literals;
+
+class test_batching: public ::testing::Test
+{
+protected:
+    generic_emitter<int> int_emitter;
+    generic_emitter<int, std::string> int_string_emitter;
+    safe_generic_emitter<int> safe_int_emitter;
+
+    manual_clock::time_point now {};
+    timer_wheel<manual_clock> wheel { 1ms, manual_clock { &now } };
+
+    std::vector<std::vector<int>> batches;
+
+    auto store_batch()
+    {
+        return [this](std::span<const int> batch)
+        { batches.emplace_back(batch.begin(), batch.end()); };
+    }
+
+    void advance_to(manual_clock::duration time)
+    {
+        now = manual_clock::time_point { time };
+        wheel.advance();
+    }
+};
+
+TEST_F(test_batching, buffer)
+{
+    int_emitter.generic_signal | buffer(3) | connect(store_batch());
+
+    for (int i { 1 }; i <= 7; ++i)
+    {
+        int_emitter.generic_emit(i);
+    }
+
+    EXPECT_EQ(batches, (std::vector<std::vector<int>> { { 1, 2, 3 }, { 4, 5, 6 } }));
+}
+
+TEST_F(test_batching, buffer_storage_is_reused)
+{
+    std::vector<const int*> data;
+
+    int_emitter.generic_signal | buffer(2) |
+        connect([&data](std::span<const int> batch) { data.emplace_back(batch.data()); });
+
+    for (int i { 0 }; i < 10; ++i)
+    {
+        int_emitter.generic_emit(i);
+    }
+
+    // Two batches take turns: one is filled while the other one is emitted.
+    ASSERT_EQ(data.size(), 5);
+    for (std::size_t i { 2 }; i < data.size(); ++i)
+    {
+        EXPECT_EQ(data[i], data[i - 2]);
+    }
+}
+
+TEST_F(test_batching, sliding_window)
+{
+    int_emitter.generic_signal | window(3) | connect(store_batch());
+
+    for (int i { 1 }; i <= 5; ++i)
+    {
+        int_emitter.generic_emit(i);
+    }
+
+    EXPECT_EQ(batches,
+              (std::vector<std::vector<int>> { { 1, 2, 3 }, { 2, 3, 4 }, { 3, 4, 5 } }));
+}
+
+TEST_F(test_batching, window_slide)
+{
+    int_emitter.generic_signal | window(3, 2) | connect(store_batch());
+
+    for (int i { 1 }; i <= 7; ++i)
+    {
+        int_emitter.generic_emit(i);
+    }
+
+    EXPECT_EQ(batches,
+              (std::vector<std::vector<int>> { { 1, 2, 3 }, { 3, 4, 5 }, { 5, 6, 7 } }));
+}
+
+TEST_F(test_batching, window_slide_longer_than_count)
+{
+    int_emitter.generic_signal | window(2, 3) | connect(store_batch());
+
+    for (int i { 1 }; i <= 8; ++i)
+    {
+        int_emitter.generic_emit(i);
+    }
+
+    // Emissions between windows are dropped.
+    EXPECT_EQ(batches, (std::vector<std::vector<int>> { { 1, 2 }, { 4, 5 }, { 7, 8 } }));
+}
+
+TEST_F(test_batching, invalid_arguments)
+{
+    EXPECT_THROW(buffer(0), std::invalid_argument);
+    EXPECT_THROW(window(0), std::invalid_argument);
+    EXPECT_THROW(window(2, 0), std::invalid_argument);
+}
+
+TEST_F(test_batching, several_arguments)
+{
+    std::vector<std::tuple<int, std::string>> elements;
+
+    int_string_emitter.generic_signal | buffer(2) |
+        connect([&elements](std::span<const std::tuple<int, std::string>> batch)
+                { elements.assign(batch.begin(), batch.end()); });
+
+    int_string_emitter.generic_emit(1, "one");
+    int_string_emitter.generic_emit(2, "two");
+
+    EXPECT_EQ(elements,
+              (std::vector<std::tuple<int, std::string>> { { 1, "one" }, { 2, "two" } }));
+}
+
+TEST_F(test_batching, connections_share_the_batches)
+{
+    auto buffered { int_emitter.generic_signal | buffer(2) };
+    buffered.connect(store_batch());
+    buffered.connect(store_batch());
+
+    int_emitter.generic_emit(1);
+    int_emitter.generic_emit(2);
+
+    EXPECT_EQ(batches, (std::vector<std::vector<int>> { { 1, 2 }, { 1, 2 } }));
+}
+
+TEST_F(test_batching, nested_emission)
+{
+    int_emitter.generic_signal | buffer(2) |
+        connect(
+            [this](std::span<const int> batch)
+            {
+                // The batch being emitted is not modified by the nested emissions.
+                if (batch.front() == 1)
+                {
+                    int_emitter.generic_emit(3);
+                    int_emitter.generic_emit(4);
+                }
+                batches.emplace_back(batch.begin(), batch.end());
+            });
+
+    int_emitter.generic_emit(1);
+    int_emitter.generic_emit(2);
+
+    EXPECT_EQ(batches, (std::vector<std::vector<int>> { { 3, 4 }, { 1, 2 } }));
+}
+
+TEST_F(test_batching, buffer_for)
+{
+    int_emitter.generic_signal | buffer_for(10ms, wheel) | connect(store_batch());
+
+    int_emitter.generic_emit(1);
+    advance_to(5ms);
+    int_emitter.generic_emit(2);
+    advance_to(9ms);
+    EXPECT_TRUE(batches.empty());
+
+    advance_to(10ms);
+    EXPECT_EQ(batches, (std::vector<std::vector<int>> { { 1, 2 } }));
+
+    // The next period starts with the next emission.
+    advance_to(50ms);
+    int_emitter.generic_emit(3);
+    advance_to(59ms);
+    int_emitter.generic_emit(4);
+    advance_to(60ms);
+    EXPECT_EQ(batches, (std::vector<std::vector<int>> { { 1, 2 }, { 3, 4 } }));
+    EXPECT_EQ(wheel.size(), 0);
+}
+
+TEST_F(test_batching, concurrent_emissions)
+{
+    std::atomic<std::size_t> count { 0 };
+    std::atomic<long long> sum { 0 };
+
+    safe_int_emitter.generic_signal | buffer(10) |
+        connect(
+            [&count, &sum](std::span<const int> batch)
+            {
+                count += batch.size();
+                for (auto value: batch)
+                {
+                    sum += value;
+                }
+            });
+
+    std::vector<std::thread> threads;
+    for (int i { 0 }; i < 4; ++i)
+    {
+        threads.emplace_back(
+            [this]
+            {
+                for (int j { 0 }; j < 100; ++j)
+                {
+                    safe_int_emitter.generic_emit(j);
+                }
+            });
+    }
+
+    for (auto& thread: threads)
+    {
+        thread.join();
+    }
+
+    EXPECT_EQ(count, 400);
+    EXPECT_EQ(sum, 4 * 4950);
+}
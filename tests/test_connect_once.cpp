@@ -1,6 +1,12 @@
 #include "stimulus.h"
 
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <utility>
+
 #include <gtest/gtest.h>
+#include <vector>
 
 #include "utilities.h"
 
@@ -29,4 +35,80 @@ TEST_F(test_connect_once, connect_once)
 
     empty_emitter.generic_emit();
     EXPECT_EQ(count, 1);
-}
\ No newline at end of file
+}
+TEST_F(test_connect_once, suspended)
+{
+    int& count = call_count<>;
+    reset<>();
+
+    auto connection { empty_emitter.generic_signal.connect_once(slot_function<>) };
+    connection.suspend();
+
+    empty_emitter.generic_emit();
+    EXPECT_EQ(count, 0);
+
+    connection.resume();
+    empty_emitter.generic_emit();
+    empty_emitter.generic_emit();
+    EXPECT_EQ(count, 1);
+}
+
+TEST_F(test_connect_once, disconnect_after_firing)
+{
+    int& count = call_count<>;
+    reset<>();
+
+    auto connection { empty_emitter.generic_signal.connect_once(slot_function<>) };
+    empty_emitter.generic_signal.connect(slot_function<>);
+
+    empty_emitter.generic_emit();
+    EXPECT_EQ(count, 2);
+
+    connection.disconnect();
+    empty_emitter.generic_emit();
+    EXPECT_EQ(count, 3);
+}
+
+TEST_F(test_connect_once, slot_released_after_firing)
+{
+    auto token { std::make_shared<int>(0) };
+    std::weak_ptr<int> weak_token { token };
+
+    empty_emitter.generic_signal.connect_once([token = std::move(token)] { ++*token; });
+
+    // Fired connections are removed by the next change of the slot list, or the next emission.
+    empty_emitter.generic_emit();
+    empty_emitter.generic_emit();
+    EXPECT_TRUE(weak_token.expired());
+}
+
+TEST_F(test_connect_once, concurrent_emissions)
+{
+    safe_generic_emitter<> safe_emitter;
+    std::atomic<int> count { 0 };
+
+    for (int i { 0 }; i < 50; ++i)
+    {
+        safe_emitter.generic_signal.connect_once([&count] { ++count; });
+    }
+
+    std::vector<std::thread> threads;
+    for (int i { 0 }; i < 8; ++i)
+    {
+        threads.emplace_back(
+            [&safe_emitter]
+        {
+            for (int j { 0 }; j < 1000; ++j)
+            {
+                safe_emitter.generic_emit();
+            }
+        });
+    }
+
+    for (auto& thread: threads)
+    {
+        thread.join();
+    }
+
+    EXPECT_EQ(count.load(), 50);
+}
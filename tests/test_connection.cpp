@@ -1,6 +1,7 @@
 #include "stimulus.h"
 
 #include <gtest/gtest.h>
+#include <vector>
 
 #include "utilities.h"
 
@@ -144,4 +145,97 @@ TEST_F(test_connection, basic_inhibitor)
 
     empty_emitter.generic_emit();
     EXPECT_EQ(count, 1);
-}
\ No newline at end of file
+}
+TEST_F(test_connection, suspend_resume_keeps_order)
+{
+    std::vector<int> calls;
+
+    empty_emitter.generic_signal.connect([&calls] { calls.emplace_back(0); });
+    auto connection { empty_emitter.generic_signal.connect([&calls] { calls.emplace_back(1); }) };
+    empty_emitter.generic_signal.connect([&calls] { calls.emplace_back(2); });
+
+    connection.suspend();
+    empty_emitter.generic_emit();
+    EXPECT_EQ(calls, std::vector<int>({ 0, 2 }));
+
+    calls.clear();
+    connection.resume();
+    empty_emitter.generic_emit();
+    EXPECT_EQ(calls, std::vector<int>({ 0, 1, 2 }));
+}
+
+TEST_F(test_connection, mostly_suspended)
+{
+    int& count = call_count<>;
+    reset<>();
+
+    std::vector<connection<details::unsafe_shared_pointer>> connections;
+    for (int i { 0 }; i < 1000; ++i)
+    {
+        connections.emplace_back(empty_emitter.generic_signal.connect(slot_function<>));
+        if (i % 100 != 0)
+        {
+            connections.back().suspend();
+        }
+    }
+
+    empty_emitter.generic_emit();
+    EXPECT_EQ(count, 10);
+
+    for (auto& connection: connections)
+    {
+        connection.resume();
+    }
+
+    empty_emitter.generic_emit();
+    EXPECT_EQ(count, 1010);
+}
+
+TEST_F(test_connection, suspend_during_emission)
+{
+    int& count = call_count<>;
+    reset<>();
+
+    connection<details::unsafe_shared_pointer>* suspended_connection { nullptr };
+
+    empty_emitter.generic_signal.connect([&suspended_connection]
+                                         { suspended_connection->suspend(); });
+    auto connection { empty_emitter.generic_signal.connect(slot_function<>) };
+    suspended_connection = &connection;
+
+    // The emission already started, but the suspended slot is still skipped.
+    empty_emitter.generic_emit();
+    EXPECT_EQ(count, 0);
+}
+
+TEST_F(test_connection, disconnect_suspended)
+{
+    int& count = call_count<>;
+    reset<>();
+
+    auto connection { empty_emitter.generic_signal.connect(slot_function<>) };
+    connection.suspend();
+    connection.disconnect();
+    connection.resume();
+
+    empty_emitter.generic_emit();
+    EXPECT_EQ(count, 0);
+}
+
+TEST_F(test_connection, stale_connection)
+{
+    int& count = call_count<>;
+    reset<>();
+
+    auto stale { empty_emitter.generic_signal.connect(slot_function<>) };
+    stale.disconnect();
+    // Removes the disconnected connection, whose state may then be reused.
+    empty_emitter.generic_emit();
+
+    auto connection { empty_emitter.generic_signal.connect(slot_function<>) };
+    stale.suspend();
+    stale.disconnect();
+
+    empty_emitter.generic_emit();
+    EXPECT_EQ(count, 1);
+}
@@ -0,0 +1,235 @@
+#include "stimulus.h"
+
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "utilities.h"
+
+class test_connection_group: public ::testing::Test
+{
+protected:
+    generic_emitter<int> int_emitter;
+    generic_emitter<std::string> string_emitter;
+    safe_generic_emitter<int> safe_int_emitter;
+
+    basic_connection_group group;
+};
+
+TEST_F(test_connection_group, suspend_and_resume)
+{
+    int& int_count = call_count<int>;
+    int& string_count = call_count<std::string>;
+    reset<int>();
+    reset<std::string>();
+
+    group.add(int_emitter.generic_signal.connect(slot_function<int>));
+    group.add(string_emitter.generic_signal.connect(slot_function<std::string>));
+
+    group.suspend();
+    EXPECT_TRUE(group.suspended());
+    int_emitter.generic_emit(1);
+    string_emitter.generic_emit("one");
+    EXPECT_EQ(int_count, 0);
+    EXPECT_EQ(string_count, 0);
+
+    group.resume();
+    EXPECT_FALSE(group.suspended());
+    int_emitter.generic_emit(2);
+    string_emitter.generic_emit("two");
+    EXPECT_EQ(int_count, 1);
+    EXPECT_EQ(string_count, 1);
+}
+
+TEST_F(test_connection_group, other_connections_are_not_suspended)
+{
+    std::vector<std::string> calls;
+
+    group.add(int_emitter.generic_signal.connect([&calls](int) { calls.emplace_back("grouped"); }));
+    int_emitter.generic_signal.connect([&calls](int) { calls.emplace_back("alone"); });
+
+    group.suspend();
+    int_emitter.generic_emit(1);
+
+    EXPECT_EQ(calls, std::vector<std::string> { "alone" });
+}
+
+TEST_F(test_connection_group, connection_and_group_suspension)
+{
+    int& count = call_count<int>;
+    reset<int>();
+
+    auto connection { group.add(int_emitter.generic_signal.connect(slot_function<int>)) };
+
+    // Either suspension is enough.
+    connection.suspend();
+    int_emitter.generic_emit(1);
+    group.suspend();
+    connection.resume();
+    int_emitter.generic_emit(2);
+    EXPECT_EQ(count, 0);
+
+    group.resume();
+    int_emitter.generic_emit(3);
+    EXPECT_EQ(count, 1);
+}
+
+TEST_F(test_connection_group, suspended_single_shot_connection)
+{
+    int& count = call_count<int>;
+    reset<int>();
+
+    group.add(int_emitter.generic_signal.connect_once(slot_function<int>));
+
+    // The connection doesn't fire while the group is suspended.
+    group.suspend();
+    int_emitter.generic_emit(1);
+    group.resume();
+    int_emitter.generic_emit(2);
+    int_emitter.generic_emit(3);
+
+    EXPECT_EQ(count, 1);
+    EXPECT_EQ(call_args<int>.back(), 2);
+}
+
+TEST_F(test_connection_group, disconnect)
+{
+    int& int_count = call_count<int>;
+    int& string_count = call_count<std::string>;
+    reset<int>();
+    reset<std::string>();
+
+    for (int i { 0 }; i < 3; ++i)
+    {
+        group.add(int_emitter.generic_signal.connect(slot_function<int>));
+    }
+    group.add(string_emitter.generic_signal.connect(slot_function<std::string>));
+    int_emitter.generic_signal.connect(slot_function<int>);
+
+    group.disconnect();
+    EXPECT_EQ(int_emitter.generic_signal.slot_count(), 1);
+    EXPECT_EQ(string_emitter.generic_signal.slot_count(), 0);
+
+    int_emitter.generic_emit(1);
+    string_emitter.generic_emit("one");
+    EXPECT_EQ(int_count, 1);
+    EXPECT_EQ(string_count, 0);
+}
+
+TEST_F(test_connection_group, disconnect_guarded_connections)
+{
+    int& count = call_count<int>;
+    reset<int>();
+
+    {
+        basic_receiver receiver;
+        group.add(int_emitter.generic_signal.connect(slot_function<int>, receiver));
+        group.disconnect();
+    }
+
+    int_emitter.generic_emit(1);
+    EXPECT_EQ(count, 0);
+    EXPECT_EQ(int_emitter.generic_signal.slot_count(), 0);
+}
+
+TEST_F(test_connection_group, disconnected_connections)
+{
+    int& count = call_count<int>;
+    reset<int>();
+
+    auto connection { group.add(int_emitter.generic_signal.connect(slot_function<int>)) };
+    group.add(int_emitter.generic_signal.connect(slot_function<int>));
+
+    // Disconnecting twice, either way, changes nothing.
+    connection.disconnect();
+    group.disconnect();
+    connection.disconnect();
+    EXPECT_EQ(int_emitter.generic_signal.slot_count(), 0);
+
+    int_emitter.generic_emit(1);
+    EXPECT_EQ(count, 0);
+}
+
+TEST_F(test_connection_group, group_is_reusable)
+{
+    int& count = call_count<int>;
+    reset<int>();
+
+    group.add(int_emitter.generic_signal.connect(slot_function<int>));
+    group.disconnect();
+    group.add(int_emitter.generic_signal.connect(slot_function<int>));
+
+    int_emitter.generic_emit(1);
+    EXPECT_EQ(count, 1);
+}
+
+TEST_F(test_connection_group, one_group_per_connection)
+{
+    basic_connection_group other_group;
+
+    auto connection { group.add(int_emitter.generic_signal.connect([](int) {})) };
+    EXPECT_THROW(other_group.add(connection), std::invalid_argument);
+}
+
+TEST_F(test_connection_group, transformed_source)
+{
+    std::vector<int> values;
+
+    group.add(int_emitter.generic_signal | filter([](int value) { return value > 1; }) |
+              connect([&values](int value) { values.emplace_back(value); }));
+
+    int_emitter.generic_emit(2);
+    group.suspend();
+    int_emitter.generic_emit(3);
+    group.resume();
+    int_emitter.generic_emit(4);
+
+    EXPECT_EQ(values, (std::vector<int> { 2, 4 }));
+}
+
+TEST_F(test_connection_group, concurrent_suspension)
+{
+    safe_connection_group safe_group;
+    std::atomic<int> calls { 0 };
+
+    for (int i { 0 }; i < 4; ++i)
+    {
+        safe_group.add(safe_int_emitter.generic_signal.connect([&calls](int) { ++calls; }));
+    }
+
+    std::vector<std::thread> threads;
+    for (int i { 0 }; i < 4; ++i)
+    {
+        threads.emplace_back(
+            [this]
+            {
+                for (int j { 0 }; j < 100; ++j)
+                {
+                    safe_int_emitter.generic_emit(j);
+                }
+            });
+    }
+    threads.emplace_back(
+        [&safe_group]
+        {
+            for (int j { 0 }; j < 100; ++j)
+            {
+                safe_group.suspend();
+                safe_group.resume();
+            }
+        });
+
+    for (auto& thread: threads)
+    {
+        thread.join();
+    }
+
+    safe_group.disconnect();
+    safe_int_emitter.generic_emit(0);
+    EXPECT_LE(calls, 4 * 400);
+    EXPECT_EQ(safe_int_emitter.generic_signal.slot_count(), 0);
+}
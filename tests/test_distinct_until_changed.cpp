@@ -0,0 +1,138 @@
+#include "stimulus.h"
+
+#include <cmath>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "utilities.h"
+
+class test_distinct_until_changed: public ::testing::Test
+{
+protected:
+    struct quote
+    {
+        std::string symbol;
+        int price { 0 };
+    };
+
+    generic_emitter<int> int_emitter;
+    generic_emitter<int, std::string> int_string_emitter;
+    generic_emitter<quote> quote_emitter;
+    safe_generic_emitter<int> safe_int_emitter;
+};
+
+TEST_F(test_distinct_until_changed, repeated_values_are_dropped)
+{
+    std::vector<int> values;
+
+    int_emitter.generic_signal | distinct_until_changed() |
+        connect([&values](int value) { values.emplace_back(value); });
+
+    for (int value: { 1, 1, 2, 2, 2, 1, 3, 3 })
+    {
+        int_emitter.generic_emit(value);
+    }
+
+    EXPECT_EQ(values, (std::vector<int> { 1, 2, 1, 3 }));
+}
+
+TEST_F(test_distinct_until_changed, several_arguments)
+{
+    int& count = call_count<int, std::string>;
+    reset<int, std::string>();
+
+    int_string_emitter.generic_signal | distinct_until_changed() |
+        connect(slot_function<int, std::string>);
+
+    int_string_emitter.generic_emit(1, "one");
+    int_string_emitter.generic_emit(1, "one");
+    int_string_emitter.generic_emit(1, "two");
+    int_string_emitter.generic_emit(2, "two");
+
+    EXPECT_EQ(count, 3);
+}
+
+TEST_F(test_distinct_until_changed, projection)
+{
+    std::vector<int> prices;
+
+    quote_emitter.generic_signal |
+        distinct_until_changed([](const quote& changed) { return changed.price; }) |
+        connect([&prices](const quote& changed) { prices.emplace_back(changed.price); });
+
+    quote_emitter.generic_emit(quote { "A", 10 });
+    quote_emitter.generic_emit(quote { "B", 10 });
+    quote_emitter.generic_emit(quote { "B", 11 });
+
+    EXPECT_EQ(prices, (std::vector<int> { 10, 11 }));
+}
+
+TEST_F(test_distinct_until_changed, equality)
+{
+    std::vector<int> values;
+
+    auto close { [](int lhs, int rhs) { return std::abs(lhs - rhs) < 5; } };
+    int_emitter.generic_signal |
+        distinct_until_changed(details::emission_value {}, close) |
+        connect([&values](int value) { values.emplace_back(value); });
+
+    for (int value: { 10, 12, 14, 20, 21 })
+    {
+        int_emitter.generic_emit(value);
+    }
+
+    // Compared to the last emitted value.
+    EXPECT_EQ(values, (std::vector<int> { 10, 14, 20 }));
+}
+
+TEST_F(test_distinct_until_changed, comparison_runs_once)
+{
+    int projections { 0 };
+
+    auto distinct { int_emitter.generic_signal | distinct_until_changed(
+                                                     [&projections](int value)
+                                                     {
+                                                         ++projections;
+                                                         return value;
+                                                     }) };
+    for (int i { 0 }; i < 10; ++i)
+    {
+        distinct.connect([](int) {});
+    }
+
+    int_emitter.generic_emit(5);
+    int_emitter.generic_emit(5);
+    EXPECT_EQ(projections, 2);
+}
+
+TEST_F(test_distinct_until_changed, concurrent_emissions)
+{
+    int& count = call_count<int>;
+    reset<int>();
+
+    safe_int_emitter.generic_signal | distinct_until_changed() | connect(slot_function<int>);
+
+    std::vector<std::thread> threads;
+    for (int i { 0 }; i < 4; ++i)
+    {
+        threads.emplace_back(
+            [this]
+            {
+                for (int j { 0 }; j < 100; ++j)
+                {
+                    safe_int_emitter.generic_emit(7);
+                }
+            });
+    }
+
+    for (auto& thread: threads)
+    {
+        thread.join();
+    }
+
+    EXPECT_EQ(count, 1);
+}
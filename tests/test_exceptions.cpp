@@ -208,4 +208,25 @@ TEST_F(exceptions_test, runtime_error_thrower_with_policy)
     EXPECT_EQ(int_caught, 0);
     EXPECT_EQ(runtime_error_caught, 1);
     EXPECT_EQ(something_else_caught, 0);
-}
\ No newline at end of file
+}
+
+TEST_F(exceptions_test, guarded_int_thrower)
+{
+    reset_counters();
+
+    basic_receiver receiver;
+    auto connection { empty_emitter.generic_signal.connect(int_throwing_function, receiver) };
+
+    EXPECT_THROW(empty_emitter.generic_emit(), int);
+    EXPECT_EQ(int_caught, 0);
+
+    connection.add_exception_handler(catching_handler);
+
+    empty_emitter.generic_emit();
+    EXPECT_EQ(int_caught, 1);
+
+    connection.disconnect();
+
+    empty_emitter.generic_emit();
+    EXPECT_EQ(int_caught, 1);
+}
@@ -1,10 +1,13 @@
 #include "stimulus.h"
 
+#include <concepts>
 #include <functional>
 #include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 #include <gtest/gtest.h>
-#include <vector>
 
 #include "utilities.h"
 
@@ -167,9 +170,9 @@ TEST_F(custom_policy_connect_emit, copy_move_emit)
     EXPECT_EQ(call_args<copy_move_counter>.size(), 1);
 
     EXPECT_EQ(call_args<copy_move_counter>.back().copy_counter, 0);
-    // 1 from generic_emit, 1 to pass it std::function, and 1 in the function itself, 1 from moving
-    // std::function in policy, and 1 from moving to the policy
-    EXPECT_EQ(call_args<copy_move_counter>.back().move_counter, 5);
+    // 1 to capture it, 1 from moving the capture into std::function, 1 to pass it to the function,
+    // and 1 to store it.
+    EXPECT_EQ(call_args<copy_move_counter>.back().move_counter, 4);
 }
 
 TEST_F(custom_policy_connect_emit, 2_copy_move_emit)
@@ -192,13 +195,14 @@ TEST_F(custom_policy_connect_emit, 2_copy_move_emit)
     EXPECT_EQ(call_args<copy_move_counter>.size(), 2);
     // 1 from the execution policy
     EXPECT_EQ(call_args<copy_move_counter>.back().copy_counter, 0);
-    // 1 from generic_emit, 1 to pass it std::function, and 1 in the function itself, 1 from moving
-    // std::function in policy, and 1 from moving to the policy
-    EXPECT_EQ(call_args<copy_move_counter>.back().move_counter, 5);
-    // 1 to pass it to std::function
+    // 1 to capture it, 1 from moving the capture into std::function, 1 to pass it to the function,
+    // and 1 to store it.
+    EXPECT_EQ(call_args<copy_move_counter>.back().move_counter, 4);
+    // 1 to capture it, as other slots share the emitted argument.
     EXPECT_EQ(call_args<copy_move_counter>.front().copy_counter, 1);
-    // 1 from generic_emit, 1 to pass it std::function, and 1 in the function itself.
-    EXPECT_EQ(call_args<copy_move_counter>.front().move_counter, 4);
+    // 1 from moving the capture into std::function, 1 to pass it to the function, and 1 to store
+    // it.
+    EXPECT_EQ(call_args<copy_move_counter>.front().move_counter, 3);
 }
 
 TEST_F(custom_policy_connect_emit, lambda)
@@ -307,4 +311,59 @@ TEST_F(custom_policy_connect_emit, conversion)
     EXPECT_EQ(count, 1);
     EXPECT_EQ(call_args<double>.size(), 1);
     EXPECT_EQ(call_args<double>.back(), 3.);
-}
\ No newline at end of file
+}
+
+namespace
+{
+    template<bool Synchronous>
+    struct inspecting_policy
+    {
+        template<std::invocable Invocable>
+        void execute(Invocable&& invocable)
+        {
+            received_std_function =
+                std::same_as<std::remove_cvref_t<Invocable>, std::function<void()>>;
+            ++execution_count;
+            std::forward<Invocable>(invocable)();
+        }
+
+        static constexpr bool is_synchronous { Synchronous };
+
+        bool received_std_function { true };
+        int execution_count { 0 };
+    };
+} // namespace
+
+TEST_F(custom_policy_connect_emit, asynchronous_policy_receives_closure)
+{
+    int& count = call_count<int>;
+    reset<int>();
+
+    inspecting_policy<false> inspecting;
+    int_emitter.generic_signal.connect(slot_function<int>, inspecting);
+
+    int_emitter.generic_emit(5);
+    EXPECT_FALSE(inspecting.received_std_function);
+    EXPECT_EQ(inspecting.execution_count, 1);
+    EXPECT_EQ(count, 1);
+    EXPECT_EQ(call_args<int>.back(), 5);
+}
+
+TEST_F(custom_policy_connect_emit, custom_synchronous_policy)
+{
+    inspecting_policy<true> inspecting;
+    std::vector<int> copy_counts;
+
+    copy_move_emitter.generic_signal.connect([&copy_counts](const copy_move_counter& counter)
+                                             { copy_counts.emplace_back(counter.copy_counter); },
+                                             inspecting);
+    copy_move_emitter.generic_signal.connect([&copy_counts](const copy_move_counter& counter)
+                                             { copy_counts.emplace_back(counter.copy_counter); },
+                                             inspecting);
+
+    copy_move_emitter.generic_emit({});
+    EXPECT_FALSE(inspecting.received_std_function);
+    EXPECT_EQ(inspecting.execution_count, 2);
+    // Synchronous policies run in place, so arguments are never captured.
+    EXPECT_EQ(copy_counts, std::vector<int>({ 0, 0 }));
+}
@@ -0,0 +1,283 @@
+#include "stimulus.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <list>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "utilities.h"
+
+class test_fan_in: public ::testing::Test
+{
+protected:
+    generic_emitter<int> int_emitter;
+    generic_emitter<int> other_int_emitter;
+    generic_emitter<std::string> string_emitter;
+    generic_emitter<int, std::string> int_string_emitter;
+    safe_generic_emitter<int> safe_int_emitter;
+    safe_generic_emitter<int> other_safe_int_emitter;
+};
+
+TEST_F(test_fan_in, merge)
+{
+    std::vector<int> values;
+
+    merge(int_emitter.generic_signal, other_int_emitter.generic_signal) |
+        connect([&values](int value) { values.emplace_back(value); });
+
+    int_emitter.generic_emit(1);
+    other_int_emitter.generic_emit(2);
+    int_emitter.generic_emit(3);
+
+    EXPECT_EQ(values, (std::vector<int> { 1, 2, 3 }));
+}
+
+TEST_F(test_fan_in, merge_transformed_sources)
+{
+    std::vector<int> values;
+
+    merge(int_emitter.generic_signal,
+          other_int_emitter.generic_signal | transform([](int value) { return value * 10; }),
+          string_emitter.generic_signal |
+              transform([](const std::string& value) { return static_cast<int>(value.size()); })) |
+        connect([&values](int value) { values.emplace_back(value); });
+
+    int_emitter.generic_emit(1);
+    other_int_emitter.generic_emit(2);
+    string_emitter.generic_emit("three");
+
+    EXPECT_EQ(values, (std::vector<int> { 1, 20, 5 }));
+}
+
+TEST_F(test_fan_in, combine_latest)
+{
+    std::vector<std::tuple<int, std::string>> values;
+
+    combine_latest(int_emitter.generic_signal, string_emitter.generic_signal) |
+        connect([&values](int number, const std::string& text)
+                { values.emplace_back(number, text); });
+
+    // Nothing is emitted until every source did.
+    int_emitter.generic_emit(1);
+    int_emitter.generic_emit(2);
+    EXPECT_TRUE(values.empty());
+
+    string_emitter.generic_emit("a");
+    int_emitter.generic_emit(3);
+    string_emitter.generic_emit("b");
+
+    EXPECT_EQ(values,
+              (std::vector<std::tuple<int, std::string>> { { 2, "a" }, { 3, "a" }, { 3, "b" } }));
+}
+
+TEST_F(test_fan_in, combine_latest_several_arguments)
+{
+    int& count = call_count<int, std::string, int>;
+    reset<int, std::string, int>();
+
+    combine_latest(int_string_emitter.generic_signal, int_emitter.generic_signal) |
+        connect(slot_function<int, std::string, int>);
+
+    int_string_emitter.generic_emit(1, "one");
+    int_emitter.generic_emit(2);
+
+    EXPECT_EQ(count, 1);
+    EXPECT_EQ(call_args<int>, (std::list<int> { 1, 2 }));
+    EXPECT_EQ(call_args<std::string>.back(), "one");
+}
+
+TEST_F(test_fan_in, zip)
+{
+    std::vector<std::tuple<int, std::string>> values;
+
+    zip(int_emitter.generic_signal, string_emitter.generic_signal) |
+        connect([&values](int number, const std::string& text)
+                { values.emplace_back(number, text); });
+
+    int_emitter.generic_emit(1);
+    int_emitter.generic_emit(2);
+    string_emitter.generic_emit("a");
+    string_emitter.generic_emit("b");
+    string_emitter.generic_emit("c");
+    EXPECT_EQ(values, (std::vector<std::tuple<int, std::string>> { { 1, "a" }, { 2, "b" } }));
+
+    int_emitter.generic_emit(3);
+    EXPECT_EQ(values.back(), (std::tuple<int, std::string> { 3, "c" }));
+}
+
+TEST_F(test_fan_in, zip_capacity)
+{
+    std::vector<std::tuple<int, int>> values;
+
+    zip<2>(int_emitter.generic_signal, other_int_emitter.generic_signal) |
+        connect([&values](int lhs, int rhs) { values.emplace_back(lhs, rhs); });
+
+    // The oldest waiting emission is dropped.
+    int_emitter.generic_emit(1);
+    int_emitter.generic_emit(2);
+    int_emitter.generic_emit(3);
+    other_int_emitter.generic_emit(10);
+    other_int_emitter.generic_emit(20);
+    other_int_emitter.generic_emit(30);
+
+    EXPECT_EQ(values, (std::vector<std::tuple<int, int>> { { 2, 10 }, { 3, 20 } }));
+}
+
+TEST_F(test_fan_in, connection_lifetime)
+{
+    int& count = call_count<int>;
+    reset<int>();
+
+    auto connection { merge(int_emitter.generic_signal, other_int_emitter.generic_signal) |
+                      connect(slot_function<int>) };
+    EXPECT_EQ(int_emitter.generic_signal.slot_count(), 1);
+    EXPECT_EQ(other_int_emitter.generic_signal.slot_count(), 1);
+
+    // The temporary merged source is gone, but its connection still works.
+    int_emitter.generic_emit(1);
+    EXPECT_EQ(count, 1);
+
+    connection.disconnect();
+    EXPECT_EQ(int_emitter.generic_signal.slot_count(), 0);
+    EXPECT_EQ(other_int_emitter.generic_signal.slot_count(), 0);
+}
+
+TEST_F(test_fan_in, connections_share_the_state)
+{
+    std::vector<std::tuple<int, int>> values;
+
+    auto zipped { zip(int_emitter.generic_signal, other_int_emitter.generic_signal) };
+    zipped.connect([&values](int lhs, int rhs) { values.emplace_back(lhs, rhs); });
+    zipped.connect([&values](int lhs, int rhs) { values.emplace_back(rhs, lhs); });
+
+    int_emitter.generic_emit(1);
+    other_int_emitter.generic_emit(2);
+
+    EXPECT_EQ(values, (std::vector<std::tuple<int, int>> { { 1, 2 }, { 2, 1 } }));
+}
+
+TEST_F(test_fan_in, chained_transformation)
+{
+    std::vector<int> values;
+
+    combine_latest(int_emitter.generic_signal, other_int_emitter.generic_signal) |
+        transform([](int lhs, int rhs) { return lhs + rhs; }) |
+        filter([](int sum) { return sum % 2 == 0; }) |
+        connect([&values](int sum) { values.emplace_back(sum); });
+
+    int_emitter.generic_emit(1);
+    other_int_emitter.generic_emit(1);
+    other_int_emitter.generic_emit(2);
+    int_emitter.generic_emit(4);
+
+    EXPECT_EQ(values, (std::vector<int> { 2, 6 }));
+}
+
+TEST_F(test_fan_in, concurrent_emissions)
+{
+    std::atomic<int> count { 0 };
+    std::atomic<int> sum { 0 };
+
+    merge(safe_int_emitter.generic_signal, other_safe_int_emitter.generic_signal) |
+        connect(
+            [&count, &sum](int value)
+            {
+                ++count;
+                sum += value;
+            });
+
+    std::vector<std::thread> threads;
+    for (int i { 0 }; i < 4; ++i)
+    {
+        threads.emplace_back(
+            [this, i]
+            {
+                auto& source { i % 2 == 0 ? safe_int_emitter : other_safe_int_emitter };
+                for (int j { 0 }; j < 100; ++j)
+                {
+                    source.generic_emit(j);
+                }
+            });
+    }
+
+    for (auto& thread: threads)
+    {
+        thread.join();
+    }
+
+    EXPECT_EQ(count, 400);
+    EXPECT_EQ(sum, 4 * 4950);
+}
+
+TEST_F(test_fan_in, combine_latest_concurrent_emissions)
+{
+    std::mutex combined_mutex;
+    std::vector<std::tuple<int, int>> combined;
+
+    combine_latest(safe_int_emitter.generic_signal, other_safe_int_emitter.generic_signal) |
+        connect(
+            [&](int first, int second)
+            {
+                std::lock_guard lock { combined_mutex };
+                combined.emplace_back(first, second);
+            });
+
+    std::vector<std::thread> threads;
+    for (int i { 0 }; i < 2; ++i)
+    {
+        threads.emplace_back(
+            [this, i]
+            {
+                auto& source { i == 0 ? safe_int_emitter : other_safe_int_emitter };
+                for (int j { 1 }; j <= 100; ++j)
+                {
+                    source.generic_emit(j);
+                }
+            });
+    }
+
+    for (auto& thread: threads)
+    {
+        thread.join();
+    }
+
+    // The slots are called without the lock, so only the values themselves are checked: the
+    // last of the two final emissions sees both of them.
+    ASSERT_FALSE(combined.empty());
+    for (const auto& [first, second]: combined)
+    {
+        EXPECT_GE(first, 1);
+        EXPECT_LE(first, 100);
+        EXPECT_GE(second, 1);
+        EXPECT_LE(second, 100);
+    }
+    EXPECT_NE(std::ranges::find(combined, std::make_tuple(100, 100)), combined.end());
+}
+
+TEST_F(test_fan_in, combine_latest_emission_from_a_slot)
+{
+    std::vector<std::tuple<int, int>> combined;
+
+    combine_latest(safe_int_emitter.generic_signal, other_safe_int_emitter.generic_signal) |
+        connect(
+            [&](int first, int second)
+            {
+                combined.emplace_back(first, second);
+                if (first == 1)
+                {
+                    safe_int_emitter.generic_emit(2);
+                }
+            });
+
+    safe_int_emitter.generic_emit(1);
+    other_safe_int_emitter.generic_emit(3);
+
+    EXPECT_EQ(combined, (std::vector<std::tuple<int, int>> { { 1, 3 }, { 2, 3 } }));
+}
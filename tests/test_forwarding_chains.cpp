@@ -0,0 +1,227 @@
+#include "stimulus.h"
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include <gtest/gtest.h>
+#include <vector>
+
+#include "utilities.h"
+
+class test_forwarding_chains: public ::testing::Test
+{
+protected:
+    struct forwarding_emitter: public basic_emitter
+    {
+        signal<int> m_signal;
+
+        void forward_from(const forwarding_emitter& origin)
+        {
+            connect(origin.m_signal, &forwarding_emitter::m_signal);
+        }
+
+        void emit_value(int value)
+        {
+            emit(&forwarding_emitter::m_signal, value);
+        }
+    };
+
+    // Deep enough to overflow the stack if each hop was a nested emission.
+    static constexpr std::size_t chain_length { 100'000 };
+
+    static auto make_chain(std::size_t length)
+    {
+        std::vector<std::unique_ptr<forwarding_emitter>> chain;
+        chain.reserve(length);
+        chain.emplace_back(std::make_unique<forwarding_emitter>());
+        for (std::size_t i { 1 }; i < length; ++i)
+        {
+            chain.emplace_back(std::make_unique<forwarding_emitter>());
+            chain.back()->forward_from(*chain[i - 1]);
+        }
+        return chain;
+    }
+};
+
+TEST_F(test_forwarding_chains, long_chain)
+{
+    int& count = call_count<int>;
+    reset<int>();
+
+    auto chain { make_chain(chain_length) };
+    chain.back()->m_signal.connect(slot_function<int>);
+
+    chain.front()->emit_value(5);
+    chain.front()->emit_value(6);
+
+    EXPECT_EQ(count, 2);
+    EXPECT_EQ(call_args<int>.front(), 5);
+    EXPECT_EQ(call_args<int>.back(), 6);
+}
+
+TEST_F(test_forwarding_chains, cyclic_forwarding)
+{
+    forwarding_emitter first;
+    forwarding_emitter second;
+    first.forward_from(second);
+    second.forward_from(first);
+
+    std::size_t count { 0 };
+    second.m_signal.connect(
+        [&count, &first](int)
+        {
+            if (++count == chain_length)
+            {
+                first.block_signals();
+            }
+        });
+
+    first.emit_value(5);
+
+    EXPECT_EQ(count, chain_length);
+}
+
+TEST_F(test_forwarding_chains, nested_forwarding_runs_after_emission)
+{
+    std::vector<std::string> calls;
+
+    auto chain { make_chain(3) };
+    chain[1]->m_signal.connect([&calls](int) { calls.emplace_back("second"); });
+    chain[2]->m_signal.connect([&calls](int) { calls.emplace_back("third"); });
+
+    chain[0]->emit_value(5);
+
+    ASSERT_EQ(calls.size(), 2);
+    EXPECT_EQ(calls[0], "second");
+    EXPECT_EQ(calls[1], "third");
+}
+
+TEST_F(test_forwarding_chains, queued_emission_runs_after_remaining_slots)
+{
+    std::vector<std::string> calls;
+
+    // The second emitter forwards to the third before calling its own slot.
+    auto chain { make_chain(3) };
+    chain[1]->m_signal.connect([&calls](int) { calls.emplace_back("second"); });
+    chain[2]->m_signal.connect([&calls](int) { calls.emplace_back("third"); });
+    chain[0]->m_signal.connect([&calls](int) { calls.emplace_back("first"); });
+
+    chain[0]->emit_value(5);
+
+    // The outermost forwarding runs right away, and drains what it forwarded before returning.
+    ASSERT_EQ(calls.size(), 3);
+    EXPECT_EQ(calls[0], "second");
+    EXPECT_EQ(calls[1], "third");
+    EXPECT_EQ(calls[2], "first");
+}
+
+TEST_F(test_forwarding_chains, queued_emission_copies_temporaries)
+{
+    struct string_forwarding_emitter: public basic_emitter
+    {
+        signal<const std::string&> m_signal;
+
+        // The transformed string is a temporary, gone once the forwarding slot returns.
+        void forward_from(const forwarding_emitter& origin)
+        {
+            connect(origin.m_signal.apply(transform { [](int value)
+            { return std::string(64, 'x') + std::to_string(value); } }),
+                    &string_forwarding_emitter::m_signal);
+        }
+    };
+
+    auto chain { make_chain(2) };
+    string_forwarding_emitter last;
+    last.forward_from(*chain[1]);
+
+    std::vector<std::string> received;
+    last.m_signal.connect([&received](const std::string& value) { received.push_back(value); });
+
+    chain[0]->emit_value(5);
+
+    ASSERT_EQ(received.size(), 1);
+    EXPECT_EQ(received.front(), std::string(64, 'x') + "5");
+}
+
+TEST_F(test_forwarding_chains, mutable_references_are_not_queued)
+{
+    struct reference_forwarding_emitter: public basic_emitter
+    {
+        signal<int&> m_signal;
+
+        void forward_from(const reference_forwarding_emitter& origin)
+        {
+            connect(origin.m_signal, &reference_forwarding_emitter::m_signal);
+        }
+
+        void emit_value(int& value)
+        {
+            emit(&reference_forwarding_emitter::m_signal, value);
+        }
+    };
+
+    reference_forwarding_emitter first;
+    reference_forwarding_emitter second;
+    reference_forwarding_emitter third;
+    second.forward_from(first);
+    third.forward_from(second);
+    third.m_signal.connect([](int& value) { ++value; });
+
+    int value { 5 };
+    first.emit_value(value);
+
+    EXPECT_EQ(value, 6);
+}
+
+TEST_F(test_forwarding_chains, destroyed_while_queued)
+{
+    int& count = call_count<int>;
+    reset<int>();
+
+    auto chain { make_chain(3) };
+    chain[2]->m_signal.connect(slot_function<int>);
+    chain[1]->m_signal.connect([&chain](int) { chain[2].reset(); });
+
+    chain[0]->emit_value(5);
+
+    EXPECT_EQ(count, 0);
+}
+
+TEST_F(test_forwarding_chains, exception_in_queued_emission)
+{
+    int& count = call_count<int>;
+    reset<int>();
+
+    auto chain { make_chain(4) };
+    auto thrower { chain[2]->m_signal.connect([](int value) { throw value; }) };
+    chain[3]->m_signal.connect(slot_function<int>);
+
+    EXPECT_THROW(chain[0]->emit_value(5), int);
+    EXPECT_EQ(count, 0);
+
+    // Emissions left behind were dropped, and forwarding still works.
+    thrower.disconnect();
+    chain[0]->emit_value(6);
+    EXPECT_EQ(count, 1);
+    EXPECT_EQ(call_args<int>.back(), 6);
+}
+
+TEST_F(test_forwarding_chains, blocked_intermediate_emitter)
+{
+    int& count = call_count<int>;
+    reset<int>();
+
+    auto chain { make_chain(4) };
+    chain[3]->m_signal.connect(slot_function<int>);
+
+    chain[2]->block_signals();
+    chain[0]->emit_value(5);
+    EXPECT_EQ(count, 0);
+    EXPECT_EQ(chain[2]->suppressed_emissions(), 1);
+
+    chain[2]->unblock_signals();
+    chain[0]->emit_value(6);
+    EXPECT_EQ(count, 1);
+}
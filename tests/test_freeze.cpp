@@ -0,0 +1,262 @@
+#include "stimulus.h"
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "utilities.h"
+
+class test_freeze: public ::testing::Test
+{
+protected:
+    struct sensor: public basic_emitter
+    {
+        signal<int> temperature;
+        signal<std::string> status;
+        property<int> threshold;
+
+        void set_temperature(int value)
+        {
+            emit(&sensor::temperature, value);
+        }
+
+        void set_status(std::string value)
+        {
+            emit(&sensor::status, std::move(value));
+        }
+
+        auto set_threshold(int value) -> bool
+        {
+            return set(&sensor::threshold, value);
+        }
+    };
+
+    generic_emitter<int> int_emitter;
+    safe_generic_emitter<int> safe_int_emitter;
+    sensor sensor_emitter;
+};
+
+TEST_F(test_freeze, frozen_emission)
+{
+    int& count = call_count<int>;
+    reset<int>();
+
+    int_emitter.generic_signal.connect(slot_function<int>);
+    int_emitter.generic_signal.connect(slot_function<int>);
+    int_emitter.generic_signal.freeze();
+    EXPECT_TRUE(int_emitter.generic_signal.frozen());
+
+    int_emitter.generic_emit(1);
+    int_emitter.generic_emit(2);
+    EXPECT_EQ(count, 4);
+    EXPECT_TRUE(int_emitter.generic_signal.frozen());
+}
+
+TEST_F(test_freeze, nothing_to_freeze)
+{
+    int_emitter.generic_signal.freeze();
+    EXPECT_FALSE(int_emitter.generic_signal.frozen());
+}
+
+TEST_F(test_freeze, connection_unfreezes)
+{
+    int& count = call_count<int>;
+    reset<int>();
+
+    int_emitter.generic_signal.connect(slot_function<int>);
+    int_emitter.generic_signal.freeze();
+
+    int_emitter.generic_signal.connect(slot_function<int>);
+    EXPECT_FALSE(int_emitter.generic_signal.frozen());
+
+    int_emitter.generic_emit(1);
+    EXPECT_EQ(count, 2);
+}
+
+TEST_F(test_freeze, disconnection_unfreezes)
+{
+    int& count = call_count<int>;
+    reset<int>();
+
+    auto connection { int_emitter.generic_signal.connect(slot_function<int>) };
+    int_emitter.generic_signal.connect(slot_function<int>);
+    int_emitter.generic_signal.freeze();
+
+    connection.disconnect();
+    EXPECT_FALSE(int_emitter.generic_signal.frozen());
+
+    int_emitter.generic_emit(1);
+    EXPECT_EQ(count, 1);
+}
+
+TEST_F(test_freeze, suspension_unfreezes)
+{
+    int& count = call_count<int>;
+    reset<int>();
+
+    auto connection { int_emitter.generic_signal.connect(slot_function<int>) };
+    connection.suspend();
+    int_emitter.generic_signal.freeze();
+
+    connection.resume();
+    EXPECT_FALSE(int_emitter.generic_signal.frozen());
+    int_emitter.generic_emit(1);
+    EXPECT_EQ(count, 1);
+
+    int_emitter.generic_signal.freeze();
+    connection.suspend();
+    EXPECT_FALSE(int_emitter.generic_signal.frozen());
+    int_emitter.generic_emit(2);
+    EXPECT_EQ(count, 1);
+}
+
+TEST_F(test_freeze, unfrozen_lists_are_released)
+{
+    auto token { std::make_shared<int>(0) };
+    for (int i { 0 }; i < 100; ++i)
+    {
+        auto connection { int_emitter.generic_signal.connect([token](int) {}) };
+        int_emitter.generic_signal.freeze();
+        int_emitter.generic_emit(i);
+        connection.disconnect();
+    }
+    int_emitter.generic_signal.freeze();
+
+    // Only the last frozen list is kept, without any of the disconnected connections.
+    EXPECT_EQ(token.use_count(), 1);
+    EXPECT_TRUE(int_emitter.generic_signal.frozen());
+}
+
+TEST_F(test_freeze, list_unfrozen_while_emitting)
+{
+    auto token { std::make_shared<int>(0) };
+    auto connection { safe_int_emitter.generic_signal.connect([token](int) {}) };
+    safe_int_emitter.generic_signal.connect([&connection](int) { connection.disconnect(); });
+    safe_int_emitter.generic_signal.freeze();
+
+    // The emission keeps reading the list it unfroze, which is released once it returns.
+    safe_int_emitter.generic_emit(1);
+    EXPECT_FALSE(safe_int_emitter.generic_signal.frozen());
+
+    safe_int_emitter.generic_signal.freeze();
+    EXPECT_EQ(token.use_count(), 1);
+}
+
+TEST_F(test_freeze, single_shot_connection)
+{
+    int& count = call_count<int>;
+    reset<int>();
+
+    int_emitter.generic_signal.connect_once(slot_function<int>);
+    int_emitter.generic_signal.freeze();
+
+    int_emitter.generic_emit(1);
+    int_emitter.generic_emit(2);
+    EXPECT_EQ(count, 1);
+    EXPECT_EQ(int_emitter.generic_signal.slot_count(), 0);
+}
+
+TEST_F(test_freeze, freeze_all)
+{
+    int& int_count = call_count<int>;
+    int& string_count = call_count<std::string>;
+    reset<int>();
+    reset<std::string>();
+
+    sensor_emitter.temperature.connect(slot_function<int>);
+    sensor_emitter.status.connect(slot_function<std::string>);
+
+    // Each signal is frozen by its next emission.
+    sensor_emitter.freeze_all();
+    EXPECT_FALSE(sensor_emitter.temperature.frozen());
+    sensor_emitter.set_temperature(20);
+    sensor_emitter.set_status("ok");
+    EXPECT_TRUE(sensor_emitter.temperature.frozen());
+    EXPECT_TRUE(sensor_emitter.status.frozen());
+
+    // Once unfrozen, a signal stays so until the next freeze_all.
+    sensor_emitter.temperature.connect(slot_function<int>);
+    sensor_emitter.set_temperature(21);
+    EXPECT_FALSE(sensor_emitter.temperature.frozen());
+
+    sensor_emitter.freeze_all();
+    sensor_emitter.set_temperature(22);
+    EXPECT_TRUE(sensor_emitter.temperature.frozen());
+
+    EXPECT_EQ(int_count, 5);
+    EXPECT_EQ(string_count, 1);
+}
+
+TEST_F(test_freeze, property)
+{
+    std::vector<int> values;
+
+    sensor_emitter.threshold.connect([&values](int value) { values.emplace_back(value); });
+    sensor_emitter.freeze_all();
+
+    sensor_emitter.set_threshold(3);
+    EXPECT_TRUE(sensor_emitter.threshold.frozen());
+    sensor_emitter.set_threshold(4);
+
+    EXPECT_EQ(values, (std::vector<int> { 0, 3, 4 }));
+}
+
+TEST_F(test_freeze, blocked_signal)
+{
+    int& count = call_count<int>;
+    reset<int>();
+
+    int_emitter.generic_signal.connect(slot_function<int>);
+    int_emitter.generic_signal.freeze();
+
+    int_emitter.generic_signal.block();
+    int_emitter.generic_emit(1);
+    int_emitter.generic_signal.unblock();
+    int_emitter.generic_emit(2);
+
+    EXPECT_EQ(count, 1);
+    EXPECT_EQ(call_args<int>.back(), 2);
+}
+
+TEST_F(test_freeze, concurrent_changes)
+{
+    std::atomic<int> calls { 0 };
+
+    safe_int_emitter.generic_signal.connect([&calls](int) { ++calls; });
+    safe_int_emitter.generic_signal.freeze();
+
+    std::vector<std::thread> threads;
+    for (int i { 0 }; i < 4; ++i)
+    {
+        threads.emplace_back(
+            [this]
+            {
+                for (int j { 0 }; j < 100; ++j)
+                {
+                    safe_int_emitter.generic_emit(j);
+                }
+            });
+    }
+    threads.emplace_back(
+        [this]
+        {
+            for (int j { 0 }; j < 100; ++j)
+            {
+                safe_int_emitter.generic_signal.connect([](int) {}).disconnect();
+                safe_int_emitter.generic_signal.freeze();
+            }
+        });
+
+    for (auto& thread: threads)
+    {
+        thread.join();
+    }
+
+    EXPECT_EQ(calls, 400);
+    EXPECT_EQ(safe_int_emitter.generic_signal.slot_count(), 1);
+}
@@ -0,0 +1,279 @@
+#include "stimulus.h"
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "utilities.h"
+
+namespace
+{
+    // Counts its instances, to see whether the index still holds a key.
+    struct counted_key
+    {
+        explicit counted_key(int key_value):
+            value { key_value }
+        {
+            ++instances;
+        }
+
+        counted_key(const counted_key& other):
+            value { other.value }
+        {
+            ++instances;
+        }
+
+        ~counted_key()
+        {
+            --instances;
+        }
+
+        auto operator=(const counted_key&) -> counted_key& = default;
+
+        auto operator==(const counted_key& other) const -> bool
+        {
+            return value == other.value;
+        }
+
+        int value;
+        static inline int instances { 0 };
+    };
+} // namespace
+
+template<>
+struct std::hash<counted_key>
+{
+    auto operator()(const counted_key& key) const noexcept -> std::size_t
+    {
+        return std::hash<int> {}(key.value);
+    }
+};
+
+class test_keyed_connections: public ::testing::Test
+{
+protected:
+    generic_emitter<int, std::string> quote_emitter;
+    safe_generic_emitter<int, std::string> safe_quote_emitter;
+
+    struct quote_receiver: public safe_receiver
+    {
+        void on_quote(int, const std::string& quote)
+        {
+            quotes.emplace_back(quote);
+        }
+
+        std::vector<std::string> quotes;
+    };
+
+    task_queue_policy policy;
+};
+
+TEST_F(test_keyed_connections, only_the_key_is_called)
+{
+    std::vector<int> calls(1000, 0);
+
+    for (int key { 0 }; key < 1000; ++key)
+    {
+        quote_emitter.generic_signal.connect_key<0>(key,
+                                                    [&calls, key](int) { ++calls[key]; });
+    }
+
+    quote_emitter.generic_emit(5, "five");
+    quote_emitter.generic_emit(7, "seven");
+    quote_emitter.generic_emit(5, "five again");
+    quote_emitter.generic_emit(2000, "nobody");
+
+    for (int key { 0 }; key < 1000; ++key)
+    {
+        EXPECT_EQ(calls[key], key == 5 ? 2 : key == 7 ? 1 : 0);
+    }
+}
+
+TEST_F(test_keyed_connections, several_connections_per_key)
+{
+    int& count = call_count<int, std::string>;
+    reset<int, std::string>();
+
+    quote_emitter.generic_signal.connect_key<0>(5, slot_function<int, std::string>);
+    quote_emitter.generic_signal.connect_key<0>(5, slot_function<int, std::string>);
+
+    quote_emitter.generic_emit(5, "five");
+
+    EXPECT_EQ(count, 2);
+    EXPECT_EQ(call_args<std::string>.back(), "five");
+}
+
+TEST_F(test_keyed_connections, key_on_another_argument)
+{
+    int& count = call_count<int>;
+    reset<int>();
+
+    quote_emitter.generic_signal.connect_key<1>("five", slot_function<int>);
+
+    quote_emitter.generic_emit(5, "five");
+    quote_emitter.generic_emit(6, "six");
+
+    EXPECT_EQ(count, 1);
+    EXPECT_EQ(call_args<int>.back(), 5);
+}
+
+TEST_F(test_keyed_connections, keyed_connections_are_called_last)
+{
+    std::vector<std::string> calls;
+
+    quote_emitter.generic_signal.connect_key<0>(5,
+                                                [&calls](int) { calls.emplace_back("keyed"); });
+    quote_emitter.generic_signal.connect([&calls](int) { calls.emplace_back("regular"); });
+
+    quote_emitter.generic_emit(5, "five");
+
+    ASSERT_EQ(calls.size(), 2);
+    EXPECT_EQ(calls[0], "regular");
+    EXPECT_EQ(calls[1], "keyed");
+}
+
+TEST_F(test_keyed_connections, disconnect)
+{
+    int& count = call_count<int>;
+    reset<int>();
+
+    auto connection { quote_emitter.generic_signal.connect_key<0>(5, slot_function<int>) };
+    EXPECT_EQ(quote_emitter.generic_signal.slot_count(), 1);
+
+    connection.disconnect();
+    quote_emitter.generic_emit(5, "five");
+
+    EXPECT_EQ(count, 0);
+    EXPECT_EQ(quote_emitter.generic_signal.slot_count(), 0);
+}
+
+TEST_F(test_keyed_connections, suspend_resume)
+{
+    int& count = call_count<int>;
+    reset<int>();
+
+    auto connection { quote_emitter.generic_signal.connect_key<0>(5, slot_function<int>) };
+
+    connection.suspend();
+    EXPECT_FALSE(quote_emitter.generic_signal.has_active_slots());
+    quote_emitter.generic_emit(5, "five");
+    EXPECT_EQ(count, 0);
+
+    connection.resume();
+    EXPECT_TRUE(quote_emitter.generic_signal.has_active_slots());
+    quote_emitter.generic_emit(5, "five");
+    EXPECT_EQ(count, 1);
+}
+
+TEST_F(test_keyed_connections, guarded_member_function)
+{
+    auto receiver { std::make_unique<quote_receiver>() };
+
+    safe_quote_emitter.generic_signal.connect_key<0>(5, &quote_receiver::on_quote, *receiver);
+    safe_quote_emitter.generic_emit(5, "five");
+    safe_quote_emitter.generic_emit(6, "six");
+
+    ASSERT_EQ(receiver->quotes.size(), 1);
+    EXPECT_EQ(receiver->quotes.back(), "five");
+
+    // The connection dies with its guard.
+    receiver.reset();
+    EXPECT_EQ(safe_quote_emitter.generic_signal.slot_count(), 0);
+    safe_quote_emitter.generic_emit(5, "five");
+}
+
+TEST_F(test_keyed_connections, execution_policy)
+{
+    int& count = call_count<int>;
+    reset<int>();
+
+    quote_emitter.generic_signal.connect_key<0>(5, slot_function<int>, policy);
+
+    quote_emitter.generic_emit(5, "five");
+    quote_emitter.generic_emit(6, "six");
+    EXPECT_EQ(policy.size(), 1);
+    EXPECT_EQ(count, 0);
+
+    policy.run_all();
+    EXPECT_EQ(count, 1);
+}
+
+TEST_F(test_keyed_connections, emitter_destroyed_first)
+{
+    auto temporary_emitter { std::make_unique<generic_emitter<int, std::string>>() };
+    auto connection { temporary_emitter->generic_signal.connect_key<0>(5, [](int) {}) };
+
+    temporary_emitter.reset();
+    connection.disconnect();
+}
+
+TEST_F(test_keyed_connections, keys_are_erased_with_their_last_connection)
+{
+    generic_emitter<counted_key> key_emitter;
+    std::vector<connection<details::unsafe_shared_pointer>> connections;
+
+    for (int key { 0 }; key < 100; ++key)
+    {
+        connections.emplace_back(
+            key_emitter.generic_signal.connect_key<0>(counted_key { key }, [] {}));
+        connections.emplace_back(
+            key_emitter.generic_signal.connect_key<0>(counted_key { key }, [] {}));
+    }
+    EXPECT_EQ(counted_key::instances, 100);
+
+    for (auto& connection: connections)
+    {
+        connection.disconnect();
+    }
+    EXPECT_EQ(counted_key::instances, 0);
+    EXPECT_EQ(key_emitter.generic_signal.slot_count(), 0);
+
+    // Erased keys can be connected again.
+    int count { 0 };
+    key_emitter.generic_signal.connect_key<0>(counted_key { 5 }, [&count] { ++count; });
+    key_emitter.generic_emit(counted_key { 5 });
+    EXPECT_EQ(count, 1);
+}
+
+TEST_F(test_keyed_connections, connections_change_while_emitting)
+{
+    safe_generic_emitter<int> key_emitter;
+    std::atomic<int> calls { 0 };
+    key_emitter.generic_signal.connect_key<0>(0, [&calls] { ++calls; });
+
+    std::vector<std::thread> threads;
+    for (int i { 0 }; i < 2; ++i)
+    {
+        threads.emplace_back(
+            [&key_emitter]
+            {
+                for (int j { 0 }; j < 1024; ++j)
+                {
+                    key_emitter.generic_emit(j % 16);
+                }
+            });
+    }
+    threads.emplace_back(
+        [&key_emitter]
+        {
+            for (int j { 0 }; j < 1000; ++j)
+            {
+                key_emitter.generic_signal.connect_key<0>(1 + (j % 15), [] {}).disconnect();
+            }
+        });
+
+    for (auto& thread: threads)
+    {
+        thread.join();
+    }
+
+    EXPECT_EQ(calls, 2 * 1024 / 16);
+    EXPECT_EQ(key_emitter.generic_signal.slot_count(), 1);
+}
@@ -0,0 +1,223 @@
+#include "stimulus.h"
+
+#include <string>
+#include <thread>
+#include <tuple>
+#include <utility>
+
+#include <gtest/gtest.h>
+#include <vector>
+
+#include "utilities.h"
+
+class test_lazy_emission: public ::testing::Test
+{
+protected:
+    template<class Emitter>
+    struct lazy_emitter: public Emitter
+    {
+        template<class... Args>
+        using signal = typename Emitter::template signal<Args...>;
+
+        signal<int> int_signal;
+        signal<int, std::string> pair_signal;
+
+        template<class Factory>
+        void lazy_emit_int(Factory&& factory)
+        {
+            this->emit_lazy(&lazy_emitter::int_signal, std::forward<Factory>(factory));
+        }
+
+        template<class Factory>
+        void lazy_emit_pair(Factory&& factory)
+        {
+            this->emit_lazy(&lazy_emitter::pair_signal, std::forward<Factory>(factory));
+        }
+    };
+
+    lazy_emitter<basic_emitter> int_emitter;
+    lazy_emitter<safe_emitter> safe_int_emitter;
+
+    int factory_calls { 0 };
+
+    auto int_factory()
+    {
+        return [this]
+        {
+            ++factory_calls;
+            return 5;
+        };
+    }
+};
+
+TEST_F(test_lazy_emission, no_connection)
+{
+    int_emitter.lazy_emit_int(int_factory());
+    safe_int_emitter.lazy_emit_int(int_factory());
+
+    EXPECT_EQ(factory_calls, 0);
+}
+
+TEST_F(test_lazy_emission, connected)
+{
+    int& count = call_count<int>;
+    reset<int>();
+
+    int_emitter.int_signal.connect(slot_function<int>);
+    int_emitter.int_signal.connect(slot_function<int>);
+    int_emitter.lazy_emit_int(int_factory());
+
+    EXPECT_EQ(factory_calls, 1);
+    EXPECT_EQ(count, 2);
+    EXPECT_EQ(call_args<int>.back(), 5);
+}
+
+TEST_F(test_lazy_emission, tuple_payload)
+{
+    std::vector<std::pair<int, std::string>> received;
+
+    int_emitter.pair_signal.connect([&received](int value, const std::string& text)
+                                { received.emplace_back(value, text); });
+    int_emitter.lazy_emit_pair([] { return std::tuple { 5, std::string { "five" } }; });
+
+    ASSERT_EQ(received.size(), 1);
+    EXPECT_EQ(received.front(), std::make_pair(5, std::string { "five" }));
+}
+
+TEST_F(test_lazy_emission, suspended_connections)
+{
+    int& count = call_count<int>;
+    reset<int>();
+
+    auto connection { int_emitter.int_signal.connect(slot_function<int>) };
+    connection.suspend();
+    int_emitter.lazy_emit_int(int_factory());
+    EXPECT_EQ(factory_calls, 0);
+
+    connection.resume();
+    int_emitter.lazy_emit_int(int_factory());
+    EXPECT_EQ(factory_calls, 1);
+    EXPECT_EQ(count, 1);
+}
+
+TEST_F(test_lazy_emission, fired_and_disconnected_connections)
+{
+    auto connection { int_emitter.int_signal.connect([](int) {}) };
+    int_emitter.int_signal.connect_once([](int) {});
+
+    connection.disconnect();
+    int_emitter.lazy_emit_int(int_factory());
+    int_emitter.lazy_emit_int(int_factory());
+
+    // The single shot connection fired on the first emission.
+    EXPECT_EQ(factory_calls, 1);
+}
+
+TEST_F(test_lazy_emission, blocked)
+{
+    int_emitter.int_signal.connect([](int) {});
+
+    {
+        scoped_blocker blocker { int_emitter };
+        int_emitter.lazy_emit_int(int_factory());
+    }
+    {
+        scoped_blocker blocker { int_emitter.int_signal };
+        int_emitter.lazy_emit_int(int_factory());
+    }
+
+    EXPECT_EQ(factory_calls, 0);
+    EXPECT_EQ(int_emitter.suppressed_emissions(), 1);
+    EXPECT_EQ(int_emitter.int_signal.suppressed_emissions(), 1);
+}
+
+TEST_F(test_lazy_emission, slot_counts)
+{
+    auto& int_signal { int_emitter.int_signal };
+
+    EXPECT_FALSE(int_signal.has_active_slots());
+    EXPECT_EQ(int_signal.slot_count(), 0);
+
+    auto first { int_signal.connect([](int) {}) };
+    auto second { int_signal.connect([](int) {}) };
+    EXPECT_TRUE(int_signal.has_active_slots());
+    EXPECT_EQ(int_signal.slot_count(), 2);
+
+    // Suspended connections are still connected.
+    first.suspend();
+    first.suspend();
+    second.suspend();
+    EXPECT_FALSE(int_signal.has_active_slots());
+    EXPECT_EQ(int_signal.slot_count(), 2);
+
+    second.resume();
+    second.resume();
+    EXPECT_TRUE(int_signal.has_active_slots());
+
+    second.disconnect();
+    second.disconnect();
+    EXPECT_FALSE(int_signal.has_active_slots());
+    EXPECT_EQ(int_signal.slot_count(), 1);
+
+    // Disconnected connections are not counted back on resumption.
+    second.resume();
+    EXPECT_FALSE(int_signal.has_active_slots());
+
+    first.disconnect();
+    EXPECT_EQ(int_signal.slot_count(), 0);
+}
+
+TEST_F(test_lazy_emission, fired_connections_are_not_counted)
+{
+    auto connection { int_emitter.int_signal.connect_once([](int) {}) };
+    EXPECT_EQ(int_emitter.int_signal.slot_count(), 1);
+
+    int_emitter.lazy_emit_int(int_factory());
+    EXPECT_FALSE(int_emitter.int_signal.has_active_slots());
+    EXPECT_EQ(int_emitter.int_signal.slot_count(), 0);
+
+    connection.disconnect();
+    EXPECT_EQ(int_emitter.int_signal.slot_count(), 0);
+}
+
+TEST_F(test_lazy_emission, guard_destruction)
+{
+    {
+        safe_receiver receiver;
+        safe_int_emitter.int_signal.connect([](int) {}, receiver);
+        EXPECT_EQ(safe_int_emitter.int_signal.slot_count(), 1);
+    }
+
+    EXPECT_EQ(safe_int_emitter.int_signal.slot_count(), 0);
+    safe_int_emitter.lazy_emit_int(int_factory());
+    EXPECT_EQ(factory_calls, 0);
+}
+
+TEST_F(test_lazy_emission, concurrent_counts)
+{
+    auto& int_signal { safe_int_emitter.int_signal };
+
+    std::vector<std::thread> threads;
+    for (int i { 0 }; i < 8; ++i)
+    {
+        threads.emplace_back(
+            [&int_signal]
+            {
+                for (int j { 0 }; j < 100; ++j)
+                {
+                    auto connection { int_signal.connect([](int) {}) };
+                    connection.suspend();
+                    connection.resume();
+                    connection.disconnect();
+                }
+            });
+    }
+
+    for (auto& thread: threads)
+    {
+        thread.join();
+    }
+
+    EXPECT_FALSE(int_signal.has_active_slots());
+    EXPECT_EQ(int_signal.slot_count(), 0);
+}
@@ -0,0 +1,97 @@
+#include "stimulus.h"
+
+#include <utility>
+
+#include <gtest/gtest.h>
+
+#include "utilities.h"
+
+namespace
+{
+    template<class Emitter>
+    using signal_type = decltype(std::declval<Emitter>().generic_signal);
+} // namespace
+
+static_assert(sizeof(signal_type<generic_emitter<int>>) == sizeof(void*));
+static_assert(sizeof(signal_type<safe_generic_emitter<int>>) == sizeof(void*));
+
+class test_lazy_signal_state: public ::testing::Test
+{
+protected:
+    generic_emitter<int> int_emitter;
+    safe_generic_emitter<int> safe_int_emitter;
+};
+
+TEST_F(test_lazy_signal_state, emit_without_connection)
+{
+    int& count = call_count<int>;
+    reset<int>();
+
+    int_emitter.generic_emit(5);
+    safe_int_emitter.generic_emit(5);
+
+    EXPECT_EQ(count, 0);
+}
+
+TEST_F(test_lazy_signal_state, connect_after_emit)
+{
+    int& count = call_count<int>;
+    reset<int>();
+
+    int_emitter.generic_emit(5);
+    int_emitter.generic_signal.connect(slot_function<int>);
+    int_emitter.generic_emit(6);
+
+    EXPECT_EQ(count, 1);
+    EXPECT_EQ(call_args<int>.back(), 6);
+}
+
+TEST_F(test_lazy_signal_state, emit_after_last_disconnection)
+{
+    int& count = call_count<int>;
+    reset<int>();
+
+    auto connection { safe_int_emitter.generic_signal.connect(slot_function<int>) };
+    safe_int_emitter.generic_emit(5);
+    connection.disconnect();
+    safe_int_emitter.generic_emit(6);
+
+    EXPECT_EQ(count, 1);
+    EXPECT_EQ(call_args<int>.back(), 5);
+}
+
+TEST_F(test_lazy_signal_state, copied_emitter_is_not_connected)
+{
+    int& count = call_count<int>;
+    reset<int>();
+
+    int_emitter.generic_signal.connect(slot_function<int>);
+
+    auto copy { int_emitter };
+    copy.generic_emit(5);
+
+    EXPECT_EQ(count, 0);
+}
+
+TEST_F(test_lazy_signal_state, forwarding_to_unconnected_signal)
+{
+    int& count = call_count<int>;
+    reset<int>();
+
+    {
+        forwarding_emitter<int> forwarder;
+        forwarder.forward_from(int_emitter);
+
+        int_emitter.generic_emit(5);
+        EXPECT_EQ(count, 0);
+
+        forwarder.forwarded_signal.connect(slot_function<int>);
+        int_emitter.generic_emit(6);
+        EXPECT_EQ(count, 1);
+        EXPECT_EQ(call_args<int>.back(), 6);
+    }
+
+    // The forwarding connection died with the forwarding signal.
+    int_emitter.generic_emit(7);
+    EXPECT_EQ(count, 1);
+}
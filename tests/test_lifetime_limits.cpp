@@ -0,0 +1,221 @@
+#include "stimulus.h"
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "utilities.h"
+
+class test_lifetime_limits: public ::testing::Test
+{
+protected:
+    generic_emitter<int> int_emitter;
+    generic_emitter<> close_emitter;
+    generic_emitter<int, std::string> int_string_emitter;
+    safe_generic_emitter<int> safe_int_emitter;
+
+    std::vector<int> values;
+
+    auto store_value()
+    {
+        return [this](int value) { values.emplace_back(value); };
+    }
+
+    void emit_range(int first, int last)
+    {
+        for (int i { first }; i <= last; ++i)
+        {
+            int_emitter.generic_emit(i);
+        }
+    }
+};
+
+TEST_F(test_lifetime_limits, take)
+{
+    int_emitter.generic_signal | take(3) | connect(store_value());
+
+    emit_range(1, 2);
+    EXPECT_EQ(int_emitter.generic_signal.slot_count(), 1);
+
+    // The connection ends with its last call.
+    emit_range(3, 5);
+    EXPECT_EQ(values, (std::vector<int> { 1, 2, 3 }));
+    EXPECT_EQ(int_emitter.generic_signal.slot_count(), 0);
+    EXPECT_FALSE(int_emitter.generic_signal.has_active_slots());
+}
+
+TEST_F(test_lifetime_limits, take_nothing)
+{
+    int_emitter.generic_signal | take(0) | connect(store_value());
+
+    emit_range(1, 3);
+    EXPECT_TRUE(values.empty());
+    EXPECT_EQ(int_emitter.generic_signal.slot_count(), 0);
+}
+
+TEST_F(test_lifetime_limits, take_counts_each_connection)
+{
+    std::vector<int> other_values;
+
+    auto taken { int_emitter.generic_signal | take(2) };
+    taken.connect(store_value());
+
+    emit_range(1, 1);
+    taken.connect([&other_values](int value) { other_values.emplace_back(value); });
+    emit_range(2, 4);
+
+    EXPECT_EQ(values, (std::vector<int> { 1, 2 }));
+    EXPECT_EQ(other_values, (std::vector<int> { 2, 3 }));
+}
+
+TEST_F(test_lifetime_limits, skip)
+{
+    int_emitter.generic_signal | skip(2) | connect(store_value());
+
+    emit_range(1, 5);
+    EXPECT_EQ(values, (std::vector<int> { 3, 4, 5 }));
+    EXPECT_EQ(int_emitter.generic_signal.slot_count(), 1);
+}
+
+TEST_F(test_lifetime_limits, take_while)
+{
+    int_emitter.generic_signal | take_while([](int value) { return value < 3; }) |
+        connect(store_value());
+
+    for (int value: { 1, 2, 3, 1, 2 })
+    {
+        int_emitter.generic_emit(value);
+    }
+
+    EXPECT_EQ(values, (std::vector<int> { 1, 2 }));
+    EXPECT_EQ(int_emitter.generic_signal.slot_count(), 0);
+}
+
+TEST_F(test_lifetime_limits, take_while_partial_arguments)
+{
+    int& count = call_count<int, std::string>;
+    reset<int, std::string>();
+
+    int_string_emitter.generic_signal | take_while([](int value) { return value != 0; }) |
+        connect(slot_function<int, std::string>);
+
+    int_string_emitter.generic_emit(1, "one");
+    int_string_emitter.generic_emit(0, "zero");
+    int_string_emitter.generic_emit(2, "two");
+
+    EXPECT_EQ(count, 1);
+    EXPECT_EQ(call_args<std::string>.back(), "one");
+}
+
+TEST_F(test_lifetime_limits, take_until)
+{
+    int_emitter.generic_signal | take_until(close_emitter.generic_signal) |
+        connect(store_value());
+    EXPECT_EQ(close_emitter.generic_signal.slot_count(), 1);
+
+    emit_range(1, 2);
+    close_emitter.generic_emit();
+    EXPECT_EQ(close_emitter.generic_signal.slot_count(), 0);
+
+    emit_range(3, 4);
+    EXPECT_EQ(values, (std::vector<int> { 1, 2 }));
+    EXPECT_EQ(int_emitter.generic_signal.slot_count(), 0);
+}
+
+TEST_F(test_lifetime_limits, take_until_disconnects_with_the_notifier)
+{
+    int_emitter.generic_signal | filter([](int value) { return value > 0; }) |
+        take_until(close_emitter.generic_signal) | connect(store_value());
+    EXPECT_EQ(int_emitter.generic_signal.slot_count(), 1);
+
+    // Without waiting for the next emission of the source.
+    close_emitter.generic_emit();
+    EXPECT_EQ(int_emitter.generic_signal.slot_count(), 0);
+    EXPECT_EQ(close_emitter.generic_signal.slot_count(), 0);
+}
+
+TEST_F(test_lifetime_limits, take_until_transformed_notifier)
+{
+    int_emitter.generic_signal |
+        take_until(int_emitter.generic_signal | filter([](int value) { return value < 0; })) |
+        connect(store_value());
+
+    for (int value: { 1, 2, -1, 3 })
+    {
+        int_emitter.generic_emit(value);
+    }
+
+    // The notifier is connected first, so it is told before the emission is forwarded.
+    EXPECT_EQ(values, (std::vector<int> { 1, 2 }));
+}
+
+TEST_F(test_lifetime_limits, take_until_notified_while_emitting)
+{
+    safe_int_emitter.generic_signal |
+        take_until(safe_int_emitter.generic_signal | filter([](int value) { return value < 0; })) |
+        connect(store_value());
+
+    // The notifier ends the connection from the emission of its own signal.
+    for (int value: { 1, -1, 2 })
+    {
+        safe_int_emitter.generic_emit(value);
+    }
+
+    EXPECT_EQ(values, (std::vector<int> { 1 }));
+    EXPECT_EQ(safe_int_emitter.generic_signal.slot_count(), 0);
+}
+
+TEST_F(test_lifetime_limits, chained_transformation)
+{
+    int_emitter.generic_signal | filter([](int value) { return value % 2 == 0; }) | take(2) |
+        transform([](int value) { return value * 10; }) | connect(store_value());
+
+    emit_range(1, 10);
+    EXPECT_EQ(values, (std::vector<int> { 20, 40 }));
+    EXPECT_EQ(int_emitter.generic_signal.slot_count(), 0);
+}
+
+TEST_F(test_lifetime_limits, policy)
+{
+    task_queue_policy policy;
+    int_emitter.generic_signal | take(2) | connect(store_value(), policy);
+
+    // Calls are counted when they run.
+    emit_range(1, 4);
+    EXPECT_EQ(policy.size(), 4);
+
+    policy.run_all();
+    EXPECT_EQ(values, (std::vector<int> { 1, 2 }));
+    EXPECT_EQ(int_emitter.generic_signal.slot_count(), 0);
+}
+
+TEST_F(test_lifetime_limits, concurrent_emissions)
+{
+    std::atomic<int> count { 0 };
+
+    safe_int_emitter.generic_signal | take(50) | connect([&count](int) { ++count; });
+
+    std::vector<std::thread> threads;
+    for (int i { 0 }; i < 4; ++i)
+    {
+        threads.emplace_back(
+            [this]
+            {
+                for (int j { 0 }; j < 100; ++j)
+                {
+                    safe_int_emitter.generic_emit(j);
+                }
+            });
+    }
+
+    for (auto& thread: threads)
+    {
+        thread.join();
+    }
+
+    EXPECT_EQ(count, 50);
+    EXPECT_EQ(safe_int_emitter.generic_signal.slot_count(), 0);
+}
@@ -0,0 +1,187 @@
+#include "stimulus.h"
+
+#include <functional>
+#include <memory>
+#include <thread>
+#include <utility>
+
+#include <gtest/gtest.h>
+#include <vector>
+
+#include "utilities.h"
+
+class test_pending_call_cancellation: public ::testing::Test
+{
+protected:
+    generic_emitter<int> int_emitter;
+    safe_generic_emitter<int> safe_int_emitter;
+
+    struct storing_policy
+    {
+        void execute(std::function<void()> callable)
+        {
+            m_functions.emplace_back(std::move(callable));
+        }
+
+        void run_all()
+        {
+            for (auto& function: m_functions)
+            {
+                function();
+            }
+            m_functions.clear();
+        }
+
+        static constexpr bool is_synchronous { false };
+
+        std::vector<std::function<void()>> m_functions;
+    };
+
+    struct counting_receiver: public safe_receiver
+    {
+        void slot(int value)
+        {
+            values.emplace_back(value);
+        }
+
+        std::vector<int> values;
+    };
+
+    storing_policy policy;
+    task_queue_policy task_policy;
+};
+
+TEST_F(test_pending_call_cancellation, disconnect)
+{
+    int& count = call_count<int>;
+    reset<int>();
+
+    auto connection { int_emitter.generic_signal.connect(slot_function<int>, policy) };
+    auto task_connection { int_emitter.generic_signal.connect(slot_function<int>, task_policy) };
+
+    int_emitter.generic_emit(5);
+    connection.disconnect();
+    task_connection.disconnect();
+
+    policy.run_all();
+    task_policy.run_all();
+    EXPECT_EQ(count, 0);
+}
+
+TEST_F(test_pending_call_cancellation, suspend)
+{
+    int& count = call_count<int>;
+    reset<int>();
+
+    auto connection { int_emitter.generic_signal.connect(slot_function<int>, policy) };
+    auto task_connection { int_emitter.generic_signal.connect(slot_function<int>, task_policy) };
+
+    int_emitter.generic_emit(5);
+    connection.suspend();
+    task_connection.suspend();
+    connection.resume();
+    task_connection.resume();
+    int_emitter.generic_emit(6);
+
+    // Only calls emitted after resumption are run.
+    policy.run_all();
+    task_policy.run_all();
+    EXPECT_EQ(count, 2);
+    EXPECT_EQ(call_args<int>.front(), 6);
+    EXPECT_EQ(call_args<int>.back(), 6);
+}
+
+TEST_F(test_pending_call_cancellation, calls_before_disconnection_run)
+{
+    int& count = call_count<int>;
+    reset<int>();
+
+    auto connection { int_emitter.generic_signal.connect(slot_function<int>, task_policy) };
+
+    int_emitter.generic_emit(5);
+    task_policy.run_all();
+    int_emitter.generic_emit(6);
+    connection.disconnect();
+    task_policy.run_all();
+
+    EXPECT_EQ(count, 1);
+    EXPECT_EQ(call_args<int>.back(), 5);
+}
+
+TEST_F(test_pending_call_cancellation, connect_once)
+{
+    int& count = call_count<int>;
+    reset<int>();
+
+    int_emitter.generic_signal.connect_once(slot_function<int>, task_policy);
+
+    // Firing doesn't cancel the call being emitted.
+    int_emitter.generic_emit(5);
+    int_emitter.generic_emit(6);
+    task_policy.run_all();
+
+    EXPECT_EQ(count, 1);
+    EXPECT_EQ(call_args<int>.back(), 5);
+}
+
+TEST_F(test_pending_call_cancellation, safe_receiver_destruction)
+{
+    auto receiver { std::make_unique<counting_receiver>() };
+
+    safe_int_emitter.generic_signal.connect(&counting_receiver::slot, *receiver, policy);
+    safe_int_emitter.generic_signal.connect(&counting_receiver::slot, *receiver, task_policy);
+
+    safe_int_emitter.generic_emit(5);
+    safe_int_emitter.generic_emit(6);
+    EXPECT_EQ(policy.m_functions.size(), 2);
+    EXPECT_EQ(task_policy.size(), 2);
+
+    // Running any of these calls would use the destroyed receiver.
+    receiver.reset();
+
+    policy.run_all();
+    task_policy.run_all();
+}
+
+TEST_F(test_pending_call_cancellation, safe_receiver_destruction_with_worker)
+{
+    auto receiver { std::make_unique<counting_receiver>() };
+
+    safe_int_emitter.generic_signal.connect(&counting_receiver::slot, *receiver, task_policy);
+
+    for (int i { 0 }; i < 100; ++i)
+    {
+        safe_int_emitter.generic_emit(i);
+    }
+
+    std::thread emitting_thread { [this]
+    {
+        for (int i { 0 }; i < 100; ++i)
+        {
+            safe_int_emitter.generic_emit(i);
+        }
+    } };
+    emitting_thread.join();
+
+    receiver.reset();
+
+    std::thread worker { [this] { task_policy.run_all(); } };
+    worker.join();
+
+    EXPECT_TRUE(task_policy.empty());
+}
+
+TEST_F(test_pending_call_cancellation, guard_destruction)
+{
+    int& count = call_count<int>;
+    reset<int>();
+
+    {
+        counting_receiver receiver;
+        safe_int_emitter.generic_signal.connect(slot_function<int>, receiver, task_policy);
+        safe_int_emitter.generic_emit(5);
+    }
+
+    task_policy.run_all();
+    EXPECT_EQ(count, 0);
+}
@@ -0,0 +1,283 @@
+#include "stimulus.h"
+
+#include <atomic>
+#include <cstddef>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "utilities.h"
+
+class test_property: public ::testing::Test
+{
+protected:
+    struct document
+    {
+        int version { 0 };
+        std::vector<int> content;
+
+        friend auto operator==(const document&, const document&) -> bool = default;
+    };
+
+    struct version_hash
+    {
+        auto operator()(const document& hashed) const -> std::size_t
+        {
+            ++hashes;
+            return static_cast<std::size_t>(hashed.version);
+        }
+
+        static inline int hashes { 0 };
+    };
+
+    struct settings: public basic_emitter
+    {
+        property<int> volume { 5 };
+        property<std::string> name;
+        property<document, by_hash<version_hash>> current_document;
+
+        auto set_volume(int value) -> bool
+        {
+            return set(&settings::volume, value);
+        }
+
+        auto set_name(std::string value) -> bool
+        {
+            return set(&settings::name, std::move(value));
+        }
+
+        auto set_document(document value) -> bool
+        {
+            return set(&settings::current_document, std::move(value));
+        }
+    };
+
+    struct safe_settings: public safe_emitter
+    {
+        property<int> volume;
+
+        auto set_volume(int value) -> bool
+        {
+            return set(&safe_settings::volume, value);
+        }
+    };
+
+    struct volume_receiver: public basic_receiver
+    {
+        void on_volume(int value)
+        {
+            values.emplace_back(value);
+        }
+
+        std::vector<int> values;
+    };
+
+    settings settings_emitter;
+    safe_settings safe_settings_emitter;
+};
+
+TEST_F(test_property, value)
+{
+    EXPECT_EQ(settings_emitter.volume.value(), 5);
+    EXPECT_EQ(settings_emitter.name.value(), "");
+
+    settings_emitter.set_volume(7);
+    EXPECT_EQ(settings_emitter.volume.value(), 7);
+}
+
+TEST_F(test_property, emits_only_on_change)
+{
+    std::vector<std::string> values;
+
+    settings_emitter.name.connect([&values](const std::string& value)
+                                  { values.emplace_back(value); });
+    values.clear();
+
+    EXPECT_TRUE(settings_emitter.set_name("first"));
+    EXPECT_FALSE(settings_emitter.set_name("first"));
+    EXPECT_TRUE(settings_emitter.set_name("second"));
+
+    EXPECT_EQ(values, (std::vector<std::string> { "first", "second" }));
+}
+
+TEST_F(test_property, connection_gets_current_value)
+{
+    std::vector<int> values;
+
+    settings_emitter.set_volume(8);
+    settings_emitter.volume.connect([&values](int value) { values.emplace_back(value); });
+    EXPECT_EQ(values, std::vector<int> { 8 });
+
+    settings_emitter.set_volume(9);
+    EXPECT_EQ(values, (std::vector<int> { 8, 9 }));
+}
+
+TEST_F(test_property, member_function)
+{
+    volume_receiver receiver;
+
+    settings_emitter.volume.connect(&volume_receiver::on_volume, receiver);
+    settings_emitter.set_volume(6);
+
+    EXPECT_EQ(receiver.values, (std::vector<int> { 5, 6 }));
+}
+
+TEST_F(test_property, guard_destruction)
+{
+    int& count = call_count<int>;
+    reset<int>();
+
+    {
+        basic_receiver receiver;
+        settings_emitter.volume.connect(slot_function<int>, receiver);
+        EXPECT_EQ(count, 1);
+    }
+
+    settings_emitter.set_volume(6);
+    EXPECT_EQ(count, 1);
+    EXPECT_EQ(settings_emitter.volume.slot_count(), 0);
+}
+
+TEST_F(test_property, policy)
+{
+    int& count = call_count<int>;
+    reset<int>();
+
+    task_queue_policy policy;
+    settings_emitter.volume.connect(slot_function<int>, policy);
+    EXPECT_EQ(count, 0);
+    EXPECT_EQ(policy.size(), 1);
+
+    policy.run_all();
+    EXPECT_EQ(count, 1);
+    EXPECT_EQ(call_args<int>.back(), 5);
+}
+
+TEST_F(test_property, disconnection)
+{
+    int& count = call_count<int>;
+    reset<int>();
+
+    auto connection { settings_emitter.volume.connect(slot_function<int>) };
+    connection.disconnect();
+
+    settings_emitter.set_volume(6);
+    EXPECT_EQ(count, 1);
+}
+
+TEST_F(test_property, blocked_emitter)
+{
+    int& count = call_count<int>;
+    reset<int>();
+
+    settings_emitter.volume.connect(slot_function<int>);
+
+    // The value changes, but nobody is told.
+    settings_emitter.block_signals();
+    EXPECT_TRUE(settings_emitter.set_volume(6));
+    EXPECT_EQ(settings_emitter.volume.value(), 6);
+    EXPECT_EQ(settings_emitter.suppressed_emissions(), 1);
+
+    settings_emitter.unblock_signals();
+    EXPECT_FALSE(settings_emitter.set_volume(6));
+    EXPECT_TRUE(settings_emitter.set_volume(7));
+    EXPECT_EQ(count, 2);
+    EXPECT_EQ(call_args<int>.back(), 7);
+}
+
+TEST_F(test_property, hash_comparison)
+{
+    int& count = call_count<document>;
+    reset<document>();
+
+    settings_emitter.current_document.connect(slot_function<document>);
+    version_hash::hashes = 0;
+
+    EXPECT_TRUE(settings_emitter.set_document(document { 1, { 1, 2, 3 } }));
+    EXPECT_EQ(count, 2);
+
+    // Only the hashes are compared, and only the new value is hashed.
+    EXPECT_FALSE(settings_emitter.set_document(document { 1, { 4, 5, 6 } }));
+    EXPECT_EQ(count, 2);
+    EXPECT_EQ(version_hash::hashes, 2);
+    EXPECT_EQ(settings_emitter.current_document.value().content, (std::vector<int> { 1, 2, 3 }));
+}
+
+TEST_F(test_property, copy)
+{
+    int& count = call_count<int>;
+    reset<int>();
+
+    settings_emitter.volume.connect(slot_function<int>);
+    settings_emitter.set_volume(6);
+
+    // The copy has the value, but not the connections.
+    auto copy { settings_emitter };
+    EXPECT_EQ(copy.volume.value(), 6);
+    EXPECT_EQ(copy.volume.slot_count(), 0);
+
+    copy.set_volume(7);
+    EXPECT_EQ(count, 2);
+    EXPECT_EQ(settings_emitter.volume.value(), 6);
+}
+
+TEST_F(test_property, concurrent_changes)
+{
+    std::vector<std::thread> threads;
+    for (int i { 0 }; i < 4; ++i)
+    {
+        threads.emplace_back(
+            [this, i]
+            {
+                for (int j { 0 }; j < 100; ++j)
+                {
+                    safe_settings_emitter.set_volume(i * 100 + j);
+                    safe_settings_emitter.volume.connect([](int) {}).disconnect();
+                }
+            });
+    }
+
+    for (auto& thread: threads)
+    {
+        thread.join();
+    }
+
+    EXPECT_EQ(safe_settings_emitter.volume.slot_count(), 0);
+}
+
+TEST_F(test_property, concurrent_changes_are_emitted_in_order)
+{
+    std::atomic<int> last_delivered { -1 };
+    safe_settings_emitter.volume.connect([&last_delivered](int value) { last_delivered = value; });
+
+    std::vector<std::atomic<int>> connected_values(4);
+    std::vector<std::thread> threads;
+    for (int i { 0 }; i < 4; ++i)
+    {
+        threads.emplace_back(
+            [this, i, &connected_values]
+            {
+                for (int j { 0 }; j < 1000; ++j)
+                {
+                    safe_settings_emitter.set_volume(i * 1000 + j);
+                }
+                safe_settings_emitter.volume.connect([&connected_values, i](int value)
+                                                     { connected_values[i] = value; });
+            });
+    }
+
+    for (auto& thread: threads)
+    {
+        thread.join();
+    }
+
+    const int current { safe_settings_emitter.volume.value() };
+    EXPECT_EQ(last_delivered, current);
+    for (const auto& connected_value: connected_values)
+    {
+        EXPECT_EQ(connected_value, current);
+    }
+}
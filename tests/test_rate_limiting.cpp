@@ -0,0 +1,263 @@
+#include "stimulus.h"
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "utilities.h"
+
+using namespace std::chrono_literals;
+
+static_assert(details::clock_like<manual_clock>);
+static_assert(details::clock_like<std::chrono::steady_clock>);
+
+class test_rate_limiting: public ::testing::Test
+{
+protected:
+    generic_emitter<int> int_emitter;
+    generic_emitter<int> other_int_emitter;
+    safe_generic_emitter<int> safe_int_emitter;
+
+    manual_clock::time_point now {};
+    timer_wheel<manual_clock> wheel { 1ms, manual_clock { &now } };
+    safe_timer_wheel<manual_clock> safe_wheel { 1ms, manual_clock { &now } };
+
+    auto advance_to(manual_clock::duration time) -> std::size_t
+    {
+        now = manual_clock::time_point { time };
+        return wheel.advance();
+    }
+};
+
+TEST_F(test_rate_limiting, debounce)
+{
+    std::vector<int> values;
+
+    auto debounced { int_emitter.generic_signal | debounce(10ms, wheel) };
+    debounced.connect([&values](int value) { values.emplace_back(value); });
+
+    int_emitter.generic_emit(1);
+    int_emitter.generic_emit(2);
+    advance_to(4ms);
+    int_emitter.generic_emit(3);
+    EXPECT_EQ(wheel.size(), 1);
+
+    // Each emission restarts the delay.
+    EXPECT_EQ(advance_to(13ms), 0);
+    EXPECT_TRUE(values.empty());
+
+    EXPECT_EQ(advance_to(14ms), 1);
+    EXPECT_EQ(values, std::vector<int> { 3 });
+    EXPECT_EQ(wheel.size(), 0);
+
+    advance_to(100ms);
+    EXPECT_EQ(values, std::vector<int> { 3 });
+}
+
+TEST_F(test_rate_limiting, leading_throttle)
+{
+    std::vector<int> values;
+
+    auto throttled { int_emitter.generic_signal | throttle(10ms, wheel) };
+    throttled.connect([&values](int value) { values.emplace_back(value); });
+
+    int_emitter.generic_emit(1);
+    int_emitter.generic_emit(2);
+    advance_to(9ms);
+    int_emitter.generic_emit(3);
+    EXPECT_EQ(values, std::vector<int> { 1 });
+
+    advance_to(10ms);
+    EXPECT_EQ(values, std::vector<int> { 1 });
+
+    int_emitter.generic_emit(4);
+    int_emitter.generic_emit(5);
+    EXPECT_EQ(values, (std::vector<int> { 1, 4 }));
+}
+
+TEST_F(test_rate_limiting, trailing_throttle)
+{
+    std::vector<int> values;
+
+    auto throttled { int_emitter.generic_signal | throttle(10ms, wheel, throttle_edge::trailing) };
+    throttled.connect([&values](int value) { values.emplace_back(value); });
+
+    int_emitter.generic_emit(1);
+    advance_to(9ms);
+    int_emitter.generic_emit(2);
+    EXPECT_TRUE(values.empty());
+
+    // Unlike debounce, emissions don't push the end of the period.
+    advance_to(10ms);
+    EXPECT_EQ(values, std::vector<int> { 2 });
+
+    advance_to(30ms);
+    int_emitter.generic_emit(3);
+    advance_to(40ms);
+    EXPECT_EQ(values, (std::vector<int> { 2, 3 }));
+}
+
+TEST_F(test_rate_limiting, sample)
+{
+    std::vector<int> values;
+
+    auto sampled { int_emitter.generic_signal | sample(10ms, wheel) };
+    sampled.connect([&values](int value) { values.emplace_back(value); });
+
+    int_emitter.generic_emit(1);
+    int_emitter.generic_emit(2);
+    advance_to(10ms);
+    EXPECT_EQ(values, std::vector<int> { 2 });
+
+    advance_to(15ms);
+    int_emitter.generic_emit(3);
+    advance_to(20ms);
+    EXPECT_EQ(values, (std::vector<int> { 2, 3 }));
+
+    // A period without emission stops the sampling.
+    advance_to(30ms);
+    EXPECT_EQ(values, (std::vector<int> { 2, 3 }));
+    EXPECT_EQ(wheel.size(), 0);
+}
+
+TEST_F(test_rate_limiting, long_period)
+{
+    int& count = call_count<int>;
+    reset<int>();
+
+    auto throttled { int_emitter.generic_signal |
+                     throttle(std::chrono::hours { 2 }, wheel, throttle_edge::trailing) };
+    throttled.connect(slot_function<int>);
+
+    int_emitter.generic_emit(5);
+    for (int minutes { 1 }; minutes < 120; ++minutes)
+    {
+        advance_to(std::chrono::minutes { minutes });
+    }
+    advance_to(std::chrono::hours { 2 } - 1ms);
+    EXPECT_EQ(count, 0);
+
+    advance_to(std::chrono::hours { 2 });
+    EXPECT_EQ(count, 1);
+    EXPECT_EQ(call_args<int>.back(), 5);
+}
+
+TEST_F(test_rate_limiting, disconnection_before_expiry)
+{
+    int& count = call_count<int>;
+    reset<int>();
+
+    auto debounced { int_emitter.generic_signal | debounce(10ms, wheel) };
+    auto connection { debounced.connect(slot_function<int>) };
+
+    int_emitter.generic_emit(5);
+    connection.disconnect();
+    EXPECT_EQ(int_emitter.generic_signal.slot_count(), 0);
+
+    advance_to(10ms);
+    EXPECT_EQ(count, 0);
+    EXPECT_EQ(wheel.size(), 0);
+}
+
+TEST_F(test_rate_limiting, temporary_source)
+{
+    int& count = call_count<int>;
+    reset<int>();
+
+    // The scheduled timer keeps the stage alive.
+    auto connection { int_emitter.generic_signal | debounce(10ms, wheel) |
+                      connect(slot_function<int>) };
+
+    int_emitter.generic_emit(5);
+    advance_to(10ms);
+    EXPECT_EQ(count, 1);
+    EXPECT_EQ(call_args<int>.back(), 5);
+}
+
+TEST_F(test_rate_limiting, connections_share_the_pacing)
+{
+    int& count = call_count<int>;
+    reset<int>();
+
+    auto debounced { int_emitter.generic_signal | debounce(10ms, wheel) };
+    debounced.connect(slot_function<int>);
+    debounced.connect(slot_function<int>);
+
+    int_emitter.generic_emit(5);
+    EXPECT_EQ(wheel.size(), 1);
+
+    advance_to(10ms);
+    EXPECT_EQ(count, 2);
+}
+
+TEST_F(test_rate_limiting, sources_share_the_wheel)
+{
+    int& count = call_count<int>;
+    reset<int>();
+
+    auto debounced { int_emitter.generic_signal | debounce(10ms, wheel) };
+    auto other_debounced { other_int_emitter.generic_signal | debounce(20ms, wheel) };
+    auto throttled { int_emitter.generic_signal | throttle(10ms, wheel, throttle_edge::trailing) };
+    debounced.connect(slot_function<int>);
+    other_debounced.connect(slot_function<int>);
+    throttled.connect(slot_function<int>);
+
+    int_emitter.generic_emit(5);
+    other_int_emitter.generic_emit(6);
+    EXPECT_EQ(wheel.size(), 3);
+
+    EXPECT_EQ(advance_to(10ms), 2);
+    EXPECT_EQ(count, 2);
+
+    EXPECT_EQ(advance_to(20ms), 1);
+    EXPECT_EQ(count, 3);
+    EXPECT_EQ(call_args<int>.back(), 6);
+}
+
+TEST_F(test_rate_limiting, chained_transformation)
+{
+    std::vector<int> values;
+
+    int_emitter.generic_signal | filter([](int value) { return value % 2 == 0; }) |
+        debounce(10ms, wheel) | transform([](int value) { return value * 10; }) |
+        connect([&values](int value) { values.emplace_back(value); });
+
+    int_emitter.generic_emit(2);
+    int_emitter.generic_emit(3);
+    advance_to(10ms);
+    EXPECT_EQ(values, std::vector<int> { 20 });
+}
+
+TEST_F(test_rate_limiting, concurrent_emissions)
+{
+    std::vector<int> values;
+
+    auto debounced { safe_int_emitter.generic_signal | debounce(10ms, safe_wheel) };
+    debounced.connect([&values](int value) { values.emplace_back(value); });
+
+    std::vector<std::thread> threads;
+    for (int i { 0 }; i < 4; ++i)
+    {
+        threads.emplace_back(
+            [this]
+            {
+                for (int j { 0 }; j < 100; ++j)
+                {
+                    safe_int_emitter.generic_emit(j);
+                }
+            });
+    }
+
+    for (auto& thread: threads)
+    {
+        thread.join();
+    }
+
+    now = manual_clock::time_point { 10ms };
+    std::thread advancing_thread { [this] { safe_wheel.advance(); } };
+    advancing_thread.join();
+
+    EXPECT_EQ(values, std::vector<int> { 99 });
+}
@@ -0,0 +1,215 @@
+#include "stimulus.h"
+
+#include <atomic>
+#include <exception>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "utilities.h"
+
+class test_rebind: public ::testing::Test
+{
+protected:
+    generic_emitter<int> int_emitter;
+    safe_generic_emitter<int> safe_int_emitter;
+
+    std::vector<std::string> calls;
+
+    auto store_call(std::string name)
+    {
+        return [this, name = std::move(name)](int value)
+        { calls.emplace_back(name + std::to_string(value)); };
+    }
+};
+
+TEST_F(test_rebind, replaces_the_slot)
+{
+    auto connection { int_emitter.generic_signal.connect(store_call("old")) };
+    int_emitter.generic_emit(1);
+
+    EXPECT_TRUE(connection.rebind<int>(store_call("new")));
+    int_emitter.generic_emit(2);
+
+    EXPECT_EQ(calls, (std::vector<std::string> { "old1", "new2" }));
+    EXPECT_EQ(int_emitter.generic_signal.slot_count(), 1);
+}
+
+TEST_F(test_rebind, keeps_order)
+{
+    int_emitter.generic_signal.connect(store_call("a"));
+    auto connection { int_emitter.generic_signal.connect(store_call("b")) };
+    int_emitter.generic_signal.connect(store_call("c"));
+
+    connection.rebind<int>(store_call("d"));
+    int_emitter.generic_emit(1);
+
+    EXPECT_EQ(calls, (std::vector<std::string> { "a1", "d1", "c1" }));
+}
+
+TEST_F(test_rebind, keeps_guard)
+{
+    {
+        basic_receiver receiver;
+        auto connection { int_emitter.generic_signal.connect(store_call("a"), receiver) };
+        connection.rebind<int>(store_call("b"));
+        int_emitter.generic_emit(1);
+    }
+
+    int_emitter.generic_emit(2);
+    EXPECT_EQ(calls, std::vector<std::string> { "b1" });
+    EXPECT_EQ(int_emitter.generic_signal.slot_count(), 0);
+}
+
+TEST_F(test_rebind, keeps_exception_handlers)
+{
+    int caught { 0 };
+
+    auto connection { int_emitter.generic_signal.connect(store_call("a")) };
+    connection.add_exception_handler([&caught](const std::exception_ptr&) { ++caught; });
+    connection.rebind<int>([](int) { throw std::runtime_error { "rebound" }; });
+
+    EXPECT_NO_THROW(int_emitter.generic_emit(1));
+    EXPECT_EQ(caught, 1);
+}
+
+TEST_F(test_rebind, keeps_suspension)
+{
+    auto connection { int_emitter.generic_signal.connect(store_call("a")) };
+    connection.suspend();
+    connection.rebind<int>(store_call("b"));
+
+    int_emitter.generic_emit(1);
+    connection.resume();
+    int_emitter.generic_emit(2);
+
+    EXPECT_EQ(calls, std::vector<std::string> { "b2" });
+}
+
+TEST_F(test_rebind, replaces_transformations)
+{
+    auto connection { int_emitter.generic_signal | filter([](int value) { return value > 5; }) |
+                      connect(store_call("a")) };
+    connection.rebind<int>(store_call("b"));
+
+    int_emitter.generic_emit(1);
+    EXPECT_EQ(calls, std::vector<std::string> { "b1" });
+}
+
+TEST_F(test_rebind, partial_arguments)
+{
+    int& count = call_count<>;
+    reset<>();
+
+    auto connection { int_emitter.generic_signal.connect(store_call("a")) };
+    connection.rebind<int>(slot_function<>);
+
+    int_emitter.generic_emit(1);
+    EXPECT_EQ(count, 1);
+    EXPECT_TRUE(calls.empty());
+}
+
+TEST_F(test_rebind, rebind_during_call)
+{
+    std::string captured { "long enough not to fit in a small string buffer" };
+    std::vector<std::string> seen;
+
+    auto connection { int_emitter.generic_signal.connect(store_call("a")) };
+    connection.rebind<int>(
+        [&connection, &seen, captured](int)
+        {
+            // The running slot is kept alive until its call returns.
+            connection.rebind<int>([](int) {});
+            seen.emplace_back(captured);
+        });
+
+    int_emitter.generic_emit(1);
+    int_emitter.generic_emit(2);
+    EXPECT_EQ(seen, std::vector<std::string> { captured });
+}
+
+TEST_F(test_rebind, pending_calls)
+{
+    task_queue_policy policy;
+
+    auto connection { int_emitter.generic_signal.connect(store_call("a"), policy) };
+    int_emitter.generic_emit(1);
+    connection.rebind<int>(store_call("b"));
+
+    // Calls that didn't start yet get the new slot.
+    policy.run_all();
+    EXPECT_EQ(calls, std::vector<std::string> { "b1" });
+}
+
+TEST_F(test_rebind, mismatching_arguments)
+{
+    auto connection { int_emitter.generic_signal.connect(store_call("a")) };
+
+    EXPECT_THROW(connection.rebind<std::string>([](const std::string&) {}),
+                 std::invalid_argument);
+    EXPECT_THROW(connection.rebind<>([] {}), std::invalid_argument);
+
+    int_emitter.generic_emit(1);
+    EXPECT_EQ(calls, std::vector<std::string> { "a1" });
+}
+
+TEST_F(test_rebind, disconnected)
+{
+    auto connection { int_emitter.generic_signal.connect(store_call("a")) };
+    connection.disconnect();
+
+    EXPECT_FALSE(connection.rebind<int>(store_call("b")));
+}
+
+TEST_F(test_rebind, concurrent_emissions)
+{
+    std::atomic<int> first_count { 0 };
+    std::atomic<int> second_count { 0 };
+
+    auto count_first { [&first_count](int) { ++first_count; } };
+    auto count_second { [&second_count](int) { ++second_count; } };
+    auto connection { safe_int_emitter.generic_signal.connect(count_first) };
+
+    std::atomic<bool> done { false };
+    std::thread rebinding_thread {
+        [&]
+        {
+            for (int i { 0 }; !done; ++i)
+            {
+                if (i % 2 == 0)
+                {
+                    connection.rebind<int>(count_second);
+                }
+                else
+                {
+                    connection.rebind<int>(count_first);
+                }
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (int i { 0 }; i < 4; ++i)
+    {
+        threads.emplace_back(
+            [this]
+            {
+                for (int j { 0 }; j < 100; ++j)
+                {
+                    safe_int_emitter.generic_emit(j);
+                }
+            });
+    }
+
+    for (auto& thread: threads)
+    {
+        thread.join();
+    }
+    done = true;
+    rebinding_thread.join();
+
+    EXPECT_EQ(first_count + second_count, 400);
+}
@@ -0,0 +1,241 @@
+#include "stimulus.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "utilities.h"
+
+class test_scan: public ::testing::Test
+{
+protected:
+    struct volume_weighted_price
+    {
+        double notional { 0.0 };
+        double volume { 0.0 };
+
+        auto price() const -> double
+        {
+            return volume == 0.0 ? 0.0 : notional / volume;
+        }
+    };
+
+    generic_emitter<int> int_emitter;
+    generic_emitter<double, double> trade_emitter;
+    safe_generic_emitter<int> safe_int_emitter;
+
+    static auto sum()
+    {
+        return scan(0, [](int total, int value) { return total + value; });
+    }
+};
+
+TEST_F(test_scan, running_sum)
+{
+    std::vector<int> values;
+
+    int_emitter.generic_signal | sum() |
+        connect([&values](int total) { values.emplace_back(total); });
+
+    for (int i { 1 }; i <= 4; ++i)
+    {
+        int_emitter.generic_emit(i);
+    }
+
+    EXPECT_EQ(values, (std::vector<int> { 1, 3, 6, 10 }));
+}
+
+TEST_F(test_scan, in_place_update)
+{
+    std::vector<double> prices;
+
+    trade_emitter.generic_signal |
+        scan(volume_weighted_price {},
+             [](volume_weighted_price& accumulated, double price, double volume)
+             {
+                 accumulated.notional += price * volume;
+                 accumulated.volume += volume;
+             }) |
+        connect([&prices](const volume_weighted_price& accumulated)
+                { prices.emplace_back(accumulated.price()); });
+
+    trade_emitter.generic_emit(10.0, 1.0);
+    trade_emitter.generic_emit(20.0, 3.0);
+
+    EXPECT_EQ(prices, (std::vector<double> { 10.0, 17.5 }));
+}
+
+TEST_F(test_scan, partial_arguments)
+{
+    int& count = call_count<int>;
+    reset<int>();
+
+    int_emitter.generic_signal | scan(0, [](int emissions) { return emissions + 1; }) |
+        connect(slot_function<int>);
+
+    int_emitter.generic_emit(5);
+    int_emitter.generic_emit(5);
+    EXPECT_EQ(count, 2);
+    EXPECT_EQ(call_args<int>.back(), 2);
+}
+
+TEST_F(test_scan, per_connection_state)
+{
+    std::vector<int> first;
+    std::vector<int> second;
+
+    auto totals { int_emitter.generic_signal | sum() };
+    totals.connect([&first](int total) { first.emplace_back(total); });
+
+    int_emitter.generic_emit(1);
+    int_emitter.generic_emit(2);
+    totals.connect([&second](int total) { second.emplace_back(total); });
+    int_emitter.generic_emit(3);
+
+    EXPECT_EQ(first, (std::vector<int> { 1, 3, 6 }));
+    EXPECT_EQ(second, std::vector<int> { 3 });
+}
+
+TEST_F(test_scan, shared_state)
+{
+    std::vector<int> first;
+    std::vector<int> second;
+    int calls { 0 };
+
+    auto counted_sum { [&calls](int total, int value)
+                       {
+                           ++calls;
+                           return total + value;
+                       } };
+    auto totals { int_emitter.generic_signal | scan<scan_state::shared>(0, counted_sum) };
+    totals.connect([&first](int total) { first.emplace_back(total); });
+
+    int_emitter.generic_emit(1);
+    int_emitter.generic_emit(2);
+    totals.connect([&second](int total) { second.emplace_back(total); });
+    int_emitter.generic_emit(3);
+
+    EXPECT_EQ(first, (std::vector<int> { 1, 3, 6 }));
+    EXPECT_EQ(second, std::vector<int> { 6 });
+    EXPECT_EQ(calls, 3);
+}
+
+TEST_F(test_scan, chained_transformation)
+{
+    int& count = call_count<std::string>;
+    reset<std::string>();
+
+    int_emitter.generic_signal | sum() |
+        transform([](int total) { return std::to_string(total); }) |
+        connect(slot_function<std::string>);
+
+    int_emitter.generic_emit(4);
+    int_emitter.generic_emit(5);
+    EXPECT_EQ(count, 2);
+    EXPECT_EQ(call_args<std::string>.back(), "9");
+}
+
+TEST_F(test_scan, concurrent_emissions)
+{
+    std::atomic<int> calls { 0 };
+    std::atomic<int> maximum { 0 };
+
+    safe_int_emitter.generic_signal | sum() |
+        connect(
+            [&calls, &maximum](int total)
+            {
+                ++calls;
+                int current { maximum.load() };
+                while (current < total && !maximum.compare_exchange_weak(current, total))
+                {
+                }
+            });
+
+    std::vector<std::thread> threads;
+    for (int i { 0 }; i < 4; ++i)
+    {
+        threads.emplace_back(
+            [this]
+            {
+                for (int j { 0 }; j < 100; ++j)
+                {
+                    safe_int_emitter.generic_emit(1);
+                }
+            });
+    }
+
+    for (auto& thread: threads)
+    {
+        thread.join();
+    }
+
+    EXPECT_EQ(calls, 400);
+    EXPECT_EQ(maximum, 400);
+}
+
+TEST_F(test_scan, concurrent_emissions_get_every_total)
+{
+    std::mutex totals_mutex;
+    std::vector<int> totals;
+
+    safe_int_emitter.generic_signal |
+        scan<scan_state::shared>(0, [](int& total, int value) { total += value; }) |
+        connect(
+            [&](int total)
+            {
+                std::lock_guard lock { totals_mutex };
+                totals.emplace_back(total);
+            });
+
+    std::vector<std::thread> threads;
+    for (int i { 0 }; i < 4; ++i)
+    {
+        threads.emplace_back(
+            [this]
+            {
+                for (int j { 0 }; j < 100; ++j)
+                {
+                    safe_int_emitter.generic_emit(1);
+                }
+            });
+    }
+
+    for (auto& thread: threads)
+    {
+        thread.join();
+    }
+
+    // The slots may be called out of order, but each one gets the total of its own update.
+    std::ranges::sort(totals);
+    ASSERT_EQ(totals.size(), 400);
+    for (std::size_t i { 0 }; i < totals.size(); ++i)
+    {
+        EXPECT_EQ(totals[i], static_cast<int>(i) + 1);
+    }
+}
+
+TEST_F(test_scan, emission_from_a_slot)
+{
+    std::vector<int> totals;
+
+    safe_int_emitter.generic_signal | sum() |
+        connect(
+            [&](int total)
+            {
+                totals.emplace_back(total);
+                if (total == 1)
+                {
+                    safe_int_emitter.generic_emit(2);
+                }
+            });
+
+    safe_int_emitter.generic_emit(1);
+
+    EXPECT_EQ(totals, (std::vector<int> { 1, 3 }));
+}
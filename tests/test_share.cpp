@@ -0,0 +1,238 @@
+#include "stimulus.h"
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "utilities.h"
+
+class test_share: public ::testing::Test
+{
+protected:
+    generic_emitter<int> int_emitter;
+    safe_generic_emitter<int> safe_int_emitter;
+
+    int transformations { 0 };
+
+    auto counting_to_string()
+    {
+        return transform(
+            [this](int value)
+            {
+                ++transformations;
+                return std::to_string(value);
+            });
+    }
+};
+
+TEST_F(test_share, transformation_runs_once)
+{
+    std::vector<std::string> values;
+
+    auto shared { int_emitter.generic_signal | counting_to_string() | share() };
+    for (int i { 0 }; i < 30; ++i)
+    {
+        shared.connect([&values](const std::string& value) { values.emplace_back(value); });
+    }
+
+    int_emitter.generic_emit(5);
+    EXPECT_EQ(transformations, 1);
+    ASSERT_EQ(values.size(), 30);
+    for (const auto& value: values)
+    {
+        EXPECT_EQ(value, "5");
+    }
+}
+
+TEST_F(test_share, unshared_transformation_runs_for_each_connection)
+{
+    auto transformed { int_emitter.generic_signal | counting_to_string() };
+    for (int i { 0 }; i < 30; ++i)
+    {
+        transformed.connect([](const std::string&) {});
+    }
+
+    int_emitter.generic_emit(5);
+    EXPECT_EQ(transformations, 30);
+}
+
+TEST_F(test_share, upstream_connection_follows_connections)
+{
+    auto shared { int_emitter.generic_signal | counting_to_string() | share() };
+    EXPECT_EQ(int_emitter.generic_signal.slot_count(), 0);
+
+    auto first { shared.connect([](const std::string&) {}) };
+    auto second { shared.connect([](const std::string&) {}) };
+    EXPECT_EQ(int_emitter.generic_signal.slot_count(), 1);
+
+    first.disconnect();
+    EXPECT_EQ(int_emitter.generic_signal.slot_count(), 1);
+
+    second.disconnect();
+    EXPECT_EQ(int_emitter.generic_signal.slot_count(), 0);
+
+    int_emitter.generic_emit(5);
+    EXPECT_EQ(transformations, 0);
+}
+
+TEST_F(test_share, reconnection)
+{
+    int& count = call_count<std::string>;
+    reset<std::string>();
+
+    auto shared { int_emitter.generic_signal | counting_to_string() | share() };
+
+    shared.connect(slot_function<std::string>).disconnect();
+    shared.connect(slot_function<std::string>);
+    EXPECT_EQ(int_emitter.generic_signal.slot_count(), 1);
+
+    int_emitter.generic_emit(5);
+    EXPECT_EQ(count, 1);
+    EXPECT_EQ(call_args<std::string>.back(), "5");
+}
+
+TEST_F(test_share, suspended_connections_keep_upstream)
+{
+    auto shared { int_emitter.generic_signal | counting_to_string() | share() };
+
+    auto connection { shared.connect([](const std::string&) {}) };
+    connection.suspend();
+    EXPECT_EQ(int_emitter.generic_signal.slot_count(), 1);
+
+    connection.resume();
+    int_emitter.generic_emit(5);
+    EXPECT_EQ(transformations, 1);
+}
+
+TEST_F(test_share, connect_once)
+{
+    int& count = call_count<std::string>;
+    reset<std::string>();
+
+    auto shared { int_emitter.generic_signal | counting_to_string() | share() };
+    shared.connect_once(slot_function<std::string>);
+
+    int_emitter.generic_emit(5);
+    int_emitter.generic_emit(6);
+    EXPECT_EQ(count, 1);
+    EXPECT_EQ(transformations, 1);
+    EXPECT_EQ(int_emitter.generic_signal.slot_count(), 0);
+}
+
+TEST_F(test_share, filter)
+{
+    int& count = call_count<int>;
+    reset<int>();
+
+    int filters { 0 };
+    auto is_even { [&filters](int value)
+    {
+        ++filters;
+        return value % 2 == 0;
+    } };
+
+    auto shared { int_emitter.generic_signal | ::filter(is_even) | share() };
+    shared.connect(slot_function<int>);
+    shared.connect(slot_function<int>);
+
+    int_emitter.generic_emit(5);
+    int_emitter.generic_emit(6);
+    EXPECT_EQ(filters, 2);
+    EXPECT_EQ(count, 2);
+    EXPECT_EQ(call_args<int>.back(), 6);
+}
+
+TEST_F(test_share, copies_share_the_stage)
+{
+    auto shared { int_emitter.generic_signal | counting_to_string() | share() };
+    auto copy { shared };
+
+    shared.connect([](const std::string&) {});
+    copy.connect([](const std::string&) {});
+    EXPECT_EQ(int_emitter.generic_signal.slot_count(), 1);
+
+    int_emitter.generic_emit(5);
+    EXPECT_EQ(transformations, 1);
+}
+
+TEST_F(test_share, temporary_shared_source)
+{
+    int& count = call_count<std::string>;
+    reset<std::string>();
+
+    // The upstream connection keeps the stage alive.
+    auto connection { int_emitter.generic_signal | counting_to_string() | share() |
+                      connect(slot_function<std::string>) };
+
+    int_emitter.generic_emit(5);
+    EXPECT_EQ(count, 1);
+    EXPECT_EQ(call_args<std::string>.back(), "5");
+
+    connection.disconnect();
+    EXPECT_EQ(int_emitter.generic_signal.slot_count(), 0);
+}
+
+TEST_F(test_share, chained_after_share)
+{
+    int& count = call_count<std::string>;
+    reset<std::string>();
+
+    auto shared { int_emitter.generic_signal | counting_to_string() | share() };
+    shared | transform([](const std::string& value) { return value + "!"; }) |
+        connect(slot_function<std::string>);
+    shared.connect(slot_function<std::string>);
+
+    int_emitter.generic_emit(5);
+    EXPECT_EQ(transformations, 1);
+    EXPECT_EQ(count, 2);
+    EXPECT_EQ(call_args<std::string>.front(), "5!");
+    EXPECT_EQ(call_args<std::string>.back(), "5");
+}
+
+TEST_F(test_share, guard_destruction)
+{
+    auto shared { int_emitter.generic_signal | counting_to_string() | share() };
+
+    {
+        basic_receiver receiver;
+        std::vector<std::string> values;
+        shared.connect([&values](const std::string& value) { values.emplace_back(value); },
+                       receiver);
+        EXPECT_EQ(int_emitter.generic_signal.slot_count(), 1);
+
+        int_emitter.generic_emit(5);
+        EXPECT_EQ(values, std::vector<std::string> { "5" });
+    }
+
+    EXPECT_EQ(int_emitter.generic_signal.slot_count(), 0);
+}
+
+TEST_F(test_share, concurrent_connections)
+{
+    auto shared { safe_int_emitter.generic_signal |
+                  transform([](int value) { return std::to_string(value); }) | share() };
+
+    std::vector<std::thread> threads;
+    for (int i { 0 }; i < 4; ++i)
+    {
+        threads.emplace_back(
+            [&shared, this]
+            {
+                for (int j { 0 }; j < 100; ++j)
+                {
+                    auto connection { shared.connect([](const std::string&) {}) };
+                    safe_int_emitter.generic_emit(j);
+                    connection.disconnect();
+                }
+            });
+    }
+
+    for (auto& thread: threads)
+    {
+        thread.join();
+    }
+
+    EXPECT_EQ(safe_int_emitter.generic_signal.slot_count(), 0);
+}
@@ -0,0 +1,160 @@
+#include "stimulus.h"
+
+#include <gtest/gtest.h>
+
+#include "utilities.h"
+
+class test_signal_blocking: public ::testing::Test
+{
+protected:
+    generic_emitter<int> int_emitter;
+    safe_generic_emitter<int> safe_int_emitter;
+};
+
+TEST_F(test_signal_blocking, block_emitter)
+{
+    int& count = call_count<int>;
+    reset<int>();
+
+    int_emitter.generic_signal.connect(slot_function<int>);
+
+    int_emitter.block_signals();
+    EXPECT_TRUE(int_emitter.signals_blocked());
+    int_emitter.generic_emit(5);
+    EXPECT_EQ(count, 0);
+
+    int_emitter.unblock_signals();
+    EXPECT_FALSE(int_emitter.signals_blocked());
+    int_emitter.generic_emit(6);
+    EXPECT_EQ(count, 1);
+    EXPECT_EQ(call_args<int>.back(), 6);
+}
+
+TEST_F(test_signal_blocking, block_emitter_nests)
+{
+    int& count = call_count<int>;
+    reset<int>();
+
+    safe_int_emitter.generic_signal.connect(slot_function<int>);
+
+    safe_int_emitter.block_signals();
+    safe_int_emitter.block_signals();
+    safe_int_emitter.unblock_signals();
+    safe_int_emitter.generic_emit(5);
+    EXPECT_EQ(count, 0);
+
+    safe_int_emitter.unblock_signals();
+    // Unbalanced calls are ignored.
+    safe_int_emitter.unblock_signals();
+    safe_int_emitter.generic_emit(6);
+    EXPECT_EQ(count, 1);
+
+    safe_int_emitter.block_signals();
+    safe_int_emitter.generic_emit(7);
+    EXPECT_EQ(count, 1);
+}
+
+TEST_F(test_signal_blocking, block_signal)
+{
+    int& count = call_count<int>;
+    reset<int>();
+
+    EXPECT_FALSE(int_emitter.generic_signal.blocked());
+    int_emitter.generic_signal.block();
+    EXPECT_TRUE(int_emitter.generic_signal.blocked());
+
+    // Blocking outlives connections.
+    auto connection { int_emitter.generic_signal.connect(slot_function<int>) };
+    int_emitter.generic_emit(5);
+    EXPECT_EQ(count, 0);
+
+    int_emitter.generic_signal.unblock();
+    int_emitter.generic_emit(6);
+    EXPECT_EQ(count, 1);
+    EXPECT_EQ(call_args<int>.back(), 6);
+}
+
+TEST_F(test_signal_blocking, unblock_unconnected_signal)
+{
+    int_emitter.generic_signal.unblock();
+    EXPECT_FALSE(int_emitter.generic_signal.blocked());
+    EXPECT_EQ(int_emitter.generic_signal.suppressed_emissions(), 0);
+}
+
+TEST_F(test_signal_blocking, scoped_blocker)
+{
+    int& count = call_count<int>;
+    reset<int>();
+
+    int_emitter.generic_signal.connect(slot_function<int>);
+
+    {
+        scoped_blocker emitter_blocker { int_emitter };
+        int_emitter.generic_emit(5);
+    }
+    {
+        scoped_blocker signal_blocker { int_emitter.generic_signal };
+        int_emitter.generic_emit(6);
+    }
+    EXPECT_EQ(count, 0);
+
+    int_emitter.generic_emit(7);
+    EXPECT_EQ(count, 1);
+    EXPECT_EQ(call_args<int>.back(), 7);
+}
+
+TEST_F(test_signal_blocking, suppressed_emissions)
+{
+    int_emitter.generic_signal.connect(slot_function<int>);
+
+    {
+        scoped_blocker blocker { int_emitter };
+        int_emitter.generic_emit(5);
+        int_emitter.generic_emit(6);
+    }
+    {
+        scoped_blocker blocker { int_emitter.generic_signal };
+        int_emitter.generic_emit(7);
+    }
+    int_emitter.generic_emit(8);
+
+    EXPECT_EQ(int_emitter.suppressed_emissions(), 2);
+    EXPECT_EQ(int_emitter.generic_signal.suppressed_emissions(), 1);
+}
+
+TEST_F(test_signal_blocking, forwarded_emissions_are_blocked)
+{
+    int& count = call_count<int>;
+    reset<int>();
+
+    forwarding_emitter<int> forwarder;
+    forwarder.forward_from(int_emitter);
+    forwarder.forwarded_signal.connect(slot_function<int>);
+
+    forwarder.block_signals();
+    int_emitter.generic_emit(5);
+    EXPECT_EQ(count, 0);
+    EXPECT_EQ(forwarder.suppressed_emissions(), 1);
+
+    forwarder.unblock_signals();
+    int_emitter.generic_emit(6);
+    EXPECT_EQ(count, 1);
+    EXPECT_EQ(call_args<int>.back(), 6);
+}
+
+TEST_F(test_signal_blocking, copied_emitter_is_not_blocked)
+{
+    int& count = call_count<int>;
+    reset<int>();
+
+    int_emitter.block_signals();
+    int_emitter.generic_emit(5);
+
+    auto copy { int_emitter };
+    copy.generic_signal.connect(slot_function<int>);
+    copy.generic_emit(6);
+
+    EXPECT_FALSE(copy.signals_blocked());
+    EXPECT_EQ(copy.suppressed_emissions(), 0);
+    EXPECT_EQ(count, 1);
+}
@@ -0,0 +1,312 @@
+#include "stimulus.h"
+
+#include <array>
+#include <optional>
+#include <span>
+#include <string>
+#include <utility>
+
+#include <gtest/gtest.h>
+#include <vector>
+
+#include "utilities.h"
+
+class test_slot_results: public ::testing::Test
+{
+protected:
+    struct result_emitter: public basic_emitter
+    {
+        signal<int(int)> int_signal;
+        signal<bool(const std::string&)> string_signal;
+        signal<std::optional<int>(int)> optional_signal;
+
+        template<class Combiner>
+        auto emit_int(Combiner&& combiner, int value)
+        {
+            return emit(&result_emitter::int_signal, std::forward<Combiner>(combiner), value);
+        }
+
+        template<class Combiner>
+        auto emit_string(Combiner&& combiner, const std::string& value)
+        {
+            return emit(&result_emitter::string_signal, std::forward<Combiner>(combiner), value);
+        }
+
+        template<class Combiner>
+        auto emit_optional(Combiner&& combiner, int value)
+        {
+            return emit(&result_emitter::optional_signal, std::forward<Combiner>(combiner), value);
+        }
+
+        void emit_int_discarding(int value)
+        {
+            emit(&result_emitter::int_signal, value);
+        }
+    };
+
+    struct safe_result_emitter: public safe_emitter
+    {
+        signal<int(int)> int_signal;
+
+        template<class Combiner>
+        auto emit_int(Combiner&& combiner, int value)
+        {
+            return emit(&safe_result_emitter::int_signal, std::forward<Combiner>(combiner), value);
+        }
+    };
+
+    struct multiplier: public basic_receiver
+    {
+        auto multiply(int value) const -> int
+        {
+            return value * factor;
+        }
+
+        int factor { 3 };
+    };
+
+    result_emitter int_emitter;
+    safe_result_emitter safe_int_emitter;
+};
+
+TEST_F(test_slot_results, sum)
+{
+    int_emitter.int_signal.connect([](int value) { return value; });
+    int_emitter.int_signal.connect([](int value) { return value * 2; });
+    safe_int_emitter.int_signal.connect([](int value) { return value + 1; });
+    safe_int_emitter.int_signal.connect([](int value) { return value + 2; });
+
+    EXPECT_EQ(int_emitter.emit_int(combiners::sum<int> {}, 5), 15);
+    EXPECT_EQ(safe_int_emitter.emit_int(combiners::sum<int> {}, 5), 13);
+}
+
+TEST_F(test_slot_results, minimum_and_maximum)
+{
+    EXPECT_EQ(int_emitter.emit_int(combiners::minimum<int> {}, 5), std::nullopt);
+    EXPECT_EQ(int_emitter.emit_int(combiners::maximum<int> {}, 5), std::nullopt);
+
+    int_emitter.int_signal.connect([](int value) { return value; });
+    int_emitter.int_signal.connect([](int value) { return -value; });
+    int_emitter.int_signal.connect([](int value) { return value * 2; });
+
+    EXPECT_EQ(int_emitter.emit_int(combiners::minimum<int> {}, 5), -5);
+    EXPECT_EQ(int_emitter.emit_int(combiners::maximum<int> {}, 5), 10);
+}
+
+TEST_F(test_slot_results, first_non_empty_stops_emission)
+{
+    int calls { 0 };
+
+    int_emitter.optional_signal.connect(
+        [&calls](int) -> std::optional<int>
+        {
+            ++calls;
+            return std::nullopt;
+        });
+    int_emitter.optional_signal.connect(
+        [&calls](int value) -> std::optional<int>
+        {
+            ++calls;
+            return value;
+        });
+    int_emitter.optional_signal.connect(
+        [&calls](int value) -> std::optional<int>
+        {
+            ++calls;
+            return value * 2;
+        });
+
+    EXPECT_EQ(int_emitter.emit_optional(combiners::first_non_empty<std::optional<int>> {}, 5), 5);
+    EXPECT_EQ(calls, 2);
+}
+
+TEST_F(test_slot_results, connections_after_done_are_not_visited)
+{
+    task_queue_policy policy;
+
+    int_emitter.optional_signal.connect([](int value) -> std::optional<int> { return value; });
+    // Its result would be dropped, but reaching it would still queue a call.
+    int_emitter.optional_signal.connect([](int) -> std::optional<int> { return 0; }, policy);
+
+    EXPECT_EQ(int_emitter.emit_optional(combiners::first_non_empty<std::optional<int>> {}, 5), 5);
+    EXPECT_EQ(policy.size(), 0);
+}
+
+TEST_F(test_slot_results, all_of_and_any_of)
+{
+    std::vector<std::string> calls;
+
+    EXPECT_TRUE(int_emitter.emit_string(combiners::all_of {}, "value"));
+    EXPECT_FALSE(int_emitter.emit_string(combiners::any_of {}, "value"));
+
+    int_emitter.string_signal.connect(
+        [&calls](const std::string& value)
+        {
+            calls.emplace_back("first");
+            return !value.empty();
+        });
+    int_emitter.string_signal.connect(
+        [&calls](const std::string& value)
+        {
+            calls.emplace_back("second");
+            return value.size() < 3;
+        });
+    int_emitter.string_signal.connect(
+        [&calls](const std::string&)
+        {
+            calls.emplace_back("third");
+            return true;
+        });
+
+    EXPECT_FALSE(int_emitter.emit_string(combiners::all_of {}, "value"));
+    EXPECT_EQ(calls, (std::vector<std::string> { "first", "second" }));
+
+    calls.clear();
+    EXPECT_TRUE(int_emitter.emit_string(combiners::any_of {}, "value"));
+    EXPECT_EQ(calls, (std::vector<std::string> { "first" }));
+}
+
+TEST_F(test_slot_results, collect)
+{
+    std::array<int, 4> buffer {};
+
+    int_emitter.int_signal.connect([](int value) { return value; });
+    int_emitter.int_signal.connect([](int value) { return value + 1; });
+
+    auto results { int_emitter.emit_int(combiners::collect<int> { buffer }, 5) };
+    ASSERT_EQ(results.size(), 2);
+    EXPECT_EQ(results.data(), buffer.data());
+    EXPECT_EQ(results[0], 5);
+    EXPECT_EQ(results[1], 6);
+}
+
+TEST_F(test_slot_results, collect_stops_when_full)
+{
+    int calls { 0 };
+    std::array<int, 2> buffer {};
+
+    for (int i { 0 }; i < 5; ++i)
+    {
+        int_emitter.int_signal.connect(
+            [&calls, i](int value)
+            {
+                ++calls;
+                return value + i;
+            });
+    }
+
+    auto results { int_emitter.emit_int(combiners::collect<int> { buffer }, 5) };
+    ASSERT_EQ(results.size(), 2);
+    EXPECT_EQ(results[0], 5);
+    EXPECT_EQ(results[1], 6);
+    EXPECT_EQ(calls, 2);
+}
+
+TEST_F(test_slot_results, partial_arguments)
+{
+    int_emitter.int_signal.connect([] { return 7; });
+    int_emitter.int_signal.connect([](int value) { return value; });
+
+    EXPECT_EQ(int_emitter.emit_int(combiners::sum<int> {}, 5), 12);
+}
+
+TEST_F(test_slot_results, member_function)
+{
+    multiplier receiver;
+
+    int_emitter.int_signal.connect(&multiplier::multiply, receiver);
+    int_emitter.int_signal.connect_once(&multiplier::multiply, receiver);
+
+    EXPECT_EQ(int_emitter.emit_int(combiners::sum<int> {}, 5), 30);
+    EXPECT_EQ(int_emitter.emit_int(combiners::sum<int> {}, 5), 15);
+}
+
+TEST_F(test_slot_results, emit_without_combiner)
+{
+    int calls { 0 };
+
+    int_emitter.int_signal.connect(
+        [&calls](int value)
+        {
+            ++calls;
+            return value;
+        });
+
+    int_emitter.emit_int_discarding(5);
+    EXPECT_EQ(calls, 1);
+}
+
+TEST_F(test_slot_results, nested_emission)
+{
+    std::array<int, 4> buffer {};
+
+    int_emitter.int_signal.connect(
+        [this](int value)
+        {
+            // Results of nested emissions don't reach the outer combiner.
+            if (value > 0)
+            {
+                int_emitter.emit_int_discarding(value - 1);
+                EXPECT_EQ(int_emitter.emit_int(combiners::sum<int> {}, 0), 0);
+            }
+
+            return value;
+        });
+
+    auto results { int_emitter.emit_int(combiners::collect<int> { buffer }, 5) };
+    ASSERT_EQ(results.size(), 1);
+    EXPECT_EQ(results[0], 5);
+}
+
+TEST_F(test_slot_results, asynchronous_results_are_dropped)
+{
+    task_queue_policy policy;
+
+    int_emitter.int_signal.connect([](int value) { return value; }, policy);
+    int_emitter.int_signal.connect([](int value) { return value * 2; });
+
+    EXPECT_EQ(int_emitter.emit_int(combiners::sum<int> {}, 5), 10);
+    EXPECT_EQ(policy.size(), 1);
+
+    // Even when run during another emission.
+    int_emitter.int_signal.connect(
+        [&policy](int)
+        {
+            policy.run_all();
+            return 0;
+        });
+    EXPECT_EQ(int_emitter.emit_int(combiners::sum<int> {}, 5), 10);
+}
+
+TEST_F(test_slot_results, blocked_signal)
+{
+    int_emitter.int_signal.connect([](int value) { return value; });
+
+    int_emitter.int_signal.block();
+    EXPECT_EQ(int_emitter.emit_int(combiners::sum<int> {}, 5), 0);
+    EXPECT_EQ(int_emitter.int_signal.suppressed_emissions(), 1);
+
+    int_emitter.int_signal.unblock();
+    int_emitter.block_signals();
+    EXPECT_EQ(int_emitter.emit_int(combiners::maximum<int> {}, 5), std::nullopt);
+
+    int_emitter.unblock_signals();
+    EXPECT_EQ(int_emitter.emit_int(combiners::sum<int> {}, 5), 5);
+}
+
+TEST_F(test_slot_results, suspended_and_disconnected_connections)
+{
+    auto connection { int_emitter.int_signal.connect([](int value) { return value; }) };
+    int_emitter.int_signal.connect([](int value) { return value * 2; });
+    EXPECT_EQ(int_emitter.int_signal.slot_count(), 2);
+
+    connection.suspend();
+    EXPECT_EQ(int_emitter.emit_int(combiners::sum<int> {}, 5), 10);
+
+    connection.resume();
+    EXPECT_EQ(int_emitter.emit_int(combiners::sum<int> {}, 5), 15);
+
+    connection.disconnect();
+    EXPECT_EQ(int_emitter.emit_int(combiners::sum<int> {}, 5), 10);
+    EXPECT_EQ(int_emitter.int_signal.slot_count(), 1);
+}
@@ -2,6 +2,7 @@
 
 #include <gtest/gtest.h>
 #include <thread>
+#include <vector>
 
 #include "utilities.h"
 
@@ -90,6 +91,33 @@ TEST_F(test_threads, disconnect_during_emit)
     // Ensure no crash
 }
 
+TEST_F(test_threads, connections_outlive_their_thread)
+{
+    int& count = call_count<>;
+    reset<>();
+
+    std::vector<connection<std::shared_ptr>> connections;
+    std::thread t1 { [&]()
+    {
+        for (int i = 0; i < 100; ++i)
+        {
+            connections.emplace_back(empty_emitter.generic_signal.connect(slot_function<>));
+        }
+    } };
+    t1.join();
+
+    // The memory of the connections goes back to the pool of a thread that is gone.
+    empty_emitter.generic_emit();
+    for (auto& conn: connections)
+    {
+        conn.disconnect();
+    }
+    empty_emitter.generic_emit();
+
+    EXPECT_EQ(count, 100);
+    EXPECT_EQ(empty_emitter.generic_signal.slot_count(), 0);
+}
+
 TEST_F(test_threads, guard_destruction_during_emit)
 {
     for (int i = 0; i < 1000; ++i)
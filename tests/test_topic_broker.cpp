@@ -0,0 +1,281 @@
+#include "stimulus.h"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+
+#include <gtest/gtest.h>
+#include <vector>
+
+#include "utilities.h"
+
+class test_topic_broker: public ::testing::Test
+{
+protected:
+    topic_broker<int> broker;
+    safe_topic_broker<int> safe_broker;
+
+    std::vector<std::string> calls;
+
+    auto recording_slot(std::string name)
+    {
+        return [this, name = std::move(name)](int) { calls.emplace_back(name); };
+    }
+
+    struct counting_receiver: public safe_receiver
+    {
+        void slot(int)
+        {
+            ++count;
+        }
+
+        int count { 0 };
+    };
+};
+
+TEST_F(test_topic_broker, exact_topic)
+{
+    int& count = call_count<int>;
+    reset<int>();
+
+    broker.subscribe("md.eq.US.AAPL.trade", slot_function<int>);
+
+    broker.publish("md.eq.US.AAPL.trade", 5);
+    broker.publish("md.eq.US.AAPL.quote", 6);
+    broker.publish("md.eq.US.AAPL", 7);
+    broker.publish("md.eq.US.AAPL.trade.late", 8);
+
+    EXPECT_EQ(count, 1);
+    EXPECT_EQ(call_args<int>.back(), 5);
+}
+
+TEST_F(test_topic_broker, single_level_wildcard)
+{
+    broker.subscribe("md.eq.*.AAPL.trade", recording_slot("any market"));
+    broker.subscribe("md.eq.US.*.*", recording_slot("any US event"));
+
+    broker.publish("md.eq.US.AAPL.trade", 5);
+    broker.publish("md.eq.EU.AAPL.trade", 6);
+    broker.publish("md.eq.US.MSFT.quote", 7);
+    broker.publish("md.eq.US.AAPL", 8);
+
+    // Subscriptions to different patterns are called in no particular order.
+    std::ranges::sort(calls);
+    EXPECT_EQ(calls,
+              (std::vector<std::string> { "any US event", "any US event", "any market",
+                                          "any market" }));
+}
+
+TEST_F(test_topic_broker, multi_level_wildcard)
+{
+    broker.subscribe("md.eq.#", recording_slot("equities"));
+    broker.subscribe("#", recording_slot("everything"));
+
+    broker.publish("md.eq", 5);
+    broker.publish("md.eq.US.AAPL.trade", 6);
+    broker.publish("md.fx.EURUSD", 7);
+
+    std::ranges::sort(calls);
+    EXPECT_EQ(calls,
+              (std::vector<std::string> { "equities", "equities", "everything", "everything",
+                                          "everything" }));
+}
+
+TEST_F(test_topic_broker, misplaced_multi_level_wildcard)
+{
+    EXPECT_THROW(broker.subscribe("md.#.trade", [](int) {}), std::invalid_argument);
+    EXPECT_NO_THROW(broker.subscribe("md.#", [](int) {}));
+}
+
+TEST_F(test_topic_broker, each_subscription_called_once)
+{
+    int& count = call_count<int>;
+    reset<int>();
+
+    broker.subscribe("md.*.US", slot_function<int>);
+    broker.subscribe("md.eq.*", slot_function<int>);
+    broker.subscribe("md.eq.US", slot_function<int>);
+    broker.subscribe("md.eq.US", slot_function<int>);
+
+    broker.publish("md.eq.US", 5);
+
+    EXPECT_EQ(count, 4);
+}
+
+TEST_F(test_topic_broker, subscribe_after_publish)
+{
+    int& count = call_count<int>;
+    reset<int>();
+
+    broker.subscribe("md.eq.US", slot_function<int>);
+    broker.publish("md.eq.US", 5);
+
+    // The matching subscriptions of the topic were cached by the first publication.
+    broker.subscribe("md.*.US", slot_function<int>);
+    broker.publish("md.eq.US", 6);
+
+    EXPECT_EQ(count, 3);
+}
+
+TEST_F(test_topic_broker, unsubscribe)
+{
+    int& count = call_count<int>;
+    reset<int>();
+
+    auto connection { broker.subscribe("md.eq.US", slot_function<int>) };
+    broker.publish("md.eq.US", 5);
+
+    connection.disconnect();
+    broker.publish("md.eq.US", 6);
+
+    // Subscribing again to the same pattern.
+    broker.subscribe("md.eq.US", slot_function<int>);
+    broker.publish("md.eq.US", 7);
+
+    EXPECT_EQ(count, 2);
+    EXPECT_EQ(call_args<int>.back(), 7);
+}
+
+TEST_F(test_topic_broker, suspended_subscription)
+{
+    int& count = call_count<int>;
+    reset<int>();
+
+    auto connection { broker.subscribe("md.#", slot_function<int>) };
+    connection.suspend();
+    broker.publish("md.eq.US", 5);
+    connection.resume();
+    broker.publish("md.eq.US", 6);
+
+    EXPECT_EQ(count, 1);
+    EXPECT_EQ(call_args<int>.back(), 6);
+}
+
+TEST_F(test_topic_broker, small_cache)
+{
+    topic_broker<int> small_broker { 1 };
+    int& count = call_count<int>;
+    reset<int>();
+
+    small_broker.subscribe("md.*", slot_function<int>);
+    for (int i { 0 }; i < 10; ++i)
+    {
+        small_broker.publish("md." + std::to_string(i % 3), i);
+    }
+
+    EXPECT_EQ(count, 10);
+}
+
+TEST_F(test_topic_broker, guarded_subscription)
+{
+    auto receiver { std::make_unique<counting_receiver>() };
+
+    safe_broker.subscribe("md.eq.*", &counting_receiver::slot, *receiver);
+    safe_broker.publish("md.eq.US", 5);
+    EXPECT_EQ(receiver->count, 1);
+
+    receiver.reset();
+    safe_broker.publish("md.eq.US", 6);
+}
+
+TEST_F(test_topic_broker, concurrent_publications)
+{
+    int count { 0 };
+    std::mutex count_mutex;
+
+    safe_broker.subscribe("md.*.US",
+                          [&count, &count_mutex](int)
+                          {
+                              std::lock_guard lock { count_mutex };
+                              ++count;
+                          });
+
+    std::vector<std::thread> threads;
+    for (int i { 0 }; i < 4; ++i)
+    {
+        threads.emplace_back(
+            [this, i]
+            {
+                for (int j { 0 }; j < 100; ++j)
+                {
+                    safe_broker.publish("md.eq.US", j);
+                    safe_broker.subscribe("other." + std::to_string(i) + "." + std::to_string(j),
+                                          [](int) {});
+                }
+            });
+    }
+
+    for (auto& thread: threads)
+    {
+        thread.join();
+    }
+
+    EXPECT_EQ(count, 400);
+}
+
+TEST_F(test_topic_broker, unsubscribe_from_a_slot)
+{
+    int count { 0 };
+    std::optional<connection<details::unsafe_shared_pointer>> subscription;
+    subscription.emplace(broker.subscribe("md.eq.US",
+                                          [&count, &subscription](int)
+                                          {
+                                              ++count;
+                                              subscription->disconnect();
+                                          }));
+
+    broker.publish("md.eq.US", 5);
+    broker.publish("md.eq.US", 6);
+
+    EXPECT_EQ(count, 1);
+}
+
+TEST_F(test_topic_broker, broker_destroyed_first)
+{
+    auto temporary_broker { std::make_unique<topic_broker<int>>() };
+    auto connection { temporary_broker->subscribe("md.eq.US", [](int) {}) };
+
+    temporary_broker.reset();
+    connection.disconnect();
+}
+
+TEST_F(test_topic_broker, concurrent_unsubscriptions)
+{
+    std::atomic<int> count { 0 };
+    safe_broker.subscribe("md.eq.US", [&count](int) { ++count; });
+
+    std::vector<std::thread> threads;
+    for (int i { 0 }; i < 2; ++i)
+    {
+        threads.emplace_back(
+            [this]
+            {
+                for (int j { 0 }; j < 1000; ++j)
+                {
+                    safe_broker.publish("md.eq.US", j);
+                }
+            });
+    }
+    threads.emplace_back(
+        [this]
+        {
+            for (int j { 0 }; j < 1000; ++j)
+            {
+                safe_broker.subscribe("md.*.US", [](int) {}).disconnect();
+                safe_broker.subscribe("md.eq." + std::to_string(j % 8), [](int) {}).disconnect();
+            }
+        });
+
+    for (auto& thread: threads)
+    {
+        thread.join();
+    }
+
+    EXPECT_EQ(count, 2000);
+}
@@ -67,8 +67,8 @@ TEST_F(test_transform, copy_move_no_effect)
     EXPECT_EQ(count, 1);
     EXPECT_EQ(call_args<copy_move_counter>.size(), 1);
     EXPECT_EQ(call_args<copy_move_counter>.back().copy_counter, 0);
-    // 1 from generic_emit, 1 to pass it std::function, and 1 in the function itself.
-    EXPECT_EQ(call_args<copy_move_counter>.back().move_counter, 3);
+    // 1 to pass it to the function, and 1 to store it.
+    EXPECT_EQ(call_args<copy_move_counter>.back().move_counter, 2);
 }
 
 TEST_F(test_transform, 2_copy_move_no_effect)
@@ -84,12 +84,12 @@ TEST_F(test_transform, 2_copy_move_no_effect)
     EXPECT_EQ(count, 2);
     EXPECT_EQ(call_args<copy_move_counter>.size(), 2);
     EXPECT_EQ(call_args<copy_move_counter>.back().copy_counter, 0);
-    // 1 from generic_emit, 1 to pass it std::function, and 1 in the function itself.
-    EXPECT_EQ(call_args<copy_move_counter>.back().move_counter, 3);
-    // 1 to pass it to std::function
+    // 1 to pass it to the function, and 1 to store it.
+    EXPECT_EQ(call_args<copy_move_counter>.back().move_counter, 2);
+    // 1 to pass it to the function, as other slots share the emitted argument.
     EXPECT_EQ(call_args<copy_move_counter>.front().copy_counter, 1);
-    // 1 from generic_emit, 1 to pass it std::function, and 1 in the function itself.
-    EXPECT_EQ(call_args<copy_move_counter>.front().move_counter, 2);
+    // 1 to store it.
+    EXPECT_EQ(call_args<copy_move_counter>.front().move_counter, 1);
 }
 
 namespace
@@ -1,6 +1,9 @@
 #ifndef UTILITIES_H_
 #define UTILITIES_H_
 
+#include <chrono>
+#include <cstddef>
+#include <functional>
 #include <list>
 
 #include "stimulus.h"
@@ -49,6 +52,18 @@ public:
     }
 };
 
+template<details::not_void... Args>
+class forwarding_emitter: public basic_emitter
+{
+public:
+    signal<Args...> forwarded_signal;
+
+    void forward_from(const generic_emitter<Args...>& origin)
+    {
+        connect(origin.generic_signal, &forwarding_emitter::forwarded_signal);
+    }
+};
+
 template<class... Args>
 int call_count { 0 };
 
@@ -117,4 +132,102 @@ auto slot_non_const_functor()
     return non_const_functor {};
 }
 
+// Queues tasks in place, using their intrusive link.
+struct task_queue_policy
+{
+    task_queue_policy() = default;
+    task_queue_policy(const task_queue_policy&) = delete;
+    task_queue_policy(task_queue_policy&&) = delete;
+
+    auto operator=(const task_queue_policy&) -> task_queue_policy& = delete;
+    auto operator=(task_queue_policy&&) -> task_queue_policy& = delete;
+
+    ~task_queue_policy()
+    {
+        while (!empty())
+        {
+            pop().discard();
+        }
+    }
+
+    void execute(std::function<void()> callable)
+    {
+        ++function_count;
+        callable();
+    }
+
+    void execute(task& pending_task)
+    {
+        pending_task.next = nullptr;
+        if (m_last == nullptr)
+        {
+            m_first = &pending_task;
+        }
+        else
+        {
+            m_last->next = &pending_task;
+        }
+        m_last = &pending_task;
+        ++m_size;
+    }
+
+    auto pop() -> task&
+    {
+        auto& first { *m_first };
+        m_first = first.next;
+        if (m_first == nullptr)
+        {
+            m_last = nullptr;
+        }
+        --m_size;
+        return first;
+    }
+
+    void run_all()
+    {
+        while (!empty())
+        {
+            pop().run();
+        }
+    }
+
+    auto empty() const -> bool
+    {
+        return m_first == nullptr;
+    }
+
+    auto size() const -> std::size_t
+    {
+        return m_size;
+    }
+
+    static constexpr bool is_synchronous { false };
+    static constexpr bool accepts_tasks { true };
+
+    int function_count { 0 };
+
+private:
+    task* m_first { nullptr };
+    task* m_last { nullptr };
+    std::size_t m_size { 0 };
+};
+
+// Only moves forward when told to.
+struct manual_clock
+{
+    using duration = std::chrono::milliseconds;
+    using rep = duration::rep;
+    using period = duration::period;
+    using time_point = std::chrono::time_point<manual_clock, duration>;
+
+    static constexpr bool is_steady { true };
+
+    auto now() const -> time_point
+    {
+        return *current;
+    }
+
+    const time_point* current { nullptr };
+};
+
 #endif
\ No newline at end of file